@@ -1,83 +1,37 @@
-# Qt 6.9.2 项目配置文件
-QT       += core gui widgets sql network concurrent printsupport
-
-# Qt 6 兼容模块
-greaterThan(QT_MAJOR_VERSION, 5): QT += core5compat
-
-# 禁用Qt 6前的废弃API
-DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000 
-
-# 目标名称与编译模式
-TARGET = ClassBoardSystem
-TEMPLATE = app
-
-# 源文件
-SOURCES += \
-    src/main.cpp \
-    src/data/DatabaseManager.cpp \
-    src/network/NetworkWorker.cpp \
-    src/ui/MainWindow.cpp \
-    src/ui/NoticeManager.cpp \
-    src/ui/SettingsDialog.cpp \
-    src/settings/SettingsManager.cpp \
-    src/utility/TimeHelper.cpp \
-    src/utility/ExportHelper.cpp
-
-# 头文件
-HEADERS += \
-    src/data/DatabaseManager.h \
-    src/network/NetworkWorker.h \
-    src/ui/MainWindow.h \
-    src/ui/NoticeManager.h \
-    src/ui/SettingsDialog.h \
-    src/settings/SettingsManager.h \
-    src/utility/LogHelper.h \
-    src/utility/TimeHelper.h \
-    src/utility/ExportHelper.h \
-    src/utility/src/utility/LogHelper.h
-
-# UI文件
-FORMS += \
-    src/ui/MainWindow.ui \
-    src/ui/NoticeManager.ui \
-    src/ui/SettingsDialog.ui
-
-# 资源文件
-RESOURCES += \
-    src/resource/resource.qrc
-    src/resource/style.qss
-    src/resource/create_tables.sql
-    src/resource/test_data.sql
-
-# 包含路径
-INCLUDEPATH += src
-
-# Release模式优化
-CONFIG(release, debug|release): {
-    DEFINES += QT_NO_DEBUG_OUTPUT
-    QMAKE_CXXFLAGS += -O2 -Wall
-    QMAKE_LFLAGS += -Wl,-s
-    # 输出目录
-    DESTDIR = ./release
-    OBJECTS_DIR = ./release/obj
-    MOC_DIR = ./release/moc
-    RCC_DIR = ./release/rcc
-    UI_DIR = ./release/ui
-}
-
-# Debug模式配置
-CONFIG(debug, debug|release): {
-    DESTDIR = ./debug
-    OBJECTS_DIR = ./debug/obj
-    MOC_DIR = ./debug/moc
-    RCC_DIR = ./debug/rcc
-    UI_DIR = ./debug/ui
-}
-
-# Windows平台适配（Excel导出）
-win32: {
-    QT += axcontainer
-    copy_sql.files = sql/create_tables.sql sql/test_data.sql
-    copy_sql.path = $$DESTDIR/sql
-    INSTALLS += copy_sql
-}
+# Qt 6.9.2 项目配置文件（按角色拆分为多个目标）
+#   core              classboard_core 静态库（数据/同步/时间/设置，无Widgets依赖）
+#   app               ClassBoardSystem 图形界面程序
+#   syncd             classboard-syncd 无界面同步守护进程
+#   bench_database    DatabaseManager 基准测试
+#   schedule_rules    课表规则行为测试（校历、上课周、冲突检测）
+#   mock_sync_server  本地模拟同步服务器
+#   sync_load_harness 端到端同步压测工具
+TEMPLATE = subdirs
+
+SUBDIRS = \
+    core \
+    app \
+    syncd \
+    bench_database \
+    schedule_rules \
+    mock_sync_server \
+    sync_load_harness
+
+core.file = src/core/classboard_core.pro
+
+app.file = src/app/app.pro
+app.depends = core
+
+syncd.file = src/syncd/syncd.pro
+syncd.depends = core
+
+bench_database.file = tests/bench_database/bench_database.pro
+bench_database.depends = core
+
+schedule_rules.file = tests/schedule_rules/schedule_rules.pro
+schedule_rules.depends = core
+
+mock_sync_server.file = tools/mock_sync_server/mock_sync_server.pro
+
+sync_load_harness.file = tools/sync_load_harness/sync_load_harness.pro
+sync_load_harness.depends = core
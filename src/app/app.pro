@@ -0,0 +1,74 @@
+# 教室班牌图形界面程序（链接 classboard_core）
+QT       += core gui widgets sql network concurrent printsupport
+
+# Qt 6 兼容模块
+greaterThan(QT_MAJOR_VERSION, 5): QT += core5compat
+
+# 禁用Qt 6前的废弃API
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000 
+
+# 目标名称与编译模式
+TARGET = ClassBoardSystem
+TEMPLATE = app
+
+include(../core/classboard_core.pri)
+
+SRC_ROOT = $$PWD/..
+
+# 源文件
+SOURCES += \
+    $$SRC_ROOT/main.cpp \
+    $$SRC_ROOT/ui/FreeClassroomDialog.cpp \
+    $$SRC_ROOT/ui/MainWindow.cpp \
+    $$SRC_ROOT/ui/NoticeListModel.cpp \
+    $$SRC_ROOT/ui/NoticeManager.cpp \
+    $$SRC_ROOT/ui/SettingsDialog.cpp \
+    $$SRC_ROOT/ui/UrgentOverlay.cpp \
+    $$SRC_ROOT/utility/ExportHelper.cpp
+
+# 头文件
+HEADERS += \
+    $$SRC_ROOT/ui/FreeClassroomDialog.h \
+    $$SRC_ROOT/ui/MainWindow.h \
+    $$SRC_ROOT/ui/NoticeListModel.h \
+    $$SRC_ROOT/ui/NoticeManager.h \
+    $$SRC_ROOT/ui/SettingsDialog.h \
+    $$SRC_ROOT/ui/UrgentOverlay.h \
+    $$SRC_ROOT/utility/ExportHelper.h
+
+# UI文件
+FORMS += \
+    $$SRC_ROOT/ui/FreeClassroomDialog.ui \
+    $$SRC_ROOT/ui/MainWindow.ui \
+    $$SRC_ROOT/ui/NoticeManager.ui \
+    $$SRC_ROOT/ui/SettingsDialog.ui
+
+# Release模式优化
+CONFIG(release, debug|release): {
+    DEFINES += QT_NO_DEBUG_OUTPUT
+    QMAKE_CXXFLAGS += -O2 -Wall
+    QMAKE_LFLAGS += -Wl,-s
+    # 输出目录
+    DESTDIR = ./release
+    OBJECTS_DIR = ./release/obj
+    MOC_DIR = ./release/moc
+    RCC_DIR = ./release/rcc
+    UI_DIR = ./release/ui
+}
+
+# Debug模式配置
+CONFIG(debug, debug|release): {
+    DESTDIR = ./debug
+    OBJECTS_DIR = ./debug/obj
+    MOC_DIR = ./debug/moc
+    RCC_DIR = ./debug/rcc
+    UI_DIR = ./debug/ui
+}
+
+# Windows平台适配（Excel导出）
+win32: {
+    QT += axcontainer
+    copy_sql.files = $$SRC_ROOT/resource/create_tables.sql $$SRC_ROOT/resource/test_data.sql
+    copy_sql.path = $$DESTDIR/sql
+    INSTALLS += copy_sql
+}
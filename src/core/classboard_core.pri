@@ -0,0 +1,26 @@
+# 链接 classboard_core 静态库（在使用方 .pro 中 include 本文件）
+QT += core sql network concurrent
+
+CORE_SRC_ROOT = $$PWD/..
+CORE_LIB_DIR = $$shadowed($$PWD)
+
+INCLUDEPATH += $$CORE_SRC_ROOT
+DEPENDPATH += $$CORE_SRC_ROOT
+
+# 追踪片段开关需与库保持一致：Debug构建默认启用，Release构建需 CONFIG+=trace
+CONFIG(debug, debug|release)|trace: DEFINES += CLASSBOARD_TRACE
+
+LIBS += -L$$CORE_LIB_DIR -lclassboard_core
+
+# 在线分步备份需链接系统SQLite（与库的 CONFIG+=sqlite_backup 保持一致）
+sqlite_backup: LIBS += -lsqlite3
+
+# 进程内存指标（GetProcessMemoryInfo）
+win32: LIBS += -lpsapi
+
+win32-msvc*: PRE_TARGETDEPS += $$CORE_LIB_DIR/classboard_core.lib
+else: PRE_TARGETDEPS += $$CORE_LIB_DIR/libclassboard_core.a
+
+# 建表脚本等资源随可执行文件链接（静态库中的资源需手动初始化，放在使用方更稳妥）
+RESOURCES += \
+    $$CORE_SRC_ROOT/resource/resource.qrc
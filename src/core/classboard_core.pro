@@ -0,0 +1,86 @@
+# classboard_core：数据、同步、时间与设置模块静态库（不依赖Widgets）
+# 供图形界面、同步守护进程、基准测试与工具程序链接
+QT       = core sql network concurrent
+
+TARGET = classboard_core
+TEMPLATE = lib
+CONFIG += staticlib
+
+# 禁用Qt 6前的废弃API
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000
+
+# 库文件固定输出到构建目录，便于 classboard_core.pri 定位
+DESTDIR = $$OUT_PWD
+
+SRC_ROOT = $$PWD/..
+
+# 源文件
+SOURCES += \
+    $$SRC_ROOT/data/AsyncDatabase.cpp \
+    $$SRC_ROOT/data/ConflictAnalyzer.cpp \
+    $$SRC_ROOT/data/DatabaseBackup.cpp \
+    $$SRC_ROOT/data/DatabaseManager.cpp \
+    $$SRC_ROOT/data/NoticeRotation.cpp \
+    $$SRC_ROOT/data/NoticeScheduler.cpp \
+    $$SRC_ROOT/data/RetentionJob.cpp \
+    $$SRC_ROOT/data/RoomIntervalIndex.cpp \
+    $$SRC_ROOT/data/SqlitePragmas.cpp \
+    $$SRC_ROOT/data/StringDictionary.cpp \
+    $$SRC_ROOT/metrics/EventLoopLagProbe.cpp \
+    $$SRC_ROOT/metrics/MetricsRegistry.cpp \
+    $$SRC_ROOT/metrics/MetricsServer.cpp \
+    $$SRC_ROOT/metrics/StallWatchdog.cpp \
+    $$SRC_ROOT/metrics/Tracer.cpp \
+    $$SRC_ROOT/network/NetworkWorker.cpp \
+    $$SRC_ROOT/network/SyncChangeListener.cpp \
+    $$SRC_ROOT/network/SyncNotifier.cpp \
+    $$SRC_ROOT/settings/SettingsManager.cpp \
+    $$SRC_ROOT/utility/Clock.cpp \
+    $$SRC_ROOT/utility/FileHelper.cpp \
+    $$SRC_ROOT/utility/ScheduleSimulator.cpp \
+    $$SRC_ROOT/utility/TimeHelper.cpp \
+    $$SRC_ROOT/utility/WeekMask.cpp
+
+# 头文件
+HEADERS += \
+    $$SRC_ROOT/data/AsyncDatabase.h \
+    $$SRC_ROOT/data/ConflictAnalyzer.h \
+    $$SRC_ROOT/data/DatabaseBackup.h \
+    $$SRC_ROOT/data/DatabaseManager.h \
+    $$SRC_ROOT/data/NoticeRotation.h \
+    $$SRC_ROOT/data/NoticeScheduler.h \
+    $$SRC_ROOT/data/RetentionJob.h \
+    $$SRC_ROOT/data/RoomIntervalIndex.h \
+    $$SRC_ROOT/data/SqlitePragmas.h \
+    $$SRC_ROOT/data/StringDictionary.h \
+    $$SRC_ROOT/metrics/EventLoopLagProbe.h \
+    $$SRC_ROOT/metrics/MetricsRegistry.h \
+    $$SRC_ROOT/metrics/MetricsServer.h \
+    $$SRC_ROOT/metrics/StallWatchdog.h \
+    $$SRC_ROOT/metrics/Tracer.h \
+    $$SRC_ROOT/network/NetworkWorker.h \
+    $$SRC_ROOT/network/SyncChangeListener.h \
+    $$SRC_ROOT/network/SyncNotifier.h \
+    $$SRC_ROOT/settings/SettingsManager.h \
+    $$SRC_ROOT/utility/Clock.h \
+    $$SRC_ROOT/utility/FileHelper.h \
+    $$SRC_ROOT/utility/LogHelper.h \
+    $$SRC_ROOT/utility/ScheduleSimulator.h \
+    $$SRC_ROOT/utility/TimeHelper.h \
+    $$SRC_ROOT/utility/WeekMask.h
+
+# 追踪片段：Debug构建默认启用，Release构建需 CONFIG+=trace
+CONFIG(debug, debug|release)|trace: DEFINES += CLASSBOARD_TRACE
+
+# 在线分步备份（sqlite3_backup）：需Qt以 -system-sqlite 构建并链接同一系统SQLite，CONFIG+=sqlite_backup
+# 未启用时备份使用 VACUUM INTO
+sqlite_backup: DEFINES += CLASSBOARD_SQLITE_BACKUP
+
+# 包含路径
+INCLUDEPATH += $$SRC_ROOT
+
+# Release模式优化
+CONFIG(release, debug|release): {
+    DEFINES += QT_NO_DEBUG_OUTPUT
+    QMAKE_CXXFLAGS += -O2 -Wall
+}
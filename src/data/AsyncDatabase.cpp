@@ -0,0 +1,158 @@
+#include "AsyncDatabase.h"
+#include "DatabaseManager.h"
+#include "StringDictionary.h"
+#include "SqlitePragmas.h"
+#include "metrics/MetricsRegistry.h"
+#include "metrics/Tracer.h"
+#include "utility/Clock.h"
+#include "utility/LogHelper.h"
+#include <QtConcurrent/QtConcurrentRun>
+#include <QThreadStorage>
+#include <QThread>
+#include <QSqlDatabase>
+#include <QSqlError>
+
+// 池线程数：界面同时在途的查询很少（课表、班级列表、通知），WAL 模式下两个连接可并行读，
+// 一次慢查询不会挡住后续请求；多开线程只会多占连接与页缓存
+static const int kAsyncThreadCount = 2;
+
+// 池线程的只读连接与字典缓存（线程退出时随 QThreadStorage 释放）
+struct AsyncDatabase::WorkerConnection
+{
+    WorkerConnection(const QString& path, int gen);
+    ~WorkerConnection();
+
+    QString name;
+    QString dbPath;
+    int generation;
+    QSqlDatabase db;
+    StringDictionary courseNames{"course_name_info", "course_name"};
+    StringDictionary teachers{"teacher_info", "teacher_name"};
+    StringDictionary courseTypes{"course_type_info", "type_name"};
+};
+
+AsyncDatabase::WorkerConnection::WorkerConnection(const QString& path, int gen)
+    : name(QString("classboard_async_%1").arg(reinterpret_cast<quintptr>(QThread::currentThreadId())))
+    , dbPath(path)
+    , generation(gen)
+{
+    db = QSqlDatabase::addDatabase("QSQLITE", name);
+    db.setDatabaseName(dbPath);
+    db.setConnectOptions("QSQLITE_OPEN_READONLY");
+    if (db.open()) {
+        SqlitePragmaProfile::current().apply(db, true);
+    } else {
+        writeLog("ERROR", "异步查询打开数据库失败：" + db.lastError().text(), "DATABASE");
+    }
+}
+
+AsyncDatabase::WorkerConnection::~WorkerConnection()
+{
+    db.close();
+    db = QSqlDatabase();
+    QSqlDatabase::removeDatabase(name);
+}
+
+AsyncDatabase& AsyncDatabase::instance()
+{
+    static AsyncDatabase instance;
+    return instance;
+}
+
+AsyncDatabase::AsyncDatabase(QObject* parent) : QObject(parent)
+{
+    m_pool.setObjectName("db-async");
+    m_pool.setMaxThreadCount(kAsyncThreadCount);
+
+    // 数据库文件即将被替换：先递增代数，再等在途查询结束并回收池线程（线程退出时其连接随之关闭），
+    // 替换期间不留打开旧文件的连接；之后的查询在新线程中按新代数重新打开
+    connect(&DatabaseManager::instance(), &DatabaseManager::aboutToReplaceDatabase, this, [this]() {
+        m_generation.ref();
+        m_pool.clear();
+        m_pool.waitForDone();
+    }, Qt::DirectConnection);
+}
+
+AsyncDatabase::~AsyncDatabase()
+{
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+AsyncDatabase::WorkerConnection* AsyncDatabase::localConnection(const QString& dbPath, int generation)
+{
+    static QThreadStorage<WorkerConnection*> connections;
+    WorkerConnection* connection = connections.localData();
+    if (connection && connection->dbPath == dbPath && connection->generation == generation) {
+        return connection;
+    }
+
+    // 先释放旧连接（同名连接不能并存），再按当前路径重新打开
+    connections.setLocalData(nullptr);
+    connection = new WorkerConnection(dbPath, generation);
+    connections.setLocalData(connection);
+    return connection;
+}
+
+template <typename Func>
+QFuture<QList<QVariantMap>> AsyncDatabase::run(Func func)
+{
+    // 路径与代数在调用线程取出，池线程不访问 DatabaseManager 的成员
+    const QString dbPath = DatabaseManager::instance().getDb().databaseName();
+    const int generation = m_generation.loadAcquire();
+    return QtConcurrent::run(&m_pool, [dbPath, generation, func]() {
+        WorkerConnection* connection = localConnection(dbPath, generation);
+        QString errMsg;
+        QList<QVariantMap> rows = func(*connection, &errMsg);
+        if (!errMsg.isEmpty()) {
+            writeLog("ERROR", errMsg, "DATABASE");
+        }
+        return rows;
+    });
+}
+
+QFuture<QList<QVariantMap>> AsyncDatabase::getAllClasses()
+{
+    return run([](WorkerConnection& connection, QString* error) {
+        CB_DB_METHOD("async.getAllClasses");
+        return DatabaseManager::selectAllClasses(connection.db, error);
+    });
+}
+
+QFuture<QList<QVariantMap>> AsyncDatabase::getCoursesByClassId(int classId)
+{
+    // 日期按提交时刻取（模拟时钟跳变后提交的请求使用新日期）
+    const QString today = Clock::currentDate().toString("yyyy-MM-dd");
+    return run([classId, today](WorkerConnection& connection, QString* error) {
+        CB_DB_METHOD("async.getCoursesByClassId");
+        return DatabaseManager::selectCoursesByClassId(connection.db, classId, today, connection.courseNames,
+                                                       connection.teachers, connection.courseTypes, error);
+    });
+}
+
+QFuture<QList<QVariantMap>> AsyncDatabase::getValidNotices(bool isScrolling)
+{
+    const QDateTime now = Clock::currentDateTime();
+    return run([isScrolling, now](WorkerConnection& connection, QString* error) {
+        CB_DB_METHOD("async.getValidNotices");
+        return DatabaseManager::selectValidNotices(connection.db, isScrolling, now, error);
+    });
+}
+
+QFuture<QList<QVariantMap>> AsyncDatabase::getAllTeachers()
+{
+    return run([](WorkerConnection& connection, QString* error) {
+        CB_DB_METHOD("async.getAllTeachers");
+        return DatabaseManager::selectAllTeachers(connection.db, error);
+    });
+}
+
+QFuture<QList<QVariantMap>> AsyncDatabase::getCoursesByTeacher(int teacherId)
+{
+    const QString today = Clock::currentDate().toString("yyyy-MM-dd");
+    return run([teacherId, today](WorkerConnection& connection, QString* error) {
+        CB_DB_METHOD("async.getCoursesByTeacher");
+        return DatabaseManager::selectCoursesByTeacher(connection.db, teacherId, today, connection.courseNames,
+                                                       connection.teachers, connection.courseTypes, error);
+    });
+}
@@ -0,0 +1,44 @@
+#ifndef ASYNCDATABASE_H
+#define ASYNCDATABASE_H
+
+#include <QObject>
+#include <QFuture>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QList>
+#include <QVariantMap>
+
+// 异步查询（单例）：在专用线程池中执行界面用到的只读查询，返回 QFuture
+// 每个池线程持有自己的只读连接与字典缓存（SQLite 连接不能跨线程共用），界面线程不再等待磁盘I/O。
+// 调用方用 future.then(this, ...) 把结果送回界面线程；请求被更新的请求取代时调用 cancel()，
+// 尚未开始执行的查询直接跳过，已完成的结果不再送达（then 的后续随之取消）
+class AsyncDatabase : public QObject
+{
+    Q_OBJECT
+public:
+    static AsyncDatabase& instance();
+    ~AsyncDatabase();
+
+    // 与 DatabaseManager 同名方法返回相同字段
+    QFuture<QList<QVariantMap>> getAllClasses();
+    QFuture<QList<QVariantMap>> getCoursesByClassId(int classId);
+    QFuture<QList<QVariantMap>> getValidNotices(bool isScrolling = false);
+    QFuture<QList<QVariantMap>> getAllTeachers();
+    QFuture<QList<QVariantMap>> getCoursesByTeacher(int teacherId);
+
+private:
+    AsyncDatabase(QObject* parent = nullptr);
+    AsyncDatabase(const AsyncDatabase&) = delete;
+    AsyncDatabase& operator=(const AsyncDatabase&) = delete;
+
+    struct WorkerConnection;
+    // 在池线程中以该线程的连接执行 func(connection, &error)（连接按需打开，数据库被替换后重新打开），失败时记日志
+    template <typename Func>
+    QFuture<QList<QVariantMap>> run(Func func);
+    static WorkerConnection* localConnection(const QString& dbPath, int generation);
+
+    QThreadPool m_pool;
+    QAtomicInt m_generation;    // 数据库文件被替换前递增，池线程据此重新打开连接
+};
+
+#endif // ASYNCDATABASE_H
@@ -0,0 +1,211 @@
+#include "ConflictAnalyzer.h"
+#include "DatabaseManager.h"
+#include "metrics/MetricsRegistry.h"
+#include "metrics/Tracer.h"
+#include "utility/TimeHelper.h"
+#include "utility/WeekMask.h"
+#include <QtConcurrent/QtConcurrentRun>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QElapsedTimer>
+#include <QThread>
+#include <algorithm>
+
+// 日志中最多列出的冲突条数（完整数量见汇总与指标）
+static const int kMaxLoggedConflicts = 20;
+
+ConflictAnalyzer& ConflictAnalyzer::instance()
+{
+    static ConflictAnalyzer instance;
+    return instance;
+}
+
+ConflictAnalyzer::ConflictAnalyzer(QObject* parent)
+    : QObject(parent)
+    , m_watcher(new QFutureWatcher<Report>(this))
+{
+    connect(m_watcher, &QFutureWatcher<Report>::finished, this, &ConflictAnalyzer::onAnalysisFinished);
+}
+
+void ConflictAnalyzer::analyzeAsync()
+{
+    if (m_watcher->isRunning()) {
+        m_pending = true;
+        return;
+    }
+
+    // 工作线程不能使用主连接，按相同路径另开只读连接
+    const QString dbPath = DatabaseManager::instance().getDb().databaseName();
+    const SqlitePragmaProfile profile = SqlitePragmaProfile::current();
+    m_watcher->setFuture(QtConcurrent::run([dbPath, profile]() {
+        const QString connName = QString("classboard_conflict_%1").arg(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+        Report report;
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+            db.setDatabaseName(dbPath);
+            db.setConnectOptions("QSQLITE_OPEN_READONLY");
+            if (db.open()) {
+                profile.apply(db, true);
+                report = analyze(db);
+                db.close();
+            } else {
+                writeLog("ERROR", "冲突检测打开数据库失败：" + db.lastError().text(), "CONFLICT");
+            }
+        }
+        QSqlDatabase::removeDatabase(connName);
+        return report;
+    }));
+}
+
+ConflictAnalyzer::Report ConflictAnalyzer::analyze(QSqlDatabase db)
+{
+    CB_TRACE_SPAN("conflict.analyze");
+    QElapsedTimer timer;
+    timer.start();
+    Report report;
+
+    QHash<int, QString> classroomNames;
+    QHash<int, QString> teacherNames;
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (query.exec("SELECT id, classroom_name FROM classroom_info")) {
+        while (query.next()) {
+            classroomNames.insert(query.value(0).toInt(), query.value(1).toString());
+        }
+    }
+    if (query.exec("SELECT id, teacher_name FROM teacher_info")) {
+        while (query.next()) {
+            teacherNames.insert(query.value(0).toInt(), query.value(1).toString());
+        }
+    }
+
+    if (!query.exec(R"(
+        SELECT id, teacher_id, classroom_id, day_of_week, start_time, end_time, start_date, end_date, week_mask
+        FROM course_schedule
+    )")) {
+        writeLog("ERROR", "冲突检测读取课表失败：" + query.lastError().text(), "CONFLICT");
+        return report;
+    }
+
+    QVector<Slot> teacherSlots;
+    QVector<Slot> classroomSlots;
+
+    while (query.next()) {
+        report.courseRows++;
+        Slot slot;
+        slot.courseId = query.value(0).toInt();
+        slot.dayOfWeek = query.value(3).toInt();
+        slot.startSecs = DayTime::parse(query.value(4).toString()).secs;
+        slot.endSecs = DayTime::parse(query.value(5).toString()).secs;
+        slot.startDay = TimeHelper::julianDayFromIso(query.value(6).toString());
+        slot.endDay = TimeHelper::julianDayFromIso(query.value(7).toString());
+        slot.weekMask = query.value(8).toLongLong();
+        if (slot.startSecs < 0 || slot.endSecs <= slot.startSecs || slot.startDay < 0 || slot.endDay < slot.startDay) {
+            continue; // 数据不完整的课程不参与检测
+        }
+        slot.firstMonday = TimeHelper::mondayOfJulianDay(slot.startDay);
+
+        const int teacherId = query.value(1).toInt();
+        if (teacherId > 0) {
+            slot.resource = teacherId;
+            teacherSlots.append(slot);
+        }
+
+        const int classroomId = query.value(2).toInt();
+        if (classroomId > 0) {
+            slot.resource = classroomId;
+            classroomSlots.append(slot);
+        }
+    }
+
+    report.teacherConflicts = sweep(teacherSlots, "teacher", teacherNames, report.conflicts);
+    report.classroomConflicts = sweep(classroomSlots, "classroom", classroomNames, report.conflicts);
+    report.elapsedSeconds = timer.nsecsElapsed() / 1e9;
+    report.ok = true;
+    return report;
+}
+
+int ConflictAnalyzer::sweep(QVector<Slot>& timeSlots, const QString& resourceType,
+                            const QHash<int, QString>& resourceNames, QList<Conflict>& conflicts)
+{
+    CB_TRACE_SPAN("conflict.sweep");
+    std::sort(timeSlots.begin(), timeSlots.end(), [](const Slot& a, const Slot& b) {
+        if (a.resource != b.resource) return a.resource < b.resource;
+        if (a.dayOfWeek != b.dayOfWeek) return a.dayOfWeek < b.dayOfWeek;
+        return a.startSecs < b.startSecs;
+    });
+
+    int total = 0;
+    QVector<int> active; // 当前分组内尚未结束的时段
+    for (int i = 0; i < timeSlots.size(); i++) {
+        const Slot& current = timeSlots[i];
+        if (i == 0 || current.resource != timeSlots[i - 1].resource || current.dayOfWeek != timeSlots[i - 1].dayOfWeek) {
+            active.clear();
+        }
+
+        // 移除在当前课程开始前（含恰好下课时）已结束的时段
+        active.erase(std::remove_if(active.begin(), active.end(), [&](int index) {
+            return timeSlots[index].endSecs <= current.startSecs;
+        }), active.end());
+
+        for (int index : active) {
+            const Slot& other = timeSlots[index];
+            if (other.startDay > current.endDay || current.startDay > other.endDay) {
+                continue; // 日期范围不重叠
+            }
+            if (!WeekMask::overlaps(other.weekMask, other.firstMonday, current.weekMask, current.firstMonday)) {
+                continue; // 上课周不重叠（如单双周）
+            }
+
+            total++;
+            if (conflicts.size() < kMaxReportedConflicts) {
+                Conflict conflict;
+                conflict.resourceType = resourceType;
+                conflict.resourceName = resourceNames.value(current.resource, QString::number(current.resource));
+                conflict.dayOfWeek = current.dayOfWeek;
+                conflict.courseA = other.courseId;
+                conflict.courseB = current.courseId;
+                conflict.overlapStartSecs = current.startSecs;
+                conflict.overlapEndSecs = qMin(current.endSecs, other.endSecs);
+                conflicts.append(conflict);
+            }
+        }
+        active.append(i);
+    }
+    return total;
+}
+
+void ConflictAnalyzer::onAnalysisFinished()
+{
+    Report report = m_watcher->result();
+    if (report.ok) {
+        MetricsRegistry& metrics = MetricsRegistry::instance();
+        metrics.setGauge("classboard_schedule_conflicts", report.teacherConflicts, "resource=\"teacher\"");
+        metrics.setGauge("classboard_schedule_conflicts", report.classroomConflicts, "resource=\"classroom\"");
+        metrics.observe("classboard_conflict_analysis_seconds", report.elapsedSeconds);
+
+        const QString summary = QString("课表冲突检测完成：%1门课程，教师冲突%2处，教室冲突%3处，耗时%4毫秒")
+                                .arg(report.courseRows).arg(report.teacherConflicts).arg(report.classroomConflicts)
+                                .arg(report.elapsedSeconds * 1000, 0, 'f', 1);
+        const bool hasConflicts = report.teacherConflicts + report.classroomConflicts > 0;
+        writeLog(hasConflicts ? "WARNING" : "INFO", summary, "CONFLICT");
+
+        static const QStringList weekDays = { "", "周一", "周二", "周三", "周四", "周五", "周六", "周日" };
+        for (int i = 0; i < report.conflicts.size() && i < kMaxLoggedConflicts; i++) {
+            const Conflict& conflict = report.conflicts[i];
+            writeLog("WARNING", QString("%1冲突：%2 %3 %4-%5，课程ID %6 与 %7")
+                     .arg(conflict.resourceType == "teacher" ? "教师" : "教室", conflict.resourceName,
+                          weekDays.value(conflict.dayOfWeek),
+                          QTime::fromMSecsSinceStartOfDay(conflict.overlapStartSecs * 1000).toString("HH:mm"),
+                          QTime::fromMSecsSinceStartOfDay(conflict.overlapEndSecs * 1000).toString("HH:mm"))
+                     .arg(conflict.courseA).arg(conflict.courseB), "CONFLICT");
+        }
+
+        emit analysisFinished(report.teacherConflicts, report.classroomConflicts);
+    }
+
+    if (m_pending) {
+        m_pending = false;
+        analyzeAsync();
+    }
+}
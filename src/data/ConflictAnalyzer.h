@@ -0,0 +1,84 @@
+#ifndef CONFLICTANALYZER_H
+#define CONFLICTANALYZER_H
+
+#include <QObject>
+#include <QSqlDatabase>
+#include <QFutureWatcher>
+#include <QVector>
+#include <QList>
+#include <QStringList>
+#include <QHash>
+
+// 课表冲突检测（单例）：检查同一教师/同一教室在同一星期内时间、日期、上课周均重叠的课程
+// 按 (资源, 星期, 开始时间) 排序后扫描线检测，O(n log n)；同步完成后在线程池中运行，结果写入日志与指标
+class ConflictAnalyzer : public QObject
+{
+    Q_OBJECT
+public:
+    // 一节课的占用时段
+    struct Slot
+    {
+        int courseId = 0;
+        int resource = 0;       // 资源编号（教师ID或教室ID）
+        int dayOfWeek = 0;
+        int startSecs = 0;      // 上课/下课时刻（自零点起的秒数）
+        int endSecs = 0;
+        qint64 startDay = 0;    // 起止日期（儒略日）
+        qint64 endDay = 0;
+        qint64 firstMonday = 0; // 开始日期所在周周一（儒略日，用于对齐上课周）
+        qint64 weekMask = -1;   // 上课周位图
+    };
+
+    struct Conflict
+    {
+        QString resourceType;   // teacher / classroom
+        QString resourceName;
+        int dayOfWeek = 0;
+        int courseA = 0;
+        int courseB = 0;
+        int overlapStartSecs = 0;
+        int overlapEndSecs = 0;
+    };
+
+    struct Report
+    {
+        QList<Conflict> conflicts;  // 冲突明细（最多保留 kMaxReportedConflicts 条）
+        int teacherConflicts = 0;
+        int classroomConflicts = 0;
+        int courseRows = 0;
+        double elapsedSeconds = 0.0;
+        bool ok = false;
+    };
+
+    static const int kMaxReportedConflicts = 1000;
+
+    static ConflictAnalyzer& instance();
+    ~ConflictAnalyzer() = default;
+
+    // 后台分析（使用独立数据库连接；已有分析在运行时，结束后再补跑一次）
+    void analyzeAsync();
+
+    // 在当前线程读取课表并分析（db 须属于当前线程）
+    static Report analyze(QSqlDatabase db);
+
+    // 扫描线检测：timeSlots 会被重新排序；resourceNames 按资源编号给出显示名称
+    // 返回冲突总数，明细追加到 conflicts（超过上限后只计数）
+    static int sweep(QVector<Slot>& timeSlots, const QString& resourceType,
+                     const QHash<int, QString>& resourceNames, QList<Conflict>& conflicts);
+
+signals:
+    void analysisFinished(int teacherConflicts, int classroomConflicts);
+
+private slots:
+    void onAnalysisFinished();
+
+private:
+    ConflictAnalyzer(QObject* parent = nullptr);
+    ConflictAnalyzer(const ConflictAnalyzer&) = delete;
+    ConflictAnalyzer& operator=(const ConflictAnalyzer&) = delete;
+
+    QFutureWatcher<Report>* m_watcher;
+    bool m_pending = false;     // 分析期间又有新的同步完成
+};
+
+#endif // CONFLICTANALYZER_H
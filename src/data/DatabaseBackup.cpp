@@ -0,0 +1,179 @@
+#include "DatabaseBackup.h"
+#include "SqlitePragmas.h"
+#include "metrics/Tracer.h"
+#include "utility/LogHelper.h"
+#include "utility/FileHelper.h"
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QFile>
+#include <QFileInfo>
+#include <QThread>
+#include <QElapsedTimer>
+
+#ifdef CLASSBOARD_SQLITE_BACKUP
+#include <sqlite3.h>
+#endif
+
+#ifdef CLASSBOARD_SQLITE_BACKUP
+// 每步复制的页数与步间暂停（默认页大小4KB，每步约256KB、耗时1-2毫秒）
+static const int kPagesPerStep = 64;
+static const int kStepPauseMs = 5;
+// 源库被持续改写时重新开始的上限，超过后改用 VACUUM INTO
+static const int kMaxRestarts = 3;
+#endif
+
+// 工作线程内连接名唯一
+static QString backupConnectionName(const char* purpose)
+{
+    return QString("classboard_backup_%1_%2").arg(purpose).arg(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+}
+
+DatabaseBackup::Result DatabaseBackup::run(const QString& sourcePath, const QString& targetPath)
+{
+    CB_TRACE_SPAN("db.backup");
+    QElapsedTimer timer;
+    timer.start();
+    Result result;
+
+    const QString partPath = targetPath + ".part";
+    QFile::remove(partPath);
+
+    bool copied = copyWithBackupApi(sourcePath, partPath, result);
+    if (!copied) {
+        QFile::remove(partPath);
+        copied = copyWithVacuumInto(sourcePath, partPath, result);
+    }
+
+    if (copied && verify(partPath, &result.error)) {
+        // 校验通过后再替换目标文件，目标处始终是完整的旧快照或新快照
+        if (FileHelper::replaceFileAtomically(partPath, targetPath)) {
+            result.ok = true;
+            result.bytes = QFileInfo(targetPath).size();
+        } else {
+            result.error = "快照文件重命名失败：" + targetPath;
+        }
+    }
+    if (!result.ok) {
+        QFile::remove(partPath);
+    }
+
+    result.elapsedSeconds = timer.nsecsElapsed() / 1e9;
+    return result;
+}
+
+bool DatabaseBackup::copyWithBackupApi(const QString& sourcePath, const QString& partPath, Result& result)
+{
+#ifdef CLASSBOARD_SQLITE_BACKUP
+    sqlite3* source = nullptr;
+    sqlite3* target = nullptr;
+    if (sqlite3_open_v2(sourcePath.toUtf8().constData(), &source, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK
+        || sqlite3_open_v2(partPath.toUtf8().constData(), &target, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK) {
+        result.error = QString("备份打开数据库失败：%1")
+                           .arg(QString::fromUtf8(sqlite3_errmsg(target ? target : source)));
+        sqlite3_close(source);
+        sqlite3_close(target);
+        return false;
+    }
+    sqlite3_busy_timeout(source, 50);
+
+    bool ok = false;
+    sqlite3_backup* backup = sqlite3_backup_init(target, "main", source, "main");
+    if (backup) {
+        int rc = SQLITE_OK;
+        int lastRemaining = -1;
+        while (true) {
+            rc = sqlite3_backup_step(backup, kPagesPerStep);
+            result.steps++;
+            if (rc != SQLITE_OK && rc != SQLITE_BUSY && rc != SQLITE_LOCKED) {
+                break;
+            }
+            // 剩余页数变多说明源库被其他连接改写，复制已从头开始
+            const int remaining = sqlite3_backup_remaining(backup);
+            if (lastRemaining >= 0 && remaining > lastRemaining && ++result.restarts > kMaxRestarts) {
+                break;
+            }
+            lastRemaining = remaining;
+            QThread::msleep(kStepPauseMs);
+        }
+        sqlite3_backup_finish(backup);
+        ok = rc == SQLITE_DONE;
+        if (!ok) {
+            result.error = result.restarts > kMaxRestarts
+                ? QString("源库持续被改写，分步复制重新开始超过%1次").arg(kMaxRestarts)
+                : QString("分步复制失败：%1").arg(QString::fromUtf8(sqlite3_errstr(rc)));
+        }
+    } else {
+        result.error = "分步复制初始化失败：" + QString::fromUtf8(sqlite3_errmsg(target));
+    }
+
+    sqlite3_close(source);
+    sqlite3_close(target);
+    if (ok) {
+        result.method = "backup_api";
+    } else {
+        writeLog("WARNING", result.error + "，改用 VACUUM INTO", "BACKUP");
+    }
+    return ok;
+#else
+    Q_UNUSED(sourcePath);
+    Q_UNUSED(partPath);
+    Q_UNUSED(result);
+    return false;
+#endif
+}
+
+bool DatabaseBackup::copyWithVacuumInto(const QString& sourcePath, const QString& partPath, Result& result)
+{
+    const QString connName = backupConnectionName("vacuum");
+    bool ok = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+        db.setDatabaseName(sourcePath);
+        db.setConnectOptions("QSQLITE_OPEN_READONLY");
+        if (db.open()) {
+            SqlitePragmaProfile::current().apply(db, true);
+            QSqlQuery query(db);
+            query.prepare("VACUUM INTO ?");
+            query.addBindValue(partPath);
+            ok = query.exec();
+            if (!ok) {
+                result.error = "VACUUM INTO 失败：" + query.lastError().text();
+            }
+            db.close();
+        } else {
+            result.error = "备份打开数据库失败：" + db.lastError().text();
+        }
+    }
+    QSqlDatabase::removeDatabase(connName);
+
+    if (ok) {
+        result.method = "vacuum_into";
+        result.steps = 1;
+    }
+    return ok;
+}
+
+bool DatabaseBackup::verify(const QString& path, QString* error)
+{
+    const QString connName = backupConnectionName("verify");
+    bool ok = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+        db.setDatabaseName(path);
+        db.setConnectOptions("QSQLITE_OPEN_READONLY");
+        if (db.open()) {
+            QSqlQuery query(db);
+            ok = query.exec("PRAGMA quick_check") && query.next() && query.value(0).toString() == "ok";
+            if (!ok) {
+                *error = "快照完整性检查未通过：" + (query.lastError().isValid() ? query.lastError().text()
+                                                                              : query.value(0).toString());
+            }
+            db.close();
+        } else {
+            *error = "快照打开失败：" + db.lastError().text();
+        }
+    }
+    QSqlDatabase::removeDatabase(connName);
+    return ok;
+}
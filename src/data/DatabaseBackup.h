@@ -0,0 +1,33 @@
+#ifndef DATABASEBACKUP_H
+#define DATABASEBACKUP_H
+
+#include <QString>
+
+// 数据库在线备份（阻塞调用，须在工作线程中运行）
+// 以独立连接读取源库，先写入 “目标.part”，校验通过后原子替换目标文件，得到一致的快照，可直接用于新班牌开通。
+// CONFIG+=sqlite_backup 构建（链接系统SQLite）时使用 sqlite3_backup 分步复制：每步少量页、步间让出，
+// 每步只短暂持有读锁，主连接的读写不会被阻塞；否则使用 VACUUM INTO（单个读事务内完成，快照同样一致）
+class DatabaseBackup
+{
+public:
+    struct Result
+    {
+        bool ok = false;
+        QString method;         // backup_api / vacuum_into
+        qint64 bytes = 0;       // 快照文件大小
+        int steps = 0;          // 分步复制的步数（VACUUM INTO 为1）
+        int restarts = 0;       // 源库在复制期间被改写导致的重新开始次数
+        double elapsedSeconds = 0.0;
+        QString error;
+    };
+
+    static Result run(const QString& sourcePath, const QString& targetPath);
+
+private:
+    static bool copyWithBackupApi(const QString& sourcePath, const QString& partPath, Result& result);
+    static bool copyWithVacuumInto(const QString& sourcePath, const QString& partPath, Result& result);
+    // 快照完整性检查（PRAGMA quick_check）
+    static bool verify(const QString& path, QString* error);
+};
+
+#endif // DATABASEBACKUP_H
@@ -1,5 +1,13 @@
 #include "DatabaseManager.h"
+#include "metrics/MetricsRegistry.h"
+#include "metrics/Tracer.h"
+#include "utility/Clock.h"
+#include "utility/FileHelper.h"
+#include "utility/TimeHelper.h"
+#include "utility/WeekMask.h"
 #include <QRegularExpression>
+#include <QFileInfo>
+#include <QtConcurrent/QtConcurrentRun>
 #include <QStandardPaths>
 #include <QDir>
 #include <QThread>
@@ -10,6 +18,48 @@
 #include <QSqlError>
 #include <QVariantMap>
 #include <QList>
+#include <algorithm>
+
+// 数据库结构版本（修改 create_tables.sql 时递增；版本一致时启动不再重建数据表）
+static const int kSchemaVersion = 9;
+
+// 快照开通时必须存在的数据表（其余表缺失时视为不完整的快照）
+static const char* const kSnapshotRequiredTables[] = {
+    "class_info", "classroom_info", "course_schedule", "notices", "calendar_exceptions", "sync_state"
+};
+
+// 有效课表保留的历史天数（更早的展开数据在启动时清理）
+static const int kEffectiveScheduleKeepDays = 7;
+
+// 课表时刻精确到分钟，getCurrentCourse 以 end_time >= 当前 HH:mm 判定上课中，
+// 即下课那一分钟仍算占用；教室区间的结束时刻取下课分钟的末尾，两处口径一致
+static const int kEndMinuteSecs = 60;
+
+// 由课程字段构造教室区间
+static RoomIntervalIndex::Interval makeRoomInterval(int courseId, int classroomId, int dayOfWeek,
+                                                   const QString& startTime, const QString& endTime,
+                                                   const QString& startDate, const QString& endDate, qint64 weekMask)
+{
+    RoomIntervalIndex::Interval interval;
+    interval.courseId = courseId;
+    interval.classroomId = classroomId;
+    interval.dayOfWeek = dayOfWeek;
+    interval.startSecs = DayTime::parse(startTime).secs;
+    interval.endSecs = DayTime::parse(endTime).secs + kEndMinuteSecs;
+    interval.startDay = TimeHelper::julianDayFromIso(startDate);
+    interval.endDay = TimeHelper::julianDayFromIso(endDate);
+    interval.firstMonday = TimeHelper::mondayOfJulianDay(interval.startDay);
+    interval.weekMask = weekMask;
+    return interval;
+}
+
+// 某日期实际按星期几上课的SQL表达式：节假日为0（不匹配任何课程），调休日取 as_day_of_week，否则取自然星期（1-7）
+static QString effectiveDayOfWeekSql(const QString& dateExpr)
+{
+    return QString("COALESCE((SELECT CASE ce.kind WHEN 0 THEN 0 ELSE ce.as_day_of_week END "
+                   "FROM calendar_exceptions ce WHERE ce.date = %1), "
+                   "(CAST(strftime('%w', %1) AS INTEGER) + 6) % 7 + 1)").arg(dateExpr);
+}
 
 // 单例实例初始化
 DatabaseManager& DatabaseManager::instance()
@@ -67,14 +117,39 @@ bool DatabaseManager::init(const QString& dbPath)
         return false;
     }
 
+    // 连接参数须在建表前生效（journal_mode 切换需要独占数据库）
+    const SqlitePragmaProfile profile = SqlitePragmaProfile::current();
+    profile.apply(m_db, false);
+    writeLog("INFO", "数据库连接参数：" + profile.describe(), "DATABASE");
+
     // 创建数据表
     createTables();
 
+    // 清理过期的有效课表展开数据
+    QSqlQuery pruneQuery(m_db);
+    QString keepFrom = Clock::currentDate().addDays(-kEffectiveScheduleKeepDays).toString("yyyy-MM-dd");
+    pruneQuery.prepare("DELETE FROM effective_schedule WHERE date < ?");
+    pruneQuery.addBindValue(keepFrom);
+    pruneQuery.exec();
+    pruneQuery.prepare("DELETE FROM materialized_dates WHERE date < ?");
+    pruneQuery.addBindValue(keepFrom);
+    pruneQuery.exec();
+
     writeLog("INFO", "数据库初始化成功", "DATABASE");
     emit operateSuccess("数据库初始化成功");
     return true;
 }
 
+// 设置连接参数（已连接时立即生效）
+void DatabaseManager::setPragmaProfile(const SqlitePragmaProfile& profile)
+{
+    SqlitePragmaProfile::setCurrent(profile);
+    if (m_db.isOpen()) {
+        profile.apply(m_db, false);
+        writeLog("INFO", "数据库连接参数：" + profile.describe(), "DATABASE");
+    }
+}
+
 // 辅助函数：清理SQL语句中的单行注释和空白（仅保留这一个定义）
 QString DatabaseManager::cleanSqlStatement(const QString& stmt)
 {
@@ -93,52 +168,82 @@ void DatabaseManager::createTables()
 {
     QSqlQuery query(m_db);
 
-    // -------------------------- 读取建表脚本 --------------------------
-    QFile sqlFile(":/sql/create_tables.sql");
-
-    if (sqlFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        // 处理UTF-8 BOM
-        QByteArray content = sqlFile.readAll();
-        if (content.startsWith("\xef\xbb\xbf")) {
-            content = content.mid(3);
-        }
-        QString sql = QString::fromUtf8(content);
-        sqlFile.close();
+    // -------------------------- 检查结构版本 --------------------------
+    // 建表脚本会先DROP再CREATE，仅在结构版本变化时执行，避免每次启动清空已同步数据
+    int dbVersion = 0;
+    if (query.exec("PRAGMA user_version") && query.next()) {
+        dbVersion = query.value(0).toInt();
+    }
 
-        // 分割SQL语句（按分号分割，保留有效语句）
-        QStringList sqlList = sql.split(";", Qt::SkipEmptyParts);
+    if (dbVersion != kSchemaVersion) {
+        writeLog("INFO", QString("数据库结构版本%1与当前版本%2不一致，重建数据表").arg(dbVersion).arg(kSchemaVersion), "DATABASE");
 
-        // 先执行建表语句，再执行索引语句（保证顺序）
-        QStringList createTableStmts; // 建表语句
-        QStringList createIndexStmts; // 索引语句
+        // 通知全文索引不在建表脚本中，随 notices 一并重建
+        query.exec("DROP TABLE IF EXISTS notices_fts");
+        // 增量回收空闲页（数据保留任务归档后按批回收），须在建表前设置
+        query.exec("PRAGMA auto_vacuum = INCREMENTAL");
 
-        for (int i = 0; i < sqlList.size(); i++) {
-            QString rawStmt = sqlList[i];
-            QString cleanStmt = cleanSqlStatement(rawStmt); // 清理注释和空白
+        // -------------------------- 读取建表脚本 --------------------------
+        QFile sqlFile(":/sql/create_tables.sql");
 
-            // 跳过清理后为空的语句
-            if (cleanStmt.isEmpty()) {
-                continue;
+        if (sqlFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            // 处理UTF-8 BOM
+            QByteArray content = sqlFile.readAll();
+            if (content.startsWith("\xef\xbb\xbf")) {
+                content = content.mid(3);
             }
-
-            // 分类：建表/索引语句
-            if (cleanStmt.startsWith("CREATE TABLE", Qt::CaseInsensitive) ||
-                cleanStmt.startsWith("DROP TABLE", Qt::CaseInsensitive)) {
-                createTableStmts.append(cleanStmt);
-            } else if (cleanStmt.startsWith("CREATE INDEX", Qt::CaseInsensitive)) {
-                createIndexStmts.append(cleanStmt);
+            QString sql = QString::fromUtf8(content);
+            sqlFile.close();
+
+            // 分割SQL语句（按分号分割，保留有效语句）
+            QStringList sqlList = sql.split(";", Qt::SkipEmptyParts);
+
+            // 先执行建表语句，再执行索引语句（保证顺序）
+            QStringList createTableStmts; // 建表语句
+            QStringList createIndexStmts; // 索引语句
+
+            for (int i = 0; i < sqlList.size(); i++) {
+                QString rawStmt = sqlList[i];
+                QString cleanStmt = cleanSqlStatement(rawStmt); // 清理注释和空白
+
+                // 跳过清理后为空的语句
+                if (cleanStmt.isEmpty()) {
+                    continue;
+                }
+
+                // 分类：建表/索引语句
+                if (cleanStmt.startsWith("CREATE TABLE", Qt::CaseInsensitive) ||
+                    cleanStmt.startsWith("DROP TABLE", Qt::CaseInsensitive)) {
+                    createTableStmts.append(cleanStmt);
+                } else if (cleanStmt.startsWith("CREATE INDEX", Qt::CaseInsensitive)) {
+                    createIndexStmts.append(cleanStmt);
+                }
+
+                // 执行当前语句
+                if (!query.exec(cleanStmt)) {
+                    writeLog("WARNING", QString("建表语句执行失败：%1").arg(query.lastError().text()), "DATABASE");
+                }
             }
 
-            // 执行当前语句
-            if (!query.exec(cleanStmt)) {
-                writeLog("WARNING", QString("建表语句执行失败：%1").arg(query.lastError().text()), "DATABASE");
+            // 已有数据库文件的 auto_vacuum 模式只能经一次 VACUUM 切换（此时表刚重建，代价很小）
+            if (query.exec("PRAGMA auto_vacuum") && query.next() && query.value(0).toInt() != 2) {
+                query.finish();
+                if (!query.exec("VACUUM")) {
+                    writeLog("WARNING", "切换增量回收模式失败：" + query.lastError().text(), "DATABASE");
+                }
             }
+
+            // 记录结构版本（仅建表脚本执行后）
+            query.exec(QString("PRAGMA user_version = %1").arg(kSchemaVersion));
+        } else {
+            // 移除内置SQL后，仅打印错误日志，不执行任何建表操作
+            writeLog("ERROR", "未找到建表脚本：:/sql/create_tables.sql，无法创建数据表", "DATABASE");
         }
-    } else {
-        // 移除内置SQL后，仅打印错误日志，不执行任何建表操作
-        writeLog("ERROR", "未找到建表脚本：:/sql/create_tables.sql，无法创建数据表", "DATABASE");
     }
 
+    // 通知全文索引须先于测试数据导入建立，导入的通知经触发器同步入索引
+    m_noticeFtsReady = ensureNoticeFts();
+
     // -------------------------- 导入测试数据（仅当无班级数据时） --------------------------
     // 先检查class_info是否已有数据
     query.exec("SELECT COUNT(*) FROM class_info");
@@ -178,20 +283,33 @@ void DatabaseManager::createTables()
                 writeLog("ERROR", QString("测试数据语句执行失败：%1").arg(query.lastError().text()), "DATABASE");
             }
         }
+
+        // 测试数据直接写入课表，需重新展开有效课表
+        invalidateEffectiveSchedule();
     }
 }
 
 // -------------------------- 班级管理实现（仅保留查询/搜索） --------------------------
 QList<QVariantMap> DatabaseManager::getAllClasses()
+{
+    CB_DB_METHOD("getAllClasses");
+    QString errMsg;
+    QList<QVariantMap> classList = selectAllClasses(m_db, &errMsg);
+    if (!errMsg.isEmpty()) {
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+    }
+    return classList;
+}
+
+QList<QVariantMap> DatabaseManager::selectAllClasses(QSqlDatabase& db, QString* error)
 {
     QList<QVariantMap> classList;
-    QSqlQuery query(m_db); // 先创建查询对象，绑定数据库
+    QSqlQuery query(db); // 先创建查询对象，绑定数据库
     // 准备并执行查询（关键：必须调用exec()）
     QString sql = "SELECT id, class_name, grade, department FROM class_info ORDER BY id";
     if (!query.exec(sql)) { // 执行查询并检查是否成功
-        QString errMsg = "查询所有班级失败：" + query.lastError().text();
-        writeLog("ERROR", errMsg, "DATABASE");
-        emit operateFailed(errMsg);
+        *error = "查询所有班级失败：" + query.lastError().text();
         return classList; // 执行失败返回空列表
     }
 
@@ -209,6 +327,7 @@ QList<QVariantMap> DatabaseManager::getAllClasses()
 
 QList<QVariantMap> DatabaseManager::searchClasses(const QString& keyword)
 {
+    CB_DB_METHOD("searchClasses");
     QList<QVariantMap> classList;
     QSqlQuery query(m_db);
     query.prepare(R"(
@@ -240,6 +359,7 @@ QList<QVariantMap> DatabaseManager::searchClasses(const QString& keyword)
 // -------------------------- 教室管理新增实现（适配新表） --------------------------
 bool DatabaseManager::addClassroom(const QString& classroomName)
 {
+    CB_DB_METHOD("addClassroom");
     QSqlQuery query(m_db);
     query.prepare(R"(
         INSERT INTO classroom_info (classroom_name)
@@ -248,6 +368,9 @@ bool DatabaseManager::addClassroom(const QString& classroomName)
     query.addBindValue(classroomName);
 
     if (query.exec()) {
+        if (m_roomIndex.isBuilt()) {
+            m_roomIndex.setRoom(query.lastInsertId().toInt(), classroomName);
+        }
         writeLog("INFO", "添加教室成功：" + classroomName, "DATABASE");
         emit operateSuccess("教室添加成功");
         return true;
@@ -261,6 +384,7 @@ bool DatabaseManager::addClassroom(const QString& classroomName)
 
 QList<QVariantMap> DatabaseManager::getAllClassrooms()
 {
+    CB_DB_METHOD("getAllClassrooms");
     QList<QVariantMap> classroomList;
     QSqlQuery query(m_db);
     QString sql = "SELECT id, classroom_name FROM classroom_info ORDER BY id";
@@ -285,6 +409,7 @@ QList<QVariantMap> DatabaseManager::getAllClassrooms()
 // 根据教室ID获取教室名称
 QString DatabaseManager::getClassroomNameById(int classroomId)
 {
+    CB_DB_METHOD("getClassroomNameById");
     QSqlQuery query(m_db);
     query.prepare("SELECT classroom_name FROM classroom_info WHERE id = ?");
     query.addBindValue(classroomId);
@@ -297,12 +422,51 @@ QString DatabaseManager::getClassroomNameById(int classroomId)
     return "";
 }
 
+// -------------------------- 教师管理实现 --------------------------
+QList<QVariantMap> DatabaseManager::getAllTeachers()
+{
+    CB_DB_METHOD("getAllTeachers");
+    QString errMsg;
+    QList<QVariantMap> teacherList = selectAllTeachers(m_db, &errMsg);
+    if (!errMsg.isEmpty()) {
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+    }
+    return teacherList;
+}
+
+QList<QVariantMap> DatabaseManager::selectAllTeachers(QSqlDatabase& db, QString* error)
+{
+    QList<QVariantMap> teacherList;
+    QSqlQuery query(db);
+
+    if (!query.exec("SELECT id, teacher_name FROM teacher_info ORDER BY teacher_name")) {
+        *error = "查询所有教师失败：" + query.lastError().text();
+        return teacherList;
+    }
+
+    while (query.next()) {
+        QVariantMap teacherMap;
+        teacherMap["id"] = query.value("id").toInt();
+        teacherMap["teacher_name"] = query.value("teacher_name").toString();
+        teacherList.append(teacherMap);
+    }
+    return teacherList;
+}
+
+int DatabaseManager::getOrCreateTeacherId(const QString& teacherName)
+{
+    return m_teachers.idFor(m_db, teacherName);
+}
+
 // -------------------------- 课表管理实现 --------------------------
 // 修复：将classroom改为classroom_id，适配外键关联
 bool DatabaseManager::addCourse(int classId, const QString& courseName, const QString& teacher, const QString& courseType,
                                const QString& startTime, const QString& endTime, int dayOfWeek,
-                               const QString& startDate, const QString& endDate, int classroomId)
+                               const QString& startDate, const QString& endDate, int classroomId,
+                               qint64 weekMask, int serverId)
 {
+    CB_DB_METHOD("addCourse");
     // 验证日期格式
     QString formattedStart = formatDate(startDate);
     QString formattedEnd = formatDate(endDate);
@@ -319,24 +483,64 @@ bool DatabaseManager::addCourse(int classId, const QString& courseName, const QS
         return false;
     }
 
+    // 验证上课周
+    if (weekMask == 0) {
+        writeLog("ERROR", "上课周为空：" + courseName, "DATABASE");
+        emit operateFailed("上课周不能为空");
+        return false;
+    }
+
+    // 课程名称、教师、类型按字典编码存储
+    int courseNameId = m_courseNames.idFor(m_db, courseName);
+    int teacherId = getOrCreateTeacherId(teacher);
+    int courseTypeId = m_courseTypes.idFor(m_db, courseType);
+    if (courseNameId == 0 || courseTypeId == 0) {
+        writeLog("ERROR", "课程名称或类型为空：" + courseName + " / " + courseType, "DATABASE");
+        emit operateFailed("课程名称和课程类型不能为空");
+        return false;
+    }
+
     QSqlQuery query(m_db);
     query.prepare(R"(
-        INSERT INTO course_schedule (class_id, course_name, teacher, course_type,
-                                    start_time, end_time, day_of_week, start_date, end_date, classroom_id)
-        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+        INSERT INTO course_schedule (class_id, course_name_id, teacher_id, course_type_id,
+                                    start_time, end_time, day_of_week, start_date, end_date, classroom_id, week_mask,
+                                    server_id)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
     )");
     query.addBindValue(classId);
-    query.addBindValue(courseName);
-    query.addBindValue(teacher);
-    query.addBindValue(courseType);
+    query.addBindValue(courseNameId);
+    query.addBindValue(teacherId > 0 ? QVariant(teacherId) : QVariant(QMetaType::fromType<int>()));
+    query.addBindValue(courseTypeId);
     query.addBindValue(startTime);
     query.addBindValue(endTime);
     query.addBindValue(dayOfWeek);
     query.addBindValue(formattedStart);
     query.addBindValue(formattedEnd);
     query.addBindValue(classroomId);
+    query.addBindValue(weekMask);
+    query.addBindValue(serverId > 0 ? QVariant(serverId) : QVariant(QMetaType::fromType<int>()));
 
     if (query.exec()) {
+        // 增量更新已展开日期的有效课表
+        QSqlQuery effective(m_db);
+        effective.prepare(QString(R"(
+            INSERT OR IGNORE INTO effective_schedule (date, class_id, start_time, end_time, course_id)
+            SELECT md.date, cs.class_id, cs.start_time, cs.end_time, cs.id
+            FROM materialized_dates md
+            JOIN course_schedule cs ON cs.id = ?
+            WHERE md.date BETWEEN cs.start_date AND cs.end_date
+                  AND cs.day_of_week = %1 AND %2
+        )").arg(effectiveDayOfWeekSql("md.date"), WeekMask::sqlContains("cs", "md.date")));
+        effective.addBindValue(query.lastInsertId());
+        if (!effective.exec()) {
+            writeLog("ERROR", "有效课表增量更新失败：" + effective.lastError().text(), "DATABASE");
+        }
+
+        if (m_roomIndex.isBuilt()) {
+            m_roomIndex.insert(makeRoomInterval(query.lastInsertId().toInt(), classroomId, dayOfWeek, startTime, endTime,
+                                                formattedStart, formattedEnd, weekMask));
+        }
+
         writeLog("INFO", "添加课程成功：" + courseName, "DATABASE");
         emit operateSuccess("课程添加成功");
         return true;
@@ -350,11 +554,18 @@ bool DatabaseManager::addCourse(int classId, const QString& courseName, const QS
 
 bool DatabaseManager::deleteCourse(int courseId)
 {
+    CB_DB_METHOD("deleteCourse");
     QSqlQuery query(m_db);
     query.prepare("DELETE FROM course_schedule WHERE id = ?");
     query.addBindValue(courseId);
 
     if (query.exec()) {
+        QSqlQuery effective(m_db);
+        effective.prepare("DELETE FROM effective_schedule WHERE course_id = ?");
+        effective.addBindValue(courseId);
+        effective.exec();
+        m_roomIndex.remove(courseId);
+
         writeLog("INFO", "删除课程成功，ID：" + QString::number(courseId), "DATABASE");
         emit operateSuccess("课程删除成功");
         return true;
@@ -368,78 +579,164 @@ bool DatabaseManager::deleteCourse(int courseId)
 
 // 修复：查询classroom_id并关联获取教室名称
 QList<QVariantMap> DatabaseManager::getCoursesByClassId(int classId)
+{
+    CB_DB_METHOD("getCoursesByClassId");
+    QString errMsg;
+    QList<QVariantMap> courseList = selectCoursesByClassId(m_db, classId, Clock::currentDate().toString("yyyy-MM-dd"),
+                                                           m_courseNames, m_teachers, m_courseTypes, &errMsg);
+    if (!errMsg.isEmpty()) {
+        writeLog("ERROR", errMsg, "DATABASE");
+    }
+    return courseList;
+}
+
+QList<QVariantMap> DatabaseManager::selectCoursesByClassId(QSqlDatabase& db, int classId, const QString& today,
+                                                           StringDictionary& courseNames, StringDictionary& teachers,
+                                                           StringDictionary& courseTypes, QString* error)
 {
     QList<QVariantMap> courseList;
-    QString today = QDate::currentDate().toString("yyyy-MM-dd");
 
-    QSqlQuery query(m_db);
-    query.prepare(R"(
-        SELECT cs.id, cs.course_name, cs.teacher, cs.course_type, cs.start_time, cs.end_time,
-               cs.day_of_week, cs.start_date, cs.end_date, cs.classroom_id, ci.classroom_name
+    // 课表按本周显示：不在本周上课周内的课程不列出
+    QSqlQuery query(db);
+    QString sql = R"(
+        SELECT cs.id, cs.course_name_id, cs.teacher_id, cs.course_type_id, cs.start_time, cs.end_time,
+               cs.day_of_week, cs.start_date, cs.end_date, cs.classroom_id, cs.week_mask, ci.classroom_name
         FROM course_schedule cs
         LEFT JOIN classroom_info ci ON cs.classroom_id = ci.id
-        WHERE cs.class_id = ? AND cs.start_date <= ? AND cs.end_date >= ?
+        WHERE cs.class_id = ? AND cs.start_date <= ? AND cs.end_date >= ? AND %1
         ORDER BY cs.day_of_week, cs.start_time
-    )");
+    )";
+    query.prepare(sql.arg(WeekMask::sqlContains("cs", "?")));
     query.addBindValue(classId);
     query.addBindValue(today);
     query.addBindValue(today);
+    query.addBindValue(today); // 本周是否上课
 
     if (query.exec()) {
         while (query.next()) {
             QVariantMap courseMap;
             courseMap["id"] = query.value("id").toInt();
-            courseMap["course_name"] = query.value("course_name").toString();
-            courseMap["teacher"] = query.value("teacher").toString();
-            courseMap["course_type"] = query.value("course_type").toString();
+            courseMap["course_name"] = courseNames.name(db, query.value("course_name_id").toInt());
+            courseMap["teacher"] = teachers.name(db, query.value("teacher_id").toInt());
+            courseMap["course_type"] = courseTypes.name(db, query.value("course_type_id").toInt());
             courseMap["start_time"] = query.value("start_time").toString();
             courseMap["end_time"] = query.value("end_time").toString();
+            // 解析一次，界面每秒刷新时直接比较秒数
+            courseMap["start_secs"] = DayTime::parse(courseMap["start_time"].toString()).secs;
+            courseMap["end_secs"] = DayTime::parse(courseMap["end_time"].toString()).secs;
             courseMap["day_of_week"] = query.value("day_of_week").toInt();
             courseMap["start_date"] = query.value("start_date").toString();
             courseMap["end_date"] = query.value("end_date").toString();
             courseMap["classroom_id"] = query.value("classroom_id").toInt();
+            courseMap["week_mask"] = query.value("week_mask").toLongLong();
             courseMap["classroom_name"] = query.value("classroom_name").toString(); // 返回教室名称
             courseList.append(courseMap);
         }
     } else {
-        QString errMsg = "课程查询失败：" + query.lastError().text();
+        *error = "课程查询失败：" + query.lastError().text();
+    }
+    return courseList;
+}
+
+// 教师本周课表：按 (teacher_id, day_of_week, start_time) 索引有序读取
+QList<QVariantMap> DatabaseManager::getCoursesByTeacher(int teacherId)
+{
+    CB_DB_METHOD("getCoursesByTeacher");
+    QString errMsg;
+    QList<QVariantMap> courseList = selectCoursesByTeacher(m_db, teacherId, Clock::currentDate().toString("yyyy-MM-dd"),
+                                                           m_courseNames, m_teachers, m_courseTypes, &errMsg);
+    if (!errMsg.isEmpty()) {
         writeLog("ERROR", errMsg, "DATABASE");
     }
     return courseList;
 }
 
+QList<QVariantMap> DatabaseManager::selectCoursesByTeacher(QSqlDatabase& db, int teacherId, const QString& today,
+                                                           StringDictionary& courseNames, StringDictionary& teachers,
+                                                           StringDictionary& courseTypes, QString* error)
+{
+    QList<QVariantMap> courseList;
+
+    QSqlQuery query(db);
+    QString sql = R"(
+        SELECT cs.id, cs.class_id, cl.class_name, cs.course_name_id, cs.teacher_id, cs.course_type_id,
+               cs.start_time, cs.end_time, cs.day_of_week, cs.start_date, cs.end_date,
+               cs.classroom_id, cs.week_mask, ci.classroom_name
+        FROM course_schedule cs
+        LEFT JOIN class_info cl ON cs.class_id = cl.id
+        LEFT JOIN classroom_info ci ON cs.classroom_id = ci.id
+        WHERE cs.teacher_id = ? AND cs.start_date <= ? AND cs.end_date >= ? AND %1
+        ORDER BY cs.day_of_week, cs.start_time
+    )";
+    query.prepare(sql.arg(WeekMask::sqlContains("cs", "?")));
+    query.addBindValue(teacherId);
+    query.addBindValue(today);
+    query.addBindValue(today);
+    query.addBindValue(today); // 本周是否上课
+
+    if (query.exec()) {
+        while (query.next()) {
+            QVariantMap courseMap;
+            courseMap["id"] = query.value("id").toInt();
+            courseMap["class_id"] = query.value("class_id").toInt();
+            courseMap["class_name"] = query.value("class_name").toString();
+            courseMap["course_name"] = courseNames.name(db, query.value("course_name_id").toInt());
+            courseMap["teacher"] = teachers.name(db, query.value("teacher_id").toInt());
+            courseMap["course_type"] = courseTypes.name(db, query.value("course_type_id").toInt());
+            courseMap["start_time"] = query.value("start_time").toString();
+            courseMap["end_time"] = query.value("end_time").toString();
+            courseMap["start_secs"] = DayTime::parse(courseMap["start_time"].toString()).secs;
+            courseMap["end_secs"] = DayTime::parse(courseMap["end_time"].toString()).secs;
+            courseMap["day_of_week"] = query.value("day_of_week").toInt();
+            courseMap["start_date"] = query.value("start_date").toString();
+            courseMap["end_date"] = query.value("end_date").toString();
+            courseMap["classroom_id"] = query.value("classroom_id").toInt();
+            courseMap["week_mask"] = query.value("week_mask").toLongLong();
+            courseMap["classroom_name"] = query.value("classroom_name").toString();
+            courseList.append(courseMap);
+        }
+    } else {
+        *error = "教师课表查询失败：" + query.lastError().text();
+    }
+    return courseList;
+}
+
 // 修复：关联教室表获取教室名称
 QVariantMap DatabaseManager::getCurrentCourse(int classId)
 {
+    CB_DB_METHOD("getCurrentCourse");
     QVariantMap currentCourse;
-    QDate today = QDate::currentDate();
-    QTime now = QTime::currentTime();
+    QDateTime current = Clock::currentDateTime();
+    QDate today = current.date();
+    QTime now = current.time();
     QString todayStr = today.toString("yyyy-MM-dd");
-    int dayOfWeek = today.dayOfWeek();
+    ensureDateMaterialized(todayStr);
 
+    // 按日期展开的有效课表已考虑节假日/调休，按 (date, class_id) 主键等值查找
     QSqlQuery query(m_db);
     query.prepare(R"(
-        SELECT cs.id, cs.course_name, cs.teacher, cs.course_type, cs.start_time, cs.end_time,
+        SELECT cs.id, cs.course_name_id, cs.teacher_id, cs.course_type_id, cs.start_time, cs.end_time,
                cs.classroom_id, ci.classroom_name
-        FROM course_schedule cs
+        FROM effective_schedule es
+        JOIN course_schedule cs ON cs.id = es.course_id
         LEFT JOIN classroom_info ci ON cs.classroom_id = ci.id
-        WHERE cs.class_id = ? AND cs.day_of_week = ? AND cs.start_date <= ? AND cs.end_date >= ?
-              AND cs.start_time <= ? AND cs.end_time >= ?
+        WHERE es.date = ? AND es.class_id = ? AND es.start_time <= ? AND es.end_time >= ?
     )");
-    query.addBindValue(classId);
-    query.addBindValue(dayOfWeek);
-    query.addBindValue(todayStr);
     query.addBindValue(todayStr);
+    query.addBindValue(classId);
     query.addBindValue(now.toString("HH:mm"));
     query.addBindValue(now.toString("HH:mm"));
 
     if (query.exec() && query.next()) {
         currentCourse["id"] = query.value("id").toInt();
-        currentCourse["course_name"] = query.value("course_name").toString();
-        currentCourse["teacher"] = query.value("teacher").toString();
-        currentCourse["course_type"] = query.value("course_type").toString();
+        currentCourse["course_name"] = m_courseNames.name(m_db, query.value("course_name_id").toInt());
+        currentCourse["teacher"] = m_teachers.name(m_db, query.value("teacher_id").toInt());
+        currentCourse["course_type"] = m_courseTypes.name(m_db, query.value("course_type_id").toInt());
         currentCourse["start_time"] = query.value("start_time").toString();
         currentCourse["end_time"] = query.value("end_time").toString();
+        // 解析一次，界面每秒刷新时直接比较秒数
+        currentCourse["start_secs"] = DayTime::parse(currentCourse["start_time"].toString()).secs;
+        currentCourse["end_secs"] = DayTime::parse(currentCourse["end_time"].toString()).secs;
         currentCourse["classroom_id"] = query.value("classroom_id").toInt();
         currentCourse["classroom_name"] = query.value("classroom_name").toString();
     }
@@ -450,35 +747,38 @@ QVariantMap DatabaseManager::getCurrentCourse(int classId)
 // 修复：关联教室表获取教室名称
 QVariantMap DatabaseManager::getNextCourse(int classId)
 {
+    CB_DB_METHOD("getNextCourse");
     QVariantMap nextCourse;
-    QDate today = QDate::currentDate();
-    QTime now = QTime::currentTime();
+    QDateTime current = Clock::currentDateTime();
+    QDate today = current.date();
+    QTime now = current.time();
     QString todayStr = today.toString("yyyy-MM-dd");
-    int dayOfWeek = today.dayOfWeek();
+    ensureDateMaterialized(todayStr);
 
     QSqlQuery query(m_db);
     query.prepare(R"(
-        SELECT cs.id, cs.course_name, cs.teacher, cs.course_type, cs.start_time, cs.end_time,
+        SELECT cs.id, cs.course_name_id, cs.teacher_id, cs.course_type_id, cs.start_time, cs.end_time,
                cs.classroom_id, ci.classroom_name
-        FROM course_schedule cs
+        FROM effective_schedule es
+        JOIN course_schedule cs ON cs.id = es.course_id
         LEFT JOIN classroom_info ci ON cs.classroom_id = ci.id
-        WHERE cs.class_id = ? AND cs.day_of_week = ? AND cs.start_date <= ? AND cs.end_date >= ?
-              AND cs.start_time > ?
-        ORDER BY cs.start_time ASC LIMIT 1
+        WHERE es.date = ? AND es.class_id = ? AND es.start_time > ?
+        ORDER BY es.start_time ASC LIMIT 1
     )");
-    query.addBindValue(classId);
-    query.addBindValue(dayOfWeek);
-    query.addBindValue(todayStr);
     query.addBindValue(todayStr);
+    query.addBindValue(classId);
     query.addBindValue(now.toString("HH:mm"));
 
     if (query.exec() && query.next()) {
         nextCourse["id"] = query.value("id").toInt();
-        nextCourse["course_name"] = query.value("course_name").toString();
-        nextCourse["teacher"] = query.value("teacher").toString();
-        nextCourse["course_type"] = query.value("course_type").toString();
+        nextCourse["course_name"] = m_courseNames.name(m_db, query.value("course_name_id").toInt());
+        nextCourse["teacher"] = m_teachers.name(m_db, query.value("teacher_id").toInt());
+        nextCourse["course_type"] = m_courseTypes.name(m_db, query.value("course_type_id").toInt());
         nextCourse["start_time"] = query.value("start_time").toString();
         nextCourse["end_time"] = query.value("end_time").toString();
+        // 解析一次，界面每秒刷新时直接比较秒数
+        nextCourse["start_secs"] = DayTime::parse(nextCourse["start_time"].toString()).secs;
+        nextCourse["end_secs"] = DayTime::parse(nextCourse["end_time"].toString()).secs;
         nextCourse["classroom_id"] = query.value("classroom_id").toInt();
         nextCourse["classroom_name"] = query.value("classroom_name").toString();
     }
@@ -486,23 +786,333 @@ QVariantMap DatabaseManager::getNextCourse(int classId)
     return nextCourse;
 }
 
+// 指定日期的课表切换时刻（上课开始时刻、下课后一分钟），升序去重
+// 课程在 end_time 当分钟内仍视为进行中，因此下课切换点取 end_time + 1分钟
+QList<QTime> DatabaseManager::getTransitionTimes(const QDate& date)
+{
+    CB_DB_METHOD("getTransitionTimes");
+    QList<QTime> times;
+    QString dateStr = date.toString("yyyy-MM-dd");
+    ensureDateMaterialized(dateStr);
+
+    QSqlQuery query(m_db);
+    query.prepare(R"(
+        SELECT DISTINCT start_time, end_time
+        FROM effective_schedule
+        WHERE date = ?
+    )");
+    query.addBindValue(dateStr);
+
+    if (!query.exec()) {
+        writeLog("ERROR", "课表切换时刻查询失败：" + query.lastError().text(), "DATABASE");
+        return times;
+    }
+
+    while (query.next()) {
+        QTime start = QTime::fromString(query.value(0).toString(), "HH:mm");
+        QTime end = QTime::fromString(query.value(1).toString(), "HH:mm");
+        if (start.isValid()) {
+            times.append(start);
+        }
+        // 23:59 结束的课程下课切换点落到次日零点，由次日首个时刻覆盖
+        if (end.isValid() && end < QTime(23, 59)) {
+            times.append(end.addSecs(60));
+        }
+    }
+
+    std::sort(times.begin(), times.end());
+    times.erase(std::unique(times.begin(), times.end()), times.end());
+    return times;
+}
+
+// -------------------------- 校历与有效课表 --------------------------
+bool DatabaseManager::setCalendarException(const QString& date, CalendarDayKind kind, int asDayOfWeek,
+                                           const QString& description)
+{
+    CB_DB_METHOD("setCalendarException");
+    QString formattedDate = formatDate(date);
+    if (formattedDate.isEmpty()) {
+        writeLog("ERROR", "校历日期格式错误：" + date, "DATABASE");
+        emit operateFailed("日期格式错误（请使用YYYY-MM-DD）");
+        return false;
+    }
+    if (kind == MakeupDay && (asDayOfWeek < 1 || asDayOfWeek > 7)) {
+        writeLog("ERROR", QString("调休星期值错误：%1（必须1-7）").arg(asDayOfWeek), "DATABASE");
+        emit operateFailed("调休星期值错误（必须1-7）");
+        return false;
+    }
+
+    QSqlQuery query(m_db);
+    query.prepare(R"(
+        INSERT OR REPLACE INTO calendar_exceptions (date, kind, as_day_of_week, description)
+        VALUES (?, ?, ?, ?)
+    )");
+    query.addBindValue(formattedDate);
+    query.addBindValue(static_cast<int>(kind));
+    query.addBindValue(kind == MakeupDay ? QVariant(asDayOfWeek) : QVariant(QMetaType::fromType<int>()));
+    query.addBindValue(description);
+
+    if (!query.exec()) {
+        QString errMsg = QString("校历设置失败：%1").arg(query.lastError().text());
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+        return false;
+    }
+
+    if (m_roomIndex.isBuilt()) {
+        m_roomIndex.setDayOverride(TimeHelper::julianDayFromIso(formattedDate), kind == Holiday ? 0 : asDayOfWeek);
+    }
+
+    // 该日期已展开时立即重新展开
+    QSqlQuery check(m_db);
+    check.prepare("SELECT 1 FROM materialized_dates WHERE date = ?");
+    check.addBindValue(formattedDate);
+    if (check.exec() && check.next()) {
+        materializeDate(formattedDate);
+    }
+
+    writeLog("INFO", QString("设置校历成功：%1 %2").arg(formattedDate, kind == Holiday ? "停课" : "调休上课"), "DATABASE");
+    emit operateSuccess("校历设置成功");
+    return true;
+}
+
+bool DatabaseManager::removeCalendarException(const QString& date)
+{
+    CB_DB_METHOD("removeCalendarException");
+    QSqlQuery query(m_db);
+    query.prepare("DELETE FROM calendar_exceptions WHERE date = ?");
+    query.addBindValue(date);
+
+    if (!query.exec()) {
+        QString errMsg = QString("校历删除失败：%1").arg(query.lastError().text());
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+        return false;
+    }
+
+    if (m_roomIndex.isBuilt()) {
+        m_roomIndex.clearDayOverride(TimeHelper::julianDayFromIso(date));
+    }
+
+    QSqlQuery check(m_db);
+    check.prepare("SELECT 1 FROM materialized_dates WHERE date = ?");
+    check.addBindValue(date);
+    if (check.exec() && check.next()) {
+        materializeDate(date);
+    }
+
+    writeLog("INFO", "删除校历成功：" + date, "DATABASE");
+    emit operateSuccess("校历删除成功");
+    return true;
+}
+
+QList<QVariantMap> DatabaseManager::getCalendarExceptions(const QString& fromDate, const QString& toDate)
+{
+    CB_DB_METHOD("getCalendarExceptions");
+    QList<QVariantMap> exceptionList;
+    QSqlQuery query(m_db);
+    query.prepare(R"(
+        SELECT date, kind, as_day_of_week, description FROM calendar_exceptions
+        WHERE date BETWEEN ? AND ?
+        ORDER BY date
+    )");
+    query.addBindValue(fromDate);
+    query.addBindValue(toDate);
+
+    if (query.exec()) {
+        while (query.next()) {
+            QVariantMap exceptionMap;
+            exceptionMap["date"] = query.value("date").toString();
+            exceptionMap["kind"] = query.value("kind").toInt();
+            exceptionMap["as_day_of_week"] = query.value("as_day_of_week").toInt();
+            exceptionMap["description"] = query.value("description").toString();
+            exceptionList.append(exceptionMap);
+        }
+    } else {
+        writeLog("ERROR", "校历查询失败：" + query.lastError().text(), "DATABASE");
+    }
+    return exceptionList;
+}
+
+void DatabaseManager::invalidateEffectiveSchedule()
+{
+    QSqlQuery query(m_db);
+    query.exec("DELETE FROM effective_schedule");
+    query.exec("DELETE FROM materialized_dates");
+    resetCaches();
+}
+
+bool DatabaseManager::ensureDateMaterialized(const QString& date)
+{
+    if (m_materializedDates.contains(date)) {
+        return true;
+    }
+
+    // 其他进程（同步守护进程）可能已展开
+    QSqlQuery query(m_db);
+    query.prepare("SELECT 1 FROM materialized_dates WHERE date = ?");
+    query.addBindValue(date);
+    if (query.exec() && query.next()) {
+        m_materializedDates.insert(date);
+        return true;
+    }
+
+    return materializeDate(date);
+}
+
+// 按校历展开指定日期的有效课表（整日替换）
+bool DatabaseManager::materializeDate(const QString& date)
+{
+    CB_DB_METHOD("materializeDate");
+    if (!QDate::fromString(date, "yyyy-MM-dd").isValid()) {
+        return false;
+    }
+
+    // 已处于外部事务中（如同步落库）时直接并入该事务
+    bool ownTransaction = m_db.transaction();
+
+    QSqlQuery query(m_db);
+    query.prepare("DELETE FROM effective_schedule WHERE date = ?");
+    query.addBindValue(date);
+    bool ok = query.exec();
+
+    if (ok) {
+        query.prepare(QString(R"(
+            INSERT OR IGNORE INTO effective_schedule (date, class_id, start_time, end_time, course_id)
+            SELECT ?, class_id, start_time, end_time, id
+            FROM course_schedule
+            WHERE day_of_week = %1 AND start_date <= ? AND end_date >= ? AND %2
+        )").arg(effectiveDayOfWeekSql("?"), WeekMask::sqlContains("course_schedule", "?")));
+        // 占位符依次为：展开日期、校历查找日期、自然星期计算日期、起止日期比较、教学周计算日期
+        for (int i = 0; i < 6; i++) {
+            query.addBindValue(date);
+        }
+        ok = query.exec();
+    }
+
+    if (ok) {
+        query.prepare("INSERT OR IGNORE INTO materialized_dates (date) VALUES (?)");
+        query.addBindValue(date);
+        ok = query.exec();
+    }
+
+    if (!ok) {
+        writeLog("ERROR", QString("有效课表展开失败（%1）：%2").arg(date, query.lastError().text()), "DATABASE");
+        if (ownTransaction) {
+            m_db.rollback();
+        }
+        return false;
+    }
+
+    if (ownTransaction) {
+        m_db.commit();
+    }
+    m_materializedDates.insert(date);
+    return true;
+}
+
+// -------------------------- 空闲教室 --------------------------
+void DatabaseManager::ensureRoomIndex()
+{
+    if (m_roomIndex.isBuilt()) {
+        return;
+    }
+    CB_DB_METHOD("buildRoomIndex");
+    m_roomIndex.clear();
+
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    if (query.exec("SELECT id, classroom_name FROM classroom_info")) {
+        while (query.next()) {
+            m_roomIndex.setRoom(query.value(0).toInt(), query.value(1).toString());
+        }
+    }
+
+    if (query.exec(R"(
+        SELECT id, classroom_id, day_of_week, start_time, end_time, start_date, end_date, week_mask
+        FROM course_schedule WHERE classroom_id > 0
+    )")) {
+        while (query.next()) {
+            m_roomIndex.insert(makeRoomInterval(query.value(0).toInt(), query.value(1).toInt(), query.value(2).toInt(),
+                                                query.value(3).toString(), query.value(4).toString(),
+                                                query.value(5).toString(), query.value(6).toString(),
+                                                query.value(7).toLongLong()));
+        }
+    } else {
+        writeLog("ERROR", "教室区间索引加载失败：" + query.lastError().text(), "DATABASE");
+        return;
+    }
+
+    if (query.exec("SELECT date, kind, as_day_of_week FROM calendar_exceptions")) {
+        while (query.next()) {
+            int kind = query.value(1).toInt();
+            m_roomIndex.setDayOverride(TimeHelper::julianDayFromIso(query.value(0).toString()),
+                                       kind == Holiday ? 0 : query.value(2).toInt());
+        }
+    }
+
+    m_roomIndex.setBuilt(true);
+}
+
+QList<QVariantMap> DatabaseManager::getFreeClassrooms(const QDate& date, const QTime& time)
+{
+    CB_DB_METHOD("getFreeClassrooms");
+    ensureRoomIndex();
+
+    QList<QVariantMap> roomList;
+    QHash<int, int> freeUntil;
+    const QList<int> rooms = m_roomIndex.freeRooms(date.toJulianDay(), DayTime::fromQTime(time).secs, &freeUntil);
+    for (int classroomId : rooms) {
+        QVariantMap roomMap;
+        roomMap["id"] = classroomId;
+        roomMap["classroom_name"] = m_roomIndex.rooms().value(classroomId);
+        int until = freeUntil.value(classroomId, -1);
+        roomMap["free_until"] = until >= 0 ? QTime::fromMSecsSinceStartOfDay(until * 1000).toString("HH:mm") : QString();
+        roomList.append(roomMap);
+    }
+    return roomList;
+}
+
+QList<QVariantMap> DatabaseManager::getFreeWindows(int classroomId, const QDate& date, const QTime& from, const QTime& to)
+{
+    CB_DB_METHOD("getFreeWindows");
+    ensureRoomIndex();
+
+    QList<QVariantMap> windowList;
+    const auto windows = m_roomIndex.freeWindows(classroomId, date.toJulianDay(),
+                                                 DayTime::fromQTime(from).secs, DayTime::fromQTime(to).secs);
+    for (const auto& window : windows) {
+        QVariantMap windowMap;
+        windowMap["start_time"] = QTime::fromMSecsSinceStartOfDay(window.first * 1000).toString("HH:mm");
+        windowMap["end_time"] = QTime::fromMSecsSinceStartOfDay(window.second * 1000).toString("HH:mm");
+        windowList.append(windowMap);
+    }
+    return windowList;
+}
+
 // -------------------------- 通知管理实现（修复参数不匹配） --------------------------
 bool DatabaseManager::addNotice(const QString& title, const QString& content, const QString& publishTime,
-                               const QString& expireTime, bool isScrolling)
+                               const QString& expireTime, bool isScrolling, int* noticeId, int serverId)
 {
+    CB_DB_METHOD("addNotice");
     QSqlQuery query(m_db);
     query.prepare(R"(
-        INSERT INTO notices (title, content, publish_time, expire_time, is_scrolling, is_valid)
-        VALUES (?, ?, ?, ?, ?, 1)
+        INSERT INTO notices (title, content, publish_time, expire_time, is_scrolling, is_valid, server_id)
+        VALUES (?, ?, ?, ?, ?, 1, ?)
     )");
     query.addBindValue(title);
     query.addBindValue(content);
     query.addBindValue(publishTime);
     query.addBindValue(expireTime);
     query.addBindValue(isScrolling ? 1 : 0);
+    query.addBindValue(serverId > 0 ? QVariant(serverId) : QVariant(QMetaType::fromType<int>()));
 
     if (query.exec()) {
+        if (noticeId) {
+            *noticeId = query.lastInsertId().toInt();
+        }
         writeLog("INFO", "添加通知成功：" + title, "DATABASE");
+        emit noticesChanged();
         emit operateSuccess("通知添加成功");
         return true;
     } else {
@@ -515,12 +1125,14 @@ bool DatabaseManager::addNotice(const QString& title, const QString& content, co
 
 bool DatabaseManager::deleteNotice(int noticeId)
 {
+    CB_DB_METHOD("deleteNotice");
     QSqlQuery query(m_db);
     query.prepare("DELETE FROM notices WHERE id = ?");
     query.addBindValue(noticeId);
 
     if (query.exec()) {
         writeLog("INFO", "删除通知成功，ID：" + QString::number(noticeId), "DATABASE");
+        emit noticesChanged();
         emit operateSuccess("通知删除成功");
         return true;
     } else {
@@ -533,6 +1145,7 @@ bool DatabaseManager::deleteNotice(int noticeId)
 
 bool DatabaseManager::updateNoticeStatus(int noticeId, bool isScrolling, bool isValid)
 {
+    CB_DB_METHOD("updateNoticeStatus");
     QSqlQuery query(m_db);
     query.prepare(R"(
         UPDATE notices SET is_scrolling = ?, is_valid = ? WHERE id = ?
@@ -543,6 +1156,7 @@ bool DatabaseManager::updateNoticeStatus(int noticeId, bool isScrolling, bool is
 
     if (query.exec()) {
         writeLog("INFO", QString("更新通知状态成功，ID：%1").arg(noticeId), "DATABASE");
+        emit noticesChanged();
         emit operateSuccess("通知状态更新成功");
         return true;
     } else {
@@ -554,33 +1168,53 @@ bool DatabaseManager::updateNoticeStatus(int noticeId, bool isScrolling, bool is
 }
 
 QList<QVariantMap> DatabaseManager::getValidNotices(bool isScrolling)
+{
+    CB_DB_METHOD("getValidNotices");
+    QString errMsg;
+    QList<QVariantMap> noticeList = selectValidNotices(m_db, isScrolling, Clock::currentDateTime(), &errMsg);
+    if (!errMsg.isEmpty()) {
+        writeLog("ERROR", errMsg, "DATABASE");
+    }
+    return noticeList;
+}
+
+QList<QVariantMap> DatabaseManager::selectValidNotices(QSqlDatabase& db, bool isScrolling, const QDateTime& current,
+                                                       QString* error)
 {
     QList<QVariantMap> noticeList;
-    QString today = QDate::currentDate().toString("yyyy-MM-dd");
+    QString nowStr = current.toString("yyyy-MM-dd HH:mm:ss");
 
-    QSqlQuery query(m_db);
+    // 过期判断与 NoticeScheduler 一致：精确到秒的过期时刻到达即失效，只有日期的当天仍有效、次日零点失效，
+    // 未设置过期时间的一直有效
+    const QString notExpired = R"(
+        (expire_time IS NULL OR expire_time = ''
+         OR CASE WHEN length(expire_time) = 10 THEN date(expire_time, '+1 day') || ' 00:00:00'
+                 ELSE expire_time END > ?)
+    )";
+
+    QSqlQuery query(db);
     QString sql;
     // 修复参数数量不匹配：统一SQL模板，仅调整筛选条件
     if (isScrolling) {
         sql = R"(
             SELECT id, title, content, publish_time, expire_time
             FROM notices
-            WHERE is_valid = 1 AND is_scrolling = 1
-                  AND (expire_time IS NULL OR expire_time >= ?)
+            WHERE is_valid = 1 AND is_scrolling = 1 AND publish_time <= ? AND %1
             ORDER BY publish_time DESC
         )";
     } else {
         sql = R"(
             SELECT id, title, content, publish_time, expire_time, is_scrolling
             FROM notices
-            WHERE is_valid = 1 AND (expire_time IS NULL OR expire_time >= ?)
+            WHERE is_valid = 1 AND publish_time <= ? AND %1
             ORDER BY publish_time DESC
         )";
     }
 
-    // 预处理+绑定参数（仅1个参数，避免数量不匹配）
-    query.prepare(sql);
-    query.addBindValue(today); // 仅绑定1个参数，适配两种场景
+    // 预处理+绑定参数（两种场景参数一致：未到发布时间、已到过期时刻的通知不显示）
+    query.prepare(sql.arg(notExpired));
+    query.addBindValue(nowStr);
+    query.addBindValue(nowStr);
 
     if (query.exec()) {
         while (query.next()) {
@@ -596,12 +1230,866 @@ QList<QVariantMap> DatabaseManager::getValidNotices(bool isScrolling)
             noticeList.append(noticeMap);
         }
     } else {
-        QString errMsg = "通知查询失败：" + query.lastError().text();
-        writeLog("ERROR", errMsg, "DATABASE");
+        *error = "通知查询失败：" + query.lastError().text();
     }
     return noticeList;
 }
 
+QList<QVariantMap> DatabaseManager::getNoticeSchedule()
+{
+    CB_DB_METHOD("getNoticeSchedule");
+    QList<QVariantMap> schedule;
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+
+    if (!query.exec("SELECT id, publish_time, expire_time FROM notices WHERE is_valid = 1")) {
+        writeLog("ERROR", "通知调度表查询失败：" + query.lastError().text(), "DATABASE");
+        return schedule;
+    }
+
+    while (query.next()) {
+        QVariantMap noticeMap;
+        noticeMap["id"] = query.value(0).toInt();
+        noticeMap["publish_time"] = query.value(1).toString();
+        noticeMap["expire_time"] = query.value(2).toString();
+        schedule.append(noticeMap);
+    }
+    return schedule;
+}
+
+int DatabaseManager::expireNotices(const QList<int>& noticeIds)
+{
+    CB_DB_METHOD("expireNotices");
+    int updated = execNoticeBatch("UPDATE notices SET is_valid = 0 WHERE id = ? AND is_valid = 1",
+                                  noticeIds, QVariantList(), "批量过期");
+    return qMax(0, updated);
+}
+
+int DatabaseManager::deleteNotices(const QList<int>& noticeIds)
+{
+    CB_DB_METHOD("deleteNotices");
+    return execNoticeBatch("DELETE FROM notices WHERE id = ?", noticeIds, QVariantList(), "批量删除");
+}
+
+int DatabaseManager::setNoticesScrolling(const QList<int>& noticeIds, bool isScrolling)
+{
+    CB_DB_METHOD("setNoticesScrolling");
+    return execNoticeBatch("UPDATE notices SET is_scrolling = ? WHERE id = ? AND is_scrolling <> ?",
+                           noticeIds, {isScrolling ? 1 : 0}, isScrolling ? "批量开启滚动" : "批量关闭滚动");
+}
+
+int DatabaseManager::invalidateNotices(const QList<int>& noticeIds)
+{
+    CB_DB_METHOD("invalidateNotices");
+    return execNoticeBatch("UPDATE notices SET is_valid = 0 WHERE id = ? AND is_valid = 1",
+                           noticeIds, QVariantList(), "批量置为无效");
+}
+
+int DatabaseManager::execNoticeBatch(const QString& sql, const QList<int>& noticeIds,
+                                     const QVariantList& extraValues, const QString& action)
+{
+    if (noticeIds.isEmpty()) {
+        return 0;
+    }
+
+    // 已处于外部事务中时直接并入该事务
+    bool ownTransaction = m_db.transaction();
+    QSqlQuery query(m_db);
+    query.prepare(sql);
+
+    int affected = 0;
+    for (int noticeId : noticeIds) {
+        // 占位符顺序：extraValues、id，其后重复 extraValues（用于“值未变化则跳过”的条件）
+        int position = 0;
+        for (const QVariant& value : extraValues) {
+            query.bindValue(position++, value);
+        }
+        query.bindValue(position++, noticeId);
+        for (const QVariant& value : extraValues) {
+            query.bindValue(position++, value);
+        }
+
+        if (!query.exec()) {
+            if (ownTransaction) {
+                m_db.rollback();
+            }
+            QString errMsg = QString("通知%1失败：%2").arg(action, query.lastError().text());
+            writeLog("ERROR", errMsg, "DATABASE");
+            emit operateFailed(errMsg);
+            return -1;
+        }
+        affected += qMax(0, query.numRowsAffected());
+    }
+    if (ownTransaction && !m_db.commit()) {
+        QString errMsg = QString("通知%1提交失败：%2").arg(action, m_db.lastError().text());
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+        return -1;
+    }
+
+    writeLog("INFO", QString("通知%1：%2条").arg(action).arg(affected), "DATABASE");
+    if (affected > 0) {
+        emit noticesChanged();
+    }
+    return affected;
+}
+
+// 通知行 -> map（列顺序：id, title, content, publish_time, expire_time, is_scrolling, is_valid）
+static QVariantMap noticeRowToMap(const QSqlQuery& query)
+{
+    QVariantMap noticeMap;
+    noticeMap["id"] = query.value(0).toInt();
+    noticeMap["title"] = query.value(1).toString();
+    noticeMap["content"] = query.value(2).toString();
+    noticeMap["publish_time"] = query.value(3).toString();
+    noticeMap["expire_time"] = query.value(4).toString();
+    noticeMap["is_scrolling"] = query.value(5).toInt() == 1;
+    noticeMap["is_valid"] = query.value(6).toInt() == 1;
+    return noticeMap;
+}
+
+QList<QVariantMap> DatabaseManager::getNoticePage(NoticeStatusFilter status, const QString& fromDate,
+                                                  const QString& toDate, const QString& afterPublishTime,
+                                                  int afterId, int limit)
+{
+    CB_DB_METHOD("getNoticePage");
+    QList<QVariantMap> page;
+
+    // 条件与参数同步追加，保证占位符顺序一致
+    QStringList conditions;
+    QVariantList binds;
+    switch (status) {
+    case ValidNotices:
+        conditions << "is_valid = 1";
+        break;
+    case InvalidNotices:
+        conditions << "is_valid = 0";
+        break;
+    case ScrollingNotices:
+        conditions << "is_valid = 1" << "is_scrolling = 1";
+        break;
+    default:
+        break;
+    }
+    if (!fromDate.isEmpty()) {
+        conditions << "publish_time >= ?";
+        binds << fromDate;
+    }
+    if (!toDate.isEmpty()) {
+        // 发布时间为 “yyyy-MM-dd HH:mm:ss”，小于次日零点即含当天
+        conditions << "publish_time < ?";
+        binds << QDate::fromString(toDate, "yyyy-MM-dd").addDays(1).toString("yyyy-MM-dd");
+    }
+    if (!afterPublishTime.isEmpty()) {
+        // 行值比较可直接走 (publish_time, id) 索引定位，翻页代价与页码无关
+        conditions << "(publish_time, id) < (?, ?)";
+        binds << afterPublishTime << afterId;
+    }
+
+    QString sql = "SELECT id, title, content, publish_time, expire_time, is_scrolling, is_valid FROM notices";
+    if (!conditions.isEmpty()) {
+        sql += " WHERE " + conditions.join(" AND ");
+    }
+    sql += " ORDER BY publish_time DESC, id DESC LIMIT ?";
+    binds << limit;
+
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    for (const QVariant& value : binds) {
+        query.addBindValue(value);
+    }
+    if (!query.exec()) {
+        writeLog("ERROR", "通知分页查询失败：" + query.lastError().text(), "DATABASE");
+        return page;
+    }
+
+    while (query.next()) {
+        page.append(noticeRowToMap(query));
+    }
+    return page;
+}
+
+QVariantMap DatabaseManager::getNoticeById(int noticeId)
+{
+    CB_DB_METHOD("getNoticeById");
+    QSqlQuery query(m_db);
+    query.prepare(R"(
+        SELECT id, title, content, publish_time, expire_time, is_scrolling, is_valid
+        FROM notices WHERE id = ?
+    )");
+    query.addBindValue(noticeId);
+    if (!query.exec()) {
+        writeLog("ERROR", "通知查询失败：" + query.lastError().text(), "DATABASE");
+        return QVariantMap();
+    }
+    return query.next() ? noticeRowToMap(query) : QVariantMap();
+}
+
+// -------------------------- 通知全文检索 --------------------------
+// 高亮标记（界面为纯文本表格，不使用HTML标签）
+static const char* kHighlightOpen = "【";
+static const char* kHighlightClose = "】";
+// trigram 分词的最短可检索长度
+static const int kTrigramMinLength = 3;
+// 按相关度排序的命中数上限（超过则按发布先后排序）
+static const int kRankWindow = 2000;
+
+bool DatabaseManager::ensureNoticeFts()
+{
+    QSqlQuery query(m_db);
+    bool existed = query.exec("SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'notices_fts'")
+                   && query.next();
+
+    // 外部内容表：索引只存倒排数据，正文仍从 notices 读取；trigram 分词支持中文任意子串检索
+    if (!existed && !query.exec(R"(
+            CREATE VIRTUAL TABLE notices_fts USING fts5(
+                title, content, content='notices', content_rowid='id', tokenize='trigram')
+        )")) {
+        writeLog("WARNING", "通知全文索引不可用，搜索退化为LIKE扫描：" + query.lastError().text(), "DATABASE");
+        return false;
+    }
+
+    // 只在标题/内容变化时更新索引，切换滚动、置无效等状态修改不触发
+    const QStringList triggers = {
+        R"(CREATE TRIGGER IF NOT EXISTS notices_fts_ai AFTER INSERT ON notices BEGIN
+               INSERT INTO notices_fts(rowid, title, content) VALUES (new.id, new.title, new.content);
+           END)",
+        R"(CREATE TRIGGER IF NOT EXISTS notices_fts_ad AFTER DELETE ON notices BEGIN
+               INSERT INTO notices_fts(notices_fts, rowid, title, content)
+               VALUES ('delete', old.id, old.title, old.content);
+           END)",
+        R"(CREATE TRIGGER IF NOT EXISTS notices_fts_au AFTER UPDATE OF title, content ON notices BEGIN
+               INSERT INTO notices_fts(notices_fts, rowid, title, content)
+               VALUES ('delete', old.id, old.title, old.content);
+               INSERT INTO notices_fts(rowid, title, content) VALUES (new.id, new.title, new.content);
+           END)"
+    };
+    for (const QString& trigger : triggers) {
+        if (!query.exec(trigger)) {
+            writeLog("WARNING", "通知全文索引触发器创建失败：" + query.lastError().text(), "DATABASE");
+            return false;
+        }
+    }
+
+    // 新建索引时从现有通知全量构建
+    if (!existed && !query.exec("INSERT INTO notices_fts(notices_fts) VALUES ('rebuild')")) {
+        writeLog("WARNING", "通知全文索引构建失败：" + query.lastError().text(), "DATABASE");
+        return false;
+    }
+    return true;
+}
+
+QList<QVariantMap> DatabaseManager::searchNotices(const QString& keyword, int limit, int offset)
+{
+    CB_DB_METHOD("searchNotices");
+    QList<QVariantMap> results;
+    QStringList terms = keyword.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+    if (terms.isEmpty()) {
+        return results;
+    }
+
+    // 每个词作为短语（双引号转义），多个词之间为AND；任一词过短则 trigram 无法命中
+    QStringList phrases;
+    bool ftsUsable = m_noticeFtsReady;
+    for (const QString& term : terms) {
+        if (term.size() < kTrigramMinLength) {
+            ftsUsable = false;
+        }
+        phrases << "\"" + QString(term).replace("\"", "\"\"") + "\"";
+    }
+    if (!ftsUsable) {
+        return searchNoticesByLike(keyword, limit, offset);
+    }
+
+    const QString matchExpr = phrases.join(" ");
+
+    // bm25 需统计短语在全表的命中数，命中数十万条时单次排序即达百毫秒级；
+    // 命中超过排序窗口的宽泛关键词改按发布先后（rowid 倒序）列出，只读取当前页
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT rowid FROM notices_fts WHERE notices_fts MATCH ? ORDER BY rowid DESC LIMIT 1 OFFSET ?");
+    query.addBindValue(matchExpr);
+    query.addBindValue(kRankWindow);
+    bool broad = query.exec() && query.next();
+
+    query.prepare(QString(R"(
+        SELECT n.id, n.title, n.content, n.publish_time, n.expire_time, n.is_scrolling, n.is_valid,
+               highlight(notices_fts, 0, '%1', '%2') AS title_highlight,
+               snippet(notices_fts, 1, '%1', '%2', '…', 24) AS snippet
+        FROM notices_fts
+        JOIN notices n ON n.id = notices_fts.rowid
+        WHERE notices_fts MATCH ?
+        ORDER BY %3
+        LIMIT ? OFFSET ?
+    )").arg(kHighlightOpen, kHighlightClose,
+            broad ? "notices_fts.rowid DESC" : "bm25(notices_fts, 5.0, 1.0)"));
+    query.addBindValue(matchExpr);
+    query.addBindValue(limit);
+    query.addBindValue(offset);
+
+    if (!query.exec()) {
+        writeLog("ERROR", "通知全文检索失败：" + query.lastError().text(), "DATABASE");
+        return results;
+    }
+    while (query.next()) {
+        QVariantMap noticeMap = noticeRowToMap(query);
+        noticeMap["title_highlight"] = query.value(7).toString();
+        noticeMap["snippet"] = query.value(8).toString();
+        results.append(noticeMap);
+    }
+    return results;
+}
+
+// 在 text 中标出 term 的首次出现，并截取其附近 radius 个字符
+static QString highlightFirst(const QString& text, const QString& term, int radius)
+{
+    int pos = text.indexOf(term, 0, Qt::CaseInsensitive);
+    if (pos < 0) {
+        return radius > 0 ? text.left(radius * 2) : text;
+    }
+    int from = radius > 0 ? qMax(0, pos - radius) : 0;
+    int to = radius > 0 ? qMin(text.size(), pos + term.size() + radius) : text.size();
+    QString result = text.mid(from, pos - from) + kHighlightOpen + text.mid(pos, term.size()) + kHighlightClose
+                     + text.mid(pos + term.size(), to - pos - term.size());
+    if (from > 0) result.prepend("…");
+    if (to < text.size()) result.append("…");
+    return result;
+}
+
+QList<QVariantMap> DatabaseManager::searchNoticesByLike(const QString& keyword, int limit, int offset)
+{
+    QList<QVariantMap> results;
+    QStringList terms = keyword.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
+
+    // 每个词需出现在标题或内容中；转义LIKE通配符
+    QStringList conditions;
+    QVariantList binds;
+    for (QString term : terms) {
+        term.replace("\\", "\\\\").replace("%", "\\%").replace("_", "\\_");
+        conditions << "(title LIKE ? ESCAPE '\\' OR content LIKE ? ESCAPE '\\')";
+        binds << "%" + term + "%" << "%" + term + "%";
+    }
+
+    QSqlQuery query(m_db);
+    query.setForwardOnly(true);
+    query.prepare("SELECT id, title, content, publish_time, expire_time, is_scrolling, is_valid FROM notices WHERE "
+                  + conditions.join(" AND ") + " ORDER BY publish_time DESC, id DESC LIMIT ? OFFSET ?");
+    for (const QVariant& value : binds) {
+        query.addBindValue(value);
+    }
+    query.addBindValue(limit);
+    query.addBindValue(offset);
+
+    if (!query.exec()) {
+        writeLog("ERROR", "通知检索失败：" + query.lastError().text(), "DATABASE");
+        return results;
+    }
+    while (query.next()) {
+        QVariantMap noticeMap = noticeRowToMap(query);
+        noticeMap["title_highlight"] = highlightFirst(noticeMap["title"].toString(), terms.first(), 0);
+        noticeMap["snippet"] = highlightFirst(noticeMap["content"].toString(), terms.first(), 24);
+        results.append(noticeMap);
+    }
+    return results;
+}
+
+// -------------------------- 数据保留（归档与空间回收） --------------------------
+QList<int> DatabaseManager::archiveBatch(const QString& selectSql, const QString& copySql, const QStringList& deleteSqls,
+                                         const QString& beforeDate, int batchSize, bool* ok)
+{
+    QList<int> ids;
+    *ok = false;
+
+    // 每批一个短事务，批与批之间释放写锁，同步写入与界面查询不会被长时间阻塞
+    bool ownTransaction = m_db.transaction();
+    QSqlQuery query(m_db);
+    query.prepare(selectSql);
+    query.addBindValue(beforeDate);
+    query.addBindValue(batchSize);
+    if (query.exec()) {
+        while (query.next()) {
+            ids.append(query.value(0).toInt());
+        }
+    }
+
+    QString error = query.lastError().text();
+    bool success = !query.lastError().isValid();
+    if (success && !ids.isEmpty()) {
+        QVariantList idValues;
+        QVariantList archivedAt;
+        const QString now = Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss");
+        for (int id : ids) {
+            idValues << id;
+            archivedAt << now;
+        }
+
+        QSqlQuery copy(m_db);
+        copy.prepare(copySql);
+        copy.addBindValue(archivedAt);
+        copy.addBindValue(idValues);
+        success = copy.execBatch();
+        if (!success) {
+            error = copy.lastError().text();
+        }
+
+        // 删除语句与复制在同一事务内，任一失败整批回滚
+        for (int i = 0; success && i < deleteSqls.size(); i++) {
+            QSqlQuery remove(m_db);
+            remove.prepare(deleteSqls[i]);
+            remove.addBindValue(idValues);
+            success = remove.execBatch();
+            if (!success) {
+                error = remove.lastError().text();
+            }
+        }
+    }
+
+    if (!success) {
+        if (ownTransaction) {
+            m_db.rollback();
+        }
+        QString errMsg = "数据归档失败：" + error;
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+        return QList<int>();
+    }
+    if (ownTransaction) {
+        m_db.commit();
+    }
+    *ok = true;
+    return ids;
+}
+
+int DatabaseManager::archiveExpiredNotices(const QString& beforeDate, int batchSize)
+{
+    CB_DB_METHOD("archiveExpiredNotices");
+    bool ok = false;
+    // is_valid IN (0, 1) 使查询可走 idx_notices_valid(is_valid, expire_time) 的范围扫描
+    QList<int> ids = archiveBatch(
+        "SELECT id FROM notices WHERE is_valid IN (0, 1) AND expire_time <> '' AND expire_time < ? LIMIT ?",
+        R"(INSERT OR REPLACE INTO notices_archive
+               (id, title, content, publish_time, expire_time, is_scrolling, is_valid, server_id, archived_at)
+           SELECT id, title, content, publish_time, expire_time, is_scrolling, is_valid, server_id, ?
+           FROM notices WHERE id = ?)",
+        {"DELETE FROM notices WHERE id = ?"},
+        beforeDate, batchSize, &ok);
+    if (!ok) {
+        return -1;
+    }
+
+    if (!ids.isEmpty()) {
+        writeLog("INFO", QString("归档过期通知：%1条").arg(ids.size()), "DATABASE");
+        emit noticesChanged();
+    }
+    return ids.size();
+}
+
+int DatabaseManager::archiveEndedCourses(const QString& beforeDate, int batchSize)
+{
+    CB_DB_METHOD("archiveEndedCourses");
+    bool ok = false;
+    QList<int> ids = archiveBatch(
+        "SELECT id FROM course_schedule WHERE end_date < ? LIMIT ?",
+        R"(INSERT OR REPLACE INTO course_schedule_archive
+               (id, class_id, course_name_id, teacher_id, course_type_id, start_time, end_time, day_of_week,
+                start_date, end_date, classroom_id, week_mask, server_id, archived_at)
+           SELECT id, class_id, course_name_id, teacher_id, course_type_id, start_time, end_time, day_of_week,
+                  start_date, end_date, classroom_id, week_mask, server_id, ?
+           FROM course_schedule WHERE id = ?)",
+        // 已结课课程只出现在已过去的展开日期中，与 deleteCourse 一致同步清理（同一事务）
+        {"DELETE FROM effective_schedule WHERE course_id = ?", "DELETE FROM course_schedule WHERE id = ?"},
+        beforeDate, batchSize, &ok);
+    if (!ok) {
+        return -1;
+    }
+
+    if (!ids.isEmpty()) {
+        for (int courseId : ids) {
+            m_roomIndex.remove(courseId);
+        }
+        writeLog("INFO", QString("归档已结课课程：%1条").arg(ids.size()), "DATABASE");
+    }
+    return ids.size();
+}
+
+int DatabaseManager::incrementalVacuum(int maxPages)
+{
+    CB_DB_METHOD("incrementalVacuum");
+    QSqlQuery query(m_db);
+    // 每读一行回收一页，需读完结果才会真正执行
+    if (!query.exec(QString("PRAGMA incremental_vacuum(%1)").arg(qMax(1, maxPages)))) {
+        writeLog("ERROR", "增量回收失败：" + query.lastError().text(), "DATABASE");
+        return -1;
+    }
+    while (query.next()) {
+    }
+    query.finish();
+
+    if (query.exec("PRAGMA freelist_count") && query.next()) {
+        return query.value(0).toInt();
+    }
+    return -1;
+}
+
+bool DatabaseManager::isIncrementalVacuumEnabled()
+{
+    QSqlQuery query(m_db);
+    return query.exec("PRAGMA auto_vacuum") && query.next() && query.value(0).toInt() == 2;
+}
+
+// -------------------------- 在线备份 --------------------------
+bool DatabaseManager::backupAsync(const QString& filePath)
+{
+    CB_DB_METHOD("backupAsync");
+    if (isBackupRunning()) {
+        emit operateFailed("已有备份正在进行");
+        return false;
+    }
+    if (QFileInfo(filePath).absoluteFilePath() == QFileInfo(m_dbPath).absoluteFilePath()) {
+        emit operateFailed("备份文件不能与当前数据库相同");
+        return false;
+    }
+
+    if (!m_backupWatcher) {
+        m_backupWatcher = new QFutureWatcher<DatabaseBackup::Result>(this);
+        connect(m_backupWatcher, &QFutureWatcher<DatabaseBackup::Result>::finished, this, [this]() {
+            const DatabaseBackup::Result result = m_backupWatcher->result();
+            if (result.ok) {
+                MetricsRegistry::instance().observe("classboard_backup_seconds", result.elapsedSeconds,
+                                                    QString("method=\"%1\"").arg(result.method));
+                MetricsRegistry::instance().observe("classboard_backup_bytes", result.bytes);
+                QString message = QString("快照%1KB，耗时%2秒（%3，%4步，重新开始%5次）")
+                                      .arg(result.bytes / 1024).arg(result.elapsedSeconds, 0, 'f', 2)
+                                      .arg(result.method).arg(result.steps).arg(result.restarts);
+                writeLog("INFO", "数据库备份完成：" + m_backupTarget + "，" + message, "DATABASE");
+                emit backupFinished(true, m_backupTarget, message);
+            } else {
+                writeLog("ERROR", "数据库备份失败：" + result.error, "DATABASE");
+                emit backupFinished(false, m_backupTarget, result.error);
+            }
+        });
+    }
+
+    // 工作线程不能使用主连接，按相同路径另开连接
+    m_backupTarget = filePath;
+    const QString sourcePath = m_dbPath;
+    m_backupWatcher->setFuture(QtConcurrent::run([sourcePath, filePath]() {
+        return DatabaseBackup::run(sourcePath, filePath);
+    }));
+    writeLog("INFO", "开始在线备份数据库：" + filePath, "DATABASE");
+    return true;
+}
+
+// -------------------------- 同步版本与快照开通 --------------------------
+qint64 DatabaseManager::getSyncRevision()
+{
+    CB_DB_METHOD("getSyncRevision");
+    QSqlQuery query(m_db);
+    query.prepare("SELECT value FROM sync_state WHERE key = 'revision'");
+    if (query.exec() && query.next()) {
+        return query.value(0).toLongLong();
+    }
+    return 0;
+}
+
+bool DatabaseManager::setSyncRevision(qint64 revision)
+{
+    CB_DB_METHOD("setSyncRevision");
+    QSqlQuery query(m_db);
+    query.prepare("INSERT OR REPLACE INTO sync_state (key, value) VALUES ('revision', ?)");
+    query.addBindValue(QString::number(revision));
+    if (!query.exec()) {
+        QString errMsg = "记录同步版本失败：" + query.lastError().text();
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseManager::validateSnapshot(const QString& snapshotPath, qint64* revision, QString* error)
+{
+    const QString connName = "classboard_snapshot_check";
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+        db.setDatabaseName(snapshotPath);
+        db.setConnectOptions("QSQLITE_OPEN_READONLY");
+        if (!db.open()) {
+            *error = "快照无法打开：" + db.lastError().text();
+        } else {
+            QSqlQuery query(db);
+            int version = -1;
+            if (query.exec("PRAGMA user_version") && query.next()) {
+                version = query.value(0).toInt();
+            }
+
+            QSet<QString> tables;
+            if (query.exec("SELECT name FROM sqlite_master WHERE type = 'table'")) {
+                while (query.next()) {
+                    tables.insert(query.value(0).toString());
+                }
+            }
+
+            if (!query.exec("PRAGMA quick_check") || !query.next() || query.value(0).toString() != "ok") {
+                *error = "快照完整性检查未通过：" + (query.isActive() ? query.value(0).toString() : query.lastError().text());
+            } else if (version != kSchemaVersion) {
+                *error = QString("快照结构版本%1与当前版本%2不一致").arg(version).arg(kSchemaVersion);
+            } else {
+                for (const char* table : kSnapshotRequiredTables) {
+                    if (!tables.contains(QString::fromLatin1(table))) {
+                        *error = QString("快照缺少数据表：%1").arg(table);
+                        break;
+                    }
+                }
+            }
+
+            if (error->isEmpty()) {
+                query.prepare("SELECT value FROM sync_state WHERE key = 'revision'");
+                *revision = query.exec() && query.next() ? query.value(0).toLongLong() : 0;
+            }
+            query.finish();
+            db.close();
+        }
+    }
+    QSqlDatabase::removeDatabase(connName);
+    return error->isEmpty();
+}
+
+bool DatabaseManager::replaceWithSnapshot(const QString& snapshotPath, qint64 revision)
+{
+    CB_DB_METHOD("replaceWithSnapshot");
+    QString error;
+    qint64 snapshotRevision = 0;
+    if (isBackupRunning()) {
+        error = "在线备份进行中，暂不能替换数据库";
+    } else {
+        validateSnapshot(snapshotPath, &snapshotRevision, &error);
+    }
+    if (!error.isEmpty()) {
+        writeLog("ERROR", "数据库快照不可用：" + error, "DATABASE");
+        emit operateFailed("数据库快照不可用：" + error);
+        return false;
+    }
+
+    // 其他进程（daemon 模式的展示进程）与本进程异步查询线程池的连接须先关闭，
+    // 否则它们继续读写旧库的 -wal/-shm（文件名不变，会被新库沿用），写入会损坏新库
+    if (m_replaceGuard && !m_replaceGuard()) {
+        error = "其他进程未能及时关闭数据库连接，暂不能替换数据库";
+        writeLog("ERROR", "数据库快照不可用：" + error, "DATABASE");
+        emit operateFailed("数据库快照不可用：" + error);
+        return false;
+    }
+    emit aboutToReplaceDatabase();
+
+    // 不删除 -wal/-shm（其他进程可能仍打开着它们）：把 WAL 全部写回并截断为空，替换后新库不会回放旧库的日志
+    QSqlQuery checkpoint(m_db);
+    if (!checkpoint.exec("PRAGMA wal_checkpoint(TRUNCATE)")) {
+        error = "检查点失败：" + checkpoint.lastError().text();
+    } else if (checkpoint.next() && checkpoint.value(0).toInt() != 0) {
+        error = "检查点被其他连接阻塞，暂不能替换数据库";
+    }
+    checkpoint.finish();
+    if (!error.isEmpty()) {
+        writeLog("ERROR", "数据库快照不可用：" + error, "DATABASE");
+        emit operateFailed("数据库快照不可用：" + error);
+        emit replaceAborted();
+        return false;
+    }
+
+    m_db.close();
+    if (!FileHelper::replaceFileAtomically(snapshotPath, m_dbPath)) {
+        error = "替换数据库文件失败：" + m_dbPath;
+    }
+
+    // 替换失败时重新连接的仍是旧库
+    if (!reconnect()) {
+        emit replaceAborted();
+        return false;
+    }
+
+    if (!error.isEmpty()) {
+        writeLog("ERROR", error, "DATABASE");
+        emit operateFailed(error);
+        emit replaceAborted();
+        return false;
+    }
+
+    const qint64 appliedRevision = revision > 0 ? revision : snapshotRevision;
+    if (appliedRevision > 0) {
+        setSyncRevision(appliedRevision);
+    }
+    writeLog("INFO", QString("已由快照替换数据库，数据版本%1").arg(appliedRevision), "DATABASE");
+    emit noticesChanged();
+    emit databaseReplaced();
+    return true;
+}
+
+void DatabaseManager::release()
+{
+    emit aboutToReplaceDatabase();
+    m_db.close();
+    writeLog("INFO", "数据库文件即将被替换，已关闭连接：" + m_dbPath, "DATABASE");
+}
+
+bool DatabaseManager::reopen()
+{
+    CB_DB_METHOD("reopen");
+    if (m_db.isOpen()) {
+        emit aboutToReplaceDatabase();
+        m_db.close();
+    }
+    if (!reconnect()) {
+        return false;
+    }
+
+    writeLog("INFO", "数据库文件已被替换，已重新连接：" + m_dbPath, "DATABASE");
+    emit noticesChanged();
+    emit databaseReplaced();
+    return true;
+}
+
+bool DatabaseManager::reconnect()
+{
+    if (!m_db.open()) {
+        QString errMsg = "数据库替换后重新连接失败：" + m_db.lastError().text();
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+        return false;
+    }
+
+    SqlitePragmaProfile::current().apply(m_db, false);
+
+    // 内存缓存均对应旧库；新库中已展开的有效课表与其课程一致，保留
+    resetCaches();
+    m_noticeFtsReady = ensureNoticeFts();
+    return true;
+}
+
+void DatabaseManager::resetCaches()
+{
+    m_materializedDates.clear();
+    m_roomIndex.clear();
+    m_courseNames.clear();
+    m_teachers.clear();
+    m_courseTypes.clear();
+}
+
+// -------------------------- 同步落库 --------------------------
+int DatabaseManager::courseIdByServerId(int serverId)
+{
+    QSqlQuery query(m_db);
+    query.prepare("SELECT id FROM course_schedule WHERE server_id = ?");
+    query.addBindValue(serverId);
+    if (!query.exec()) {
+        writeLog("ERROR", "按服务器ID查询课程失败：" + query.lastError().text(), "DATABASE");
+        return -1;
+    }
+    return query.next() ? query.value(0).toInt() : 0;
+}
+
+bool DatabaseManager::upsertCourse(int serverId, int classId, const QString& courseName, const QString& teacher,
+                                   const QString& courseType, const QString& startTime, const QString& endTime,
+                                   int dayOfWeek, const QString& startDate, const QString& endDate, int classroomId,
+                                   qint64 weekMask)
+{
+    CB_DB_METHOD("upsertCourse");
+    // 先删后增：有效课表与教室区间索引由 deleteCourse/addCourse 增量维护
+    const int courseId = courseIdByServerId(serverId);
+    if (courseId < 0 || (courseId > 0 && !deleteCourse(courseId))) {
+        return false;
+    }
+    return addCourse(classId, courseName, teacher, courseType, startTime, endTime, dayOfWeek,
+                     startDate, endDate, classroomId, weekMask, serverId);
+}
+
+bool DatabaseManager::removeCourseByServerId(int serverId)
+{
+    CB_DB_METHOD("removeCourseByServerId");
+    const int courseId = courseIdByServerId(serverId);
+    return courseId == 0 || (courseId > 0 && deleteCourse(courseId));
+}
+
+bool DatabaseManager::upsertNotice(int serverId, const QString& title, const QString& content,
+                                   const QString& publishTime, const QString& expireTime, bool isScrolling)
+{
+    CB_DB_METHOD("upsertNotice");
+    // 原地更新保留本地ID（定时调度与轮播按ID引用），服务器重新下发的通知恢复为有效
+    QSqlQuery query(m_db);
+    query.prepare(R"(
+        UPDATE notices SET title = ?, content = ?, publish_time = ?, expire_time = ?, is_scrolling = ?, is_valid = 1
+        WHERE server_id = ?
+    )");
+    query.addBindValue(title);
+    query.addBindValue(content);
+    query.addBindValue(publishTime);
+    query.addBindValue(expireTime);
+    query.addBindValue(isScrolling ? 1 : 0);
+    query.addBindValue(serverId);
+    if (!query.exec()) {
+        QString errMsg = QString("通知更新失败：%1").arg(query.lastError().text());
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+        return false;
+    }
+
+    if (query.numRowsAffected() == 0) {
+        return addNotice(title, content, publishTime, expireTime, isScrolling, nullptr, serverId);
+    }
+    emit noticesChanged();
+    return true;
+}
+
+bool DatabaseManager::removeNoticeByServerId(int serverId)
+{
+    CB_DB_METHOD("removeNoticeByServerId");
+    QSqlQuery query(m_db);
+    query.prepare("DELETE FROM notices WHERE server_id = ?");
+    query.addBindValue(serverId);
+    if (!query.exec()) {
+        QString errMsg = QString("通知删除失败：%1").arg(query.lastError().text());
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+        return false;
+    }
+
+    if (query.numRowsAffected() > 0) {
+        emit noticesChanged();
+    }
+    return true;
+}
+
+bool DatabaseManager::beginSyncApply()
+{
+    if (!m_db.transaction()) {
+        QString errMsg = "同步事务开启失败：" + m_db.lastError().text();
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+        return false;
+    }
+    return true;
+}
+
+bool DatabaseManager::commitSyncApply()
+{
+    if (!m_db.commit()) {
+        QString errMsg = "同步事务提交失败：" + m_db.lastError().text();
+        writeLog("ERROR", errMsg, "DATABASE");
+        emit operateFailed(errMsg);
+        rollbackSyncApply();
+        return false;
+    }
+    return true;
+}
+
+void DatabaseManager::rollbackSyncApply()
+{
+    m_db.rollback();
+    // 事务内新增的字典项、已展开日期与区间索引变更均已撤销
+    resetCaches();
+    emit noticesChanged();
+}
+
 // -------------------------- 辅助函数 --------------------------
 bool DatabaseManager::isDateInRange(const QString& checkDate, const QString& startDate, const QString& endDate)
 {
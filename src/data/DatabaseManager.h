@@ -15,7 +15,15 @@
 #include <QTextStream>
 #include <QDateTime>
 #include <QThread>
+#include <QSet>
+#include <QStringList>
 #include "utility/LogHelper.h" // 包含公共日志头文件
+#include "data/RoomIntervalIndex.h"
+#include "data/StringDictionary.h"
+#include "data/DatabaseBackup.h"
+#include "data/SqlitePragmas.h"
+#include <QFutureWatcher>
+#include <functional>
 
 // 单例模式：数据库管理类（Qt 6.9.2适配）
 class DatabaseManager : public QObject
@@ -32,6 +40,9 @@ public:
     // 获取数据库连接
     QSqlDatabase getDb() const { return m_db; }
 
+    // 设置连接参数（PRAGMA 配置）：立即作用于主连接，此后新开的工作线程连接同样使用；init 前调用则在打开时生效
+    void setPragmaProfile(const SqlitePragmaProfile& profile);
+
     // -------------------------- 班级管理（仅保留查询/搜索） --------------------------
     QList<QVariantMap> getAllClasses();
     QList<QVariantMap> searchClasses(const QString& keyword);
@@ -41,26 +52,150 @@ public:
     QList<QVariantMap> getAllClassrooms();                    // 获取所有教室
     QString getClassroomNameById(int classroomId);            // 根据ID获取教室名称
 
+    // -------------------------- 教师管理 --------------------------
+    QList<QVariantMap> getAllTeachers();                      // 所有教师（id、teacher_name）
+    int getOrCreateTeacherId(const QString& teacherName);     // 教师名称 -> ID（不存在则创建，失败返回0）
+
     // -------------------------- 课表管理 --------------------------
     // 修改：classroom 改为 classroomId（int类型，关联教室表主键）
     bool addCourse(int classId, const QString& courseName, const QString& teacher, const QString& courseType,
                    const QString& startTime, const QString& endTime, int dayOfWeek,
-                   const QString& startDate, const QString& endDate, int classroomId = 0);
+                   const QString& startDate, const QString& endDate, int classroomId = 0,
+                   qint64 weekMask = -1, int serverId = 0);  // weekMask：上课周位图（见 WeekMask），-1=每周；serverId：服务器端ID（0=本地添加）
     bool deleteCourse(int courseId);
     QList<QVariantMap> getCoursesByClassId(int classId);
+    QList<QVariantMap> getCoursesByTeacher(int teacherId);   // 教师本周课表（含班级名称）
     QVariantMap getCurrentCourse(int classId);
     QVariantMap getNextCourse(int classId);
+    QList<QTime> getTransitionTimes(const QDate& date);      // 指定日期的课表切换时刻（全部班级）
+
+    // -------------------------- 校历（节假日/调休） --------------------------
+    // 例外类型：停课（节假日）、调休上课（按 asDayOfWeek 的课表上课）
+    enum CalendarDayKind { Holiday = 0, MakeupDay = 1 };
+    bool setCalendarException(const QString& date, CalendarDayKind kind, int asDayOfWeek = 0,
+                              const QString& description = "");
+    bool removeCalendarException(const QString& date);
+    QList<QVariantMap> getCalendarExceptions(const QString& fromDate, const QString& toDate);
+
+    // 清空按日期展开的有效课表与内存字典缓存（绕过 addCourse/deleteCourse 直接改写课表后调用，之后按需重新展开）
+    void invalidateEffectiveSchedule();
+
+    // -------------------------- 空闲教室（内存区间索引） --------------------------
+    // 指定日期、时刻空闲的教室：id、classroom_name、free_until（当天下一节课开始时间，空表示之后全天空闲）
+    QList<QVariantMap> getFreeClassrooms(const QDate& date, const QTime& time);
+    // 教室在指定日期 [from, to) 内的空闲时段：start_time、end_time（HH:mm）
+    QList<QVariantMap> getFreeWindows(int classroomId, const QDate& date,
+                                      const QTime& from = QTime(7, 0), const QTime& to = QTime(22, 0));
+    // 丢弃区间索引（其他进程改写课表后调用，下次查询时重建）
+    void invalidateRoomIndex() { m_roomIndex.clear(); }
 
     // -------------------------- 通知管理 --------------------------
+    // noticeId 非空时写回新通知的ID；serverId 为服务器端ID（0=本地添加）
     bool addNotice(const QString& title, const QString& content, const QString& publishTime,
-                   const QString& expireTime = "", bool isScrolling = false);
+                   const QString& expireTime = "", bool isScrolling = false, int* noticeId = nullptr,
+                   int serverId = 0);
     bool deleteNotice(int noticeId);
     bool updateNoticeStatus(int noticeId, bool isScrolling, bool isValid);
     QList<QVariantMap> getValidNotices(bool isScrolling = false);
+    // 有效通知的发布/过期时刻：id、publish_time、expire_time（供定时调度）
+    QList<QVariantMap> getNoticeSchedule();
+    // 到期批量置为无效（一个事务，供定时调度），返回更新条数
+    int expireNotices(const QList<int>& noticeIds);
+    // 批量操作（通知管理多选，各自一个事务），返回实际影响的条数，失败返回-1
+    int deleteNotices(const QList<int>& noticeIds);
+    int setNoticesScrolling(const QList<int>& noticeIds, bool isScrolling);
+    int invalidateNotices(const QList<int>& noticeIds);
+
+    // 通知分页（按 (publish_time, id) 倒序的键集分页，供通知管理界面按需加载）
+    // 状态筛选：全部、有效、已失效、滚动中（有效且滚动）
+    enum NoticeStatusFilter { AllNotices = 0, ValidNotices, InvalidNotices, ScrollingNotices };
+    // 返回排在 (afterPublishTime, afterId) 之后的至多 limit 条；afterPublishTime 为空表示第一页
+    // fromDate/toDate（yyyy-MM-dd，可为空）按发布日期筛选，含两端
+    QList<QVariantMap> getNoticePage(NoticeStatusFilter status, const QString& fromDate, const QString& toDate,
+                                     const QString& afterPublishTime, int afterId, int limit);
+    // 单条通知（不存在时返回空map）
+    QVariantMap getNoticeById(int noticeId);
+
+    // 通知全文检索（FTS5 trigram 索引，按 bm25 相关度排序，标题权重高于内容；命中过多时按发布先后排序）
+    // 返回 getNoticePage 的字段外加 title_highlight、snippet（命中处以【】标出）
+    // 关键词不足3个字或 FTS5 不可用时退化为 LIKE 扫描，按发布时间倒序
+    QList<QVariantMap> searchNotices(const QString& keyword, int limit, int offset = 0);
+
+    // -------------------------- 按连接的查询实现 --------------------------
+    // 不使用主连接与成员状态，供主连接和 AsyncDatabase 的工作线程连接共用；失败时写入 error（不记日志）
+    // 课程名称、教师、课程类型按调用方所在线程的字典解码
+    static QList<QVariantMap> selectAllClasses(QSqlDatabase& db, QString* error);
+    static QList<QVariantMap> selectCoursesByClassId(QSqlDatabase& db, int classId, const QString& today,
+                                                     StringDictionary& courseNames, StringDictionary& teachers,
+                                                     StringDictionary& courseTypes, QString* error);
+    static QList<QVariantMap> selectAllTeachers(QSqlDatabase& db, QString* error);
+    static QList<QVariantMap> selectCoursesByTeacher(QSqlDatabase& db, int teacherId, const QString& today,
+                                                     StringDictionary& courseNames, StringDictionary& teachers,
+                                                     StringDictionary& courseTypes, QString* error);
+    static QList<QVariantMap> selectValidNotices(QSqlDatabase& db, bool isScrolling, const QDateTime& current,
+                                                 QString* error);
 
 signals:
     void operateSuccess(const QString& msg);
     void operateFailed(const QString& msg);
+    // 通知数据发生变化（增删、状态修改）
+    void noticesChanged();
+    // 在线备份完成（message 为失败原因或快照大小、耗时说明）
+    void backupFinished(bool success, const QString& filePath, const QString& message);
+    // 即将关闭主连接并替换数据库文件：其他连接（异步查询线程池）须在此时关闭（直接连接，同步处理）
+    void aboutToReplaceDatabase();
+    // 数据库文件已整体替换（快照开通），界面应重新加载全部数据
+    void databaseReplaced();
+    // 替换前检查已通过（其他进程已关闭连接）但替换失败，仍使用原数据库文件
+    void replaceAborted();
+
+public:
+    // -------------------------- 数据保留（归档与空间回收） --------------------------
+    // 把过期日期早于 beforeDate 的通知 / 结束日期早于 beforeDate 的课程移入归档表
+    // 每次至多 batchSize 条（一个短事务），返回移动条数，失败返回-1；反复调用直到返回值小于 batchSize
+    int archiveExpiredNotices(const QString& beforeDate, int batchSize);
+    int archiveEndedCourses(const QString& beforeDate, int batchSize);
+    // 回收至多 maxPages 个空闲页（auto_vacuum=INCREMENTAL），返回剩余空闲页数，失败返回-1
+    int incrementalVacuum(int maxPages);
+    // 是否为增量回收模式（auto_vacuum=INCREMENTAL；快照开通的库沿用服务器建库时的模式，可能不是）
+    bool isIncrementalVacuumEnabled();
+
+    // -------------------------- 在线备份 --------------------------
+    // 在线程池中把当前数据库的一致性快照写入 filePath（不阻塞读写），完成后发出 backupFinished
+    // 已有备份在运行时返回false
+    bool backupAsync(const QString& filePath);
+    bool isBackupRunning() const { return m_backupWatcher && m_backupWatcher->isRunning(); }
+
+    // -------------------------- 同步版本与快照开通 --------------------------
+    // 已应用的服务器数据版本（0 表示从未同步，需全量同步或快照开通）
+    qint64 getSyncRevision();
+    bool setSyncRevision(qint64 revision);
+    // 用预制快照整体替换当前数据库：校验完整性与结构版本，经替换前检查（其他进程关闭连接）、
+    // 关闭异步查询连接并把 WAL 检查点截断后，关闭主连接、原子替换文件并重新连接
+    // revision 为快照对应的数据版本（<=0 时取快照内 sync_state 记录的版本）；须在 DatabaseManager 所在线程调用
+    bool replaceWithSnapshot(const QString& snapshotPath, qint64 revision);
+    // 替换数据库文件前的检查（守护进程用于等待展示进程关闭连接），返回false时放弃替换
+    using ReplaceGuard = std::function<bool()>;
+    void setReplaceGuard(ReplaceGuard guard) { m_replaceGuard = std::move(guard); }
+    // 关闭本进程的全部连接（守护进程即将替换数据库文件），之后由 reopen() 重新打开
+    void release();
+    // 重新打开数据库文件（守护进程已替换文件，本进程的连接仍指向旧文件），清空各项缓存后发出 databaseReplaced
+    bool reopen();
+
+    // -------------------------- 同步落库 --------------------------
+    // 课程/通知按服务器端ID写入：已有同一 serverId 的行则替换，否则新增
+    bool upsertCourse(int serverId, int classId, const QString& courseName, const QString& teacher,
+                      const QString& courseType, const QString& startTime, const QString& endTime, int dayOfWeek,
+                      const QString& startDate, const QString& endDate, int classroomId, qint64 weekMask);
+    bool upsertNotice(int serverId, const QString& title, const QString& content, const QString& publishTime,
+                      const QString& expireTime, bool isScrolling);
+    // 按服务器端ID删除（服务器上已删除的行），本地不存在时视为成功
+    bool removeCourseByServerId(int serverId);
+    bool removeNoticeByServerId(int serverId);
+    // 整份同步报文在一个事务中应用；提交失败或回滚时丢弃与库不一致的内存缓存
+    bool beginSyncApply();
+    bool commitSyncApply();
+    void rollbackSyncApply();
 
 private:
     DatabaseManager(QObject* parent = nullptr) : QObject(parent) {}
@@ -72,11 +207,44 @@ private:
     bool isDateInRange(const QString& checkDate, const QString& startDate, const QString& endDate);
     QString formatDate(const QString& dateStr);
     QString cleanSqlStatement(const QString& stmt);
+    // 有效课表：确保指定日期已展开；重新展开指定日期
+    bool ensureDateMaterialized(const QString& date);
+    bool materializeDate(const QString& date);
+    // 教室区间索引：首次查询时全量加载
+    void ensureRoomIndex();
+    // 通知全文索引（虚表与同步触发器，建表脚本按分号切分无法包含触发器，故在此创建）
+    bool ensureNoticeFts();
+    QList<QVariantMap> searchNoticesByLike(const QString& keyword, int limit, int offset);
+    // 选出至多 batchSize 个待归档ID（selectSql 带 beforeDate、batchSize 两个占位符），逐条复制到归档表后
+    // 依次执行 deleteSqls（占位符为ID），复制与删除在同一事务内
+    QList<int> archiveBatch(const QString& selectSql, const QString& copySql, const QStringList& deleteSqls,
+                            const QString& beforeDate, int batchSize, bool* ok);
+    // 对每个通知ID执行一次 sql（一个事务，占位符依次为 extraValues、id），返回影响条数，失败返回-1
+    int execNoticeBatch(const QString& sql, const QList<int>& noticeIds, const QVariantList& extraValues,
+                        const QString& action);
+    // 快照校验：quick_check、结构版本、必需数据表；通过时返回快照内记录的数据版本
+    bool validateSnapshot(const QString& snapshotPath, qint64* revision, QString* error);
+    // 数据库文件被替换后重新连接：应用 PRAGMA 配置并清空对应旧库的内存缓存
+    bool reconnect();
+    // 清空与库内容对应的内存缓存（已展开日期、教室区间索引、字典）
+    void resetCaches();
+    // 服务器端课程ID对应的本地课程ID（不存在返回0，查询失败返回-1）
+    int courseIdByServerId(int serverId);
 
 private:
     QSqlDatabase m_db;          // 数据库连接
     QString m_dbPath;           // 数据库路径
     const QString m_dbName = "classboard.db"; // 数据库文件名
+    QSet<QString> m_materializedDates;          // 已展开日期缓存（避免每次查询都检查 materialized_dates）
+    RoomIntervalIndex m_roomIndex;              // 教室占用区间索引（课程增删时增量维护）
+    QFutureWatcher<DatabaseBackup::Result>* m_backupWatcher = nullptr; // 在线备份（首次备份时创建）
+    QString m_backupTarget;                     // 正在写入的快照路径
+    bool m_noticeFtsReady = false;              // 通知全文索引可用（SQLite 编译时未启用 FTS5 则为false）
+    ReplaceGuard m_replaceGuard;                // 替换数据库文件前的检查（未设置时直接替换）
+    // 字典编码列的驻留池（课程名称/教师/课程类型）
+    StringDictionary m_courseNames{"course_name_info", "course_name"};
+    StringDictionary m_teachers{"teacher_info", "teacher_name"};
+    StringDictionary m_courseTypes{"course_type_info", "type_name"};
 };
 
 #endif // DATABASEMANAGER_H
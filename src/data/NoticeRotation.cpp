@@ -0,0 +1,65 @@
+#include "NoticeRotation.h"
+#include "DatabaseManager.h"
+#include "NoticeScheduler.h"
+#include "metrics/Tracer.h"
+#include "utility/Clock.h"
+
+NoticeRotation& NoticeRotation::instance()
+{
+    static NoticeRotation instance;
+    return instance;
+}
+
+NoticeRotation::NoticeRotation(QObject* parent) : QObject(parent)
+{
+    connect(&DatabaseManager::instance(), &DatabaseManager::noticesChanged, this, &NoticeRotation::invalidate);
+    connect(&Clock::instance(), &Clock::timeJumped, this, &NoticeRotation::invalidate);
+    // 定时发布/过期由调度器按时推送
+    connect(&NoticeScheduler::instance(), &NoticeScheduler::noticesActivated, this, &NoticeRotation::invalidate);
+    connect(&NoticeScheduler::instance(), &NoticeScheduler::noticesDeactivated, this, &NoticeRotation::invalidate);
+}
+
+QString NoticeRotation::next()
+{
+    ensureFresh();
+    if (m_ring.isEmpty()) {
+        return QString();
+    }
+    if (m_index >= m_ring.size()) {
+        m_index = 0;
+    }
+    return m_ring.at(m_index++);
+}
+
+int NoticeRotation::size()
+{
+    ensureFresh();
+    return m_ring.size();
+}
+
+void NoticeRotation::ensureFresh()
+{
+    if (m_dirty) {
+        rebuild();
+    }
+}
+
+void NoticeRotation::rebuild()
+{
+    CB_TRACE_SPAN("notice.rebuildRotation");
+    QList<QVariantMap> notices = DatabaseManager::instance().getValidNotices(true);
+
+    m_ring.clear();
+    m_ring.reserve(notices.size());
+    for (const QVariantMap& notice : notices) {
+        m_ring.append(QString("[%1] %2：%3")
+                      .arg(notice["publish_time"].toString().left(10))
+                      .arg(notice["title"].toString())
+                      .arg(notice["content"].toString()));
+    }
+
+    m_dirty = false;
+    if (m_index >= m_ring.size()) {
+        m_index = 0;
+    }
+}
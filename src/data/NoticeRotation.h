@@ -0,0 +1,38 @@
+#ifndef NOTICEROTATION_H
+#define NOTICEROTATION_H
+
+#include <QObject>
+#include <QStringList>
+
+// 滚动通知轮播（单例）
+// 缓存已格式化好的滚动通知环，每次轮播只前移下标、不访问数据库；
+// 通知增删改（DatabaseManager::noticesChanged）、时间跳变或调度器推送发布/过期事件时才重新加载
+class NoticeRotation : public QObject
+{
+    Q_OBJECT
+public:
+    static NoticeRotation& instance();
+    ~NoticeRotation() = default;
+
+    // 下一条滚动通知的展示文本（无滚动通知时返回空串）
+    QString next();
+    // 当前环中的通知条数
+    int size();
+
+    // 标记缓存失效，下次轮播时重新加载
+    void invalidate() { m_dirty = true; }
+
+private:
+    NoticeRotation(QObject* parent = nullptr);
+    NoticeRotation(const NoticeRotation&) = delete;
+    NoticeRotation& operator=(const NoticeRotation&) = delete;
+
+    void ensureFresh();
+    void rebuild();
+
+    QStringList m_ring;        // 预格式化的通知文本
+    int m_index = 0;           // 下一条的位置
+    bool m_dirty = true;
+};
+
+#endif // NOTICEROTATION_H
@@ -0,0 +1,154 @@
+#include "NoticeScheduler.h"
+#include "DatabaseManager.h"
+#include "metrics/MetricsRegistry.h"
+#include "metrics/Tracer.h"
+#include "utility/Clock.h"
+#include "utility/LogHelper.h"
+
+// 单次定时器的最长等待（超过后醒来重新计算，避免模拟倍速变化或系统时间调整后长时间偏差）
+static const qint64 kMaxArmMs = 60 * 60 * 1000;
+
+NoticeScheduler& NoticeScheduler::instance()
+{
+    static NoticeScheduler instance;
+    return instance;
+}
+
+NoticeScheduler::NoticeScheduler(QObject* parent) : QObject(parent)
+{
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &NoticeScheduler::onTimeout);
+    connect(&DatabaseManager::instance(), &DatabaseManager::noticesChanged, this, &NoticeScheduler::scheduleReload);
+    connect(&Clock::instance(), &Clock::timeJumped, this, [this](const QDateTime&) {
+        if (m_started) {
+            processDue();
+            arm();
+        }
+    });
+}
+
+void NoticeScheduler::start()
+{
+    m_started = true;
+    reload();
+}
+
+// 同步一次可能写入大量通知，变化通知合并到事件循环下一轮再统一重载
+void NoticeScheduler::scheduleReload()
+{
+    if (!m_started || m_reloadPending) {
+        return;
+    }
+    m_reloadPending = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        m_reloadPending = false;
+        reload();
+    }, Qt::QueuedConnection);
+}
+
+void NoticeScheduler::reload()
+{
+    CB_TRACE_SPAN("notice.schedulerReload");
+    const qint64 nowMs = Clock::currentDateTime().toMSecsSinceEpoch();
+    QList<QVariantMap> schedule = DatabaseManager::instance().getNoticeSchedule();
+
+    decltype(m_events) events;
+    QList<int> expired;
+    for (const QVariantMap& notice : schedule) {
+        const int noticeId = notice["id"].toInt();
+
+        QDateTime publishAt = QDateTime::fromString(notice["publish_time"].toString(), "yyyy-MM-dd HH:mm:ss");
+        if (publishAt.isValid() && publishAt.toMSecsSinceEpoch() > nowMs) {
+            events.push({publishAt.toMSecsSinceEpoch(), noticeId, Publish});
+        }
+
+        // 过期日期当天仍有效，次日零点失效
+        QString expireText = notice["expire_time"].toString();
+        QDateTime expireAt = QDateTime::fromString(expireText, "yyyy-MM-dd HH:mm:ss");
+        if (!expireAt.isValid()) {
+            QDate expireDate = QDate::fromString(expireText, "yyyy-MM-dd");
+            if (expireDate.isValid()) {
+                expireAt = QDateTime(expireDate.addDays(1), QTime(0, 0));
+            }
+        }
+        if (!expireAt.isValid()) {
+            continue;
+        }
+        if (expireAt.toMSecsSinceEpoch() <= nowMs) {
+            expired.append(noticeId);
+        } else {
+            events.push({expireAt.toMSecsSinceEpoch(), noticeId, Expire});
+        }
+    }
+    m_events.swap(events);
+
+    // 停机期间已过期的通知
+    if (!expired.isEmpty()) {
+        DatabaseManager::instance().expireNotices(expired);
+        emit noticesDeactivated(expired);
+    }
+    arm();
+}
+
+QDateTime NoticeScheduler::nextEventTime() const
+{
+    return m_events.empty() ? QDateTime() : QDateTime::fromMSecsSinceEpoch(m_events.top().atMs);
+}
+
+void NoticeScheduler::onTimeout()
+{
+    MetricsRegistry::instance().recordTimerWakeup("notice_scheduler");
+    processDue();
+    arm();
+}
+
+// 弹出所有已到点的事件，过期通知合并为一次批量更新
+void NoticeScheduler::processDue()
+{
+    const qint64 nowMs = Clock::currentDateTime().toMSecsSinceEpoch();
+    QList<int> activated;
+    QList<int> expired;
+    while (!m_events.empty() && m_events.top().atMs <= nowMs) {
+        const Event event = m_events.top();
+        m_events.pop();
+        if (event.kind == Publish) {
+            activated.append(event.noticeId);
+        } else {
+            expired.append(event.noticeId);
+        }
+    }
+
+    if (!expired.isEmpty()) {
+        // 同一批次内既发布又过期的通知只推送失效
+        for (int noticeId : expired) {
+            activated.removeAll(noticeId);
+        }
+        DatabaseManager::instance().expireNotices(expired);
+    }
+
+    if (!activated.isEmpty()) {
+        writeLog("INFO", QString("定时发布通知：%1条").arg(activated.size()), "NOTICE");
+        emit noticesActivated(activated);
+    }
+    if (!expired.isEmpty()) {
+        writeLog("INFO", QString("通知到期失效：%1条").arg(expired.size()), "NOTICE");
+        emit noticesDeactivated(expired);
+    }
+}
+
+void NoticeScheduler::arm()
+{
+    m_timer.stop();
+    if (m_events.empty()) {
+        return;
+    }
+
+    // 模拟时钟按倍速流逝，真实等待时间相应缩短；倍速为0时时间静止，只随跳转处理
+    const double speed = Clock::instance().isSimulated() ? Clock::instance().speed() : 1.0;
+    if (speed <= 0.0) {
+        return;
+    }
+    const qint64 waitMs = m_events.top().atMs - Clock::currentDateTime().toMSecsSinceEpoch();
+    const qint64 realMs = qBound<qint64>(0, static_cast<qint64>(waitMs / speed), kMaxArmMs);
+    m_timer.start(static_cast<int>(realMs));
+}
@@ -0,0 +1,64 @@
+#ifndef NOTICESCHEDULER_H
+#define NOTICESCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QDateTime>
+#include <QList>
+#include <vector>
+#include <queue>
+#include <functional>
+
+// 通知定时发布/过期调度（单例）
+// 以最小堆保存所有未到达的发布时刻与过期时刻，只为最近的一个事件挂一个单次定时器；
+// 到点后按批次推送生效/失效事件，已过期的通知批量置 is_valid = 0，无需轮询
+class NoticeScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    static NoticeScheduler& instance();
+    ~NoticeScheduler() = default;
+
+    // 加载调度表并挂上定时器（启动时调用一次）
+    void start();
+    // 重新加载调度表（通知变化时自动合并调用）
+    void reload();
+
+    // 最近一个待处理事件的时刻（无事件返回无效值）
+    QDateTime nextEventTime() const;
+    int pendingEvents() const { return static_cast<int>(m_events.size()); }
+
+signals:
+    // 到达发布时刻的通知
+    void noticesActivated(const QList<int>& noticeIds);
+    // 到达过期时刻、已置为无效的通知
+    void noticesDeactivated(const QList<int>& noticeIds);
+
+private slots:
+    void onTimeout();
+    void scheduleReload();
+
+private:
+    NoticeScheduler(QObject* parent = nullptr);
+    NoticeScheduler(const NoticeScheduler&) = delete;
+    NoticeScheduler& operator=(const NoticeScheduler&) = delete;
+
+    enum EventKind { Publish = 0, Expire = 1 };
+    struct Event
+    {
+        qint64 atMs = 0;   // 事件时刻（自纪元起毫秒）
+        int noticeId = 0;
+        EventKind kind = Publish;
+        bool operator>(const Event& other) const { return atMs > other.atMs; }
+    };
+
+    void processDue();
+    void arm();
+
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> m_events;
+    QTimer m_timer;
+    bool m_started = false;
+    bool m_reloadPending = false;
+};
+
+#endif // NOTICESCHEDULER_H
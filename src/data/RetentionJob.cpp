@@ -0,0 +1,150 @@
+#include "RetentionJob.h"
+#include "DatabaseManager.h"
+#include "metrics/MetricsRegistry.h"
+#include "metrics/Tracer.h"
+#include "settings/SettingsManager.h"
+#include "utility/Clock.h"
+#include "utility/LogHelper.h"
+
+// 空闲时段检查间隔
+static const int kCheckIntervalMs = 10 * 60 * 1000;
+// 每批归档条数与批间间隔（单批约几毫秒，期间写锁被占用）
+static const int kArchiveBatchSize = 200;
+static const int kStepIntervalMs = 50;
+// 每批回收的页数
+static const int kVacuumPagesPerStep = 256;
+
+RetentionJob& RetentionJob::instance()
+{
+    static RetentionJob instance;
+    return instance;
+}
+
+RetentionJob::RetentionJob(QObject* parent) : QObject(parent)
+{
+    m_checkTimer.setInterval(kCheckIntervalMs);
+    connect(&m_checkTimer, &QTimer::timeout, this, &RetentionJob::onCheck);
+    m_stepTimer.setSingleShot(true);
+    m_stepTimer.setInterval(kStepIntervalMs);
+    connect(&m_stepTimer, &QTimer::timeout, this, &RetentionJob::step);
+}
+
+void RetentionJob::start()
+{
+    if (!SettingsManager::instance().isRetentionEnabled()) {
+        writeLog("INFO", "数据保留任务已关闭", "RETENTION");
+        return;
+    }
+    m_checkTimer.start();
+    onCheck();
+}
+
+void RetentionJob::runNow()
+{
+    begin(true);
+}
+
+void RetentionJob::onCheck()
+{
+    MetricsRegistry::instance().recordTimerWakeup("retention_check");
+    if (m_stage == Idle && m_lastRunDate != Clock::currentDate() && inIdleWindow()) {
+        begin(false);
+    } else if (m_stage != Idle && !m_stepTimer.isActive() && inIdleWindow()) {
+        // 上一空闲时段未完成的一轮继续执行
+        m_stepTimer.start();
+    }
+}
+
+// 空闲时段 [start, end)，start 大于 end 时跨零点
+bool RetentionJob::inIdleWindow() const
+{
+    const int hour = Clock::currentTime().hour();
+    const int startHour = SettingsManager::instance().getIdleStartHour();
+    const int endHour = SettingsManager::instance().getIdleEndHour();
+    if (startHour <= endHour) {
+        return hour >= startHour && hour < endHour;
+    }
+    return hour >= startHour || hour < endHour;
+}
+
+void RetentionJob::begin(bool ignoreIdleWindow)
+{
+    if (m_stage != Idle) {
+        return;
+    }
+    m_ignoreIdleWindow = ignoreIdleWindow;
+    m_beforeDate = Clock::currentDate().addDays(-SettingsManager::instance().getRetentionDays()).toString("yyyy-MM-dd");
+    m_archivedNotices = 0;
+    m_archivedCourses = 0;
+    m_stage = ArchiveNotices;
+    writeLog("INFO", QString("数据保留任务开始，归档%1之前过期/结课的数据").arg(m_beforeDate), "RETENTION");
+    m_stepTimer.start();
+}
+
+// 每次只处理一批，处理完挂下一次定时器，不阻塞事件循环
+void RetentionJob::step()
+{
+    CB_TRACE_SPAN("retention.step");
+    if (!m_ignoreIdleWindow && !inIdleWindow()) {
+        writeLog("INFO", "已离开空闲时段，数据保留任务暂停", "RETENTION");
+        return;
+    }
+
+    ScopedMetricsTimer metricsTimer("classboard_retention_batch_seconds");
+    DatabaseManager& db = DatabaseManager::instance();
+    int moved = 0;
+    switch (m_stage) {
+    case ArchiveNotices:
+        moved = db.archiveExpiredNotices(m_beforeDate, kArchiveBatchSize);
+        if (moved > 0) {
+            m_archivedNotices += moved;
+            MetricsRegistry::instance().incrementCounter("classboard_retention_archived_total", moved, "table=\"notices\"");
+        }
+        if (moved < kArchiveBatchSize) {
+            m_stage = ArchiveCourses;
+        }
+        break;
+    case ArchiveCourses:
+        moved = db.archiveEndedCourses(m_beforeDate, kArchiveBatchSize);
+        if (moved > 0) {
+            m_archivedCourses += moved;
+            MetricsRegistry::instance().incrementCounter("classboard_retention_archived_total", moved, "table=\"course_schedule\"");
+        }
+        if (moved < kArchiveBatchSize) {
+            // 非增量回收模式下 incremental_vacuum 不起作用，空闲页永不减少
+            if (!db.isIncrementalVacuumEnabled()) {
+                writeLog("INFO", "数据库未启用增量回收模式（auto_vacuum），跳过空间回收", "RETENTION");
+                finish();
+                return;
+            }
+            m_stage = Vacuum;
+            m_freePages = -1;
+        }
+        break;
+    case Vacuum: {
+        // 空闲页回收完毕，或一批之后不再减少（回收失败或未生效）时结束，避免在整个空闲时段内空转
+        const int freePages = db.incrementalVacuum(kVacuumPagesPerStep);
+        if (freePages <= 0 || (m_freePages >= 0 && freePages >= m_freePages)) {
+            if (freePages > 0) {
+                writeLog("WARNING", QString("空闲页未减少（剩余%1页），结束空间回收").arg(freePages), "RETENTION");
+            }
+            finish();
+            return;
+        }
+        m_freePages = freePages;
+        break;
+    }
+    default:
+        return;
+    }
+    m_stepTimer.start();
+}
+
+void RetentionJob::finish()
+{
+    m_stage = Idle;
+    m_lastRunDate = Clock::currentDate();
+    writeLog("INFO", QString("数据保留任务完成：归档通知%1条，课程%2条").arg(m_archivedNotices).arg(m_archivedCourses),
+             "RETENTION");
+    emit finished(m_archivedNotices, m_archivedCourses);
+}
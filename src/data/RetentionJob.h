@@ -0,0 +1,55 @@
+#ifndef RETENTIONJOB_H
+#define RETENTIONJOB_H
+
+#include <QObject>
+#include <QTimer>
+#include <QDate>
+
+// 数据保留任务（单例）
+// 每天空闲时段（默认凌晨1-5点）运行一次：把过期超过保留天数的通知、结课超过保留天数的课程
+// 分小批移入归档表，最后增量回收空闲页，使热表大小不随部署时长增长。
+// 每批一个短事务，批间让出事件循环；离开空闲时段时暂停，下一个空闲时段继续
+class RetentionJob : public QObject
+{
+    Q_OBJECT
+public:
+    static RetentionJob& instance();
+    ~RetentionJob() = default;
+
+    // 开始按空闲时段调度（启动时调用一次，设置中关闭时不运行）
+    void start();
+    // 立即运行一轮（不检查空闲时段）
+    void runNow();
+    bool isRunning() const { return m_stage != Idle; }
+
+signals:
+    // 一轮完成：归档的通知数、课程数
+    void finished(int archivedNotices, int archivedCourses);
+
+private slots:
+    void onCheck();
+    void step();
+
+private:
+    RetentionJob(QObject* parent = nullptr);
+    RetentionJob(const RetentionJob&) = delete;
+    RetentionJob& operator=(const RetentionJob&) = delete;
+
+    enum Stage { Idle = 0, ArchiveNotices, ArchiveCourses, Vacuum };
+
+    bool inIdleWindow() const;
+    void begin(bool ignoreIdleWindow);
+    void finish();
+
+    QTimer m_checkTimer;        // 周期检查是否进入空闲时段
+    QTimer m_stepTimer;         // 批与批之间的间隔
+    Stage m_stage = Idle;
+    bool m_ignoreIdleWindow = false;
+    QString m_beforeDate;       // 本轮归档截止日期（早于该日期的数据归档）
+    QDate m_lastRunDate;        // 最近一次完整运行的日期（每天至多一轮）
+    int m_archivedNotices = 0;
+    int m_archivedCourses = 0;
+    int m_freePages = -1;       // 上一批回收后的空闲页数（-1 表示尚未回收）
+};
+
+#endif // RETENTIONJOB_H
@@ -0,0 +1,156 @@
+#include "RoomIntervalIndex.h"
+#include "utility/WeekMask.h"
+#include <QDate>
+#include <algorithm>
+
+void RoomIntervalIndex::clear()
+{
+    m_built = false;
+    m_rooms.clear();
+    m_intervals.clear();
+    m_courseKeys.clear();
+    m_dayOverrides.clear();
+}
+
+void RoomIntervalIndex::insert(const Interval& interval)
+{
+    if (interval.classroomId <= 0 || interval.dayOfWeek < 1 || interval.dayOfWeek > 7) {
+        return;
+    }
+    remove(interval.courseId);
+
+    const quint64 groupKey = key(interval.classroomId, interval.dayOfWeek);
+    QVector<Interval>& list = m_intervals[groupKey];
+    auto pos = std::upper_bound(list.begin(), list.end(), interval.startSecs, [](int start, const Interval& item) {
+        return start < item.startSecs;
+    });
+    list.insert(pos, interval);
+    updateMaxEnd(list);
+    m_courseKeys.insert(interval.courseId, groupKey);
+}
+
+void RoomIntervalIndex::remove(int courseId)
+{
+    auto keyIt = m_courseKeys.find(courseId);
+    if (keyIt == m_courseKeys.end()) {
+        return;
+    }
+    auto listIt = m_intervals.find(keyIt.value());
+    if (listIt != m_intervals.end()) {
+        QVector<Interval>& list = listIt.value();
+        list.erase(std::remove_if(list.begin(), list.end(), [courseId](const Interval& item) {
+            return item.courseId == courseId;
+        }), list.end());
+        if (list.isEmpty()) {
+            m_intervals.erase(listIt);
+        } else {
+            updateMaxEnd(list);
+        }
+    }
+    m_courseKeys.erase(keyIt);
+}
+
+void RoomIntervalIndex::updateMaxEnd(QVector<Interval>& list)
+{
+    int maxEnd = 0;
+    for (Interval& item : list) {
+        maxEnd = qMax(maxEnd, item.endSecs);
+        item.maxEndSoFar = maxEnd;
+    }
+}
+
+int RoomIntervalIndex::effectiveDayOfWeek(qint64 julianDay) const
+{
+    auto it = m_dayOverrides.constFind(julianDay);
+    if (it != m_dayOverrides.constEnd()) {
+        return it.value();
+    }
+    return QDate::fromJulianDay(julianDay).dayOfWeek();
+}
+
+bool RoomIntervalIndex::appliesOn(const Interval& interval, qint64 julianDay)
+{
+    if (julianDay < interval.startDay || julianDay > interval.endDay) {
+        return false;
+    }
+    const int week = static_cast<int>((julianDay - interval.firstMonday) / 7) + 1;
+    return WeekMask::contains(interval.weekMask, week);
+}
+
+QList<int> RoomIntervalIndex::freeRooms(qint64 julianDay, int secs, QHash<int, int>* freeUntil) const
+{
+    QList<int> result;
+    const int dayOfWeek = effectiveDayOfWeek(julianDay);
+
+    for (auto room = m_rooms.constBegin(); room != m_rooms.constEnd(); ++room) {
+        const int classroomId = room.key();
+        bool busy = false;
+        int nextStart = -1;
+
+        if (dayOfWeek > 0) {
+            auto listIt = m_intervals.constFind(key(classroomId, dayOfWeek));
+            if (listIt != m_intervals.constEnd()) {
+                const QVector<Interval>& list = listIt.value();
+                // 第一个开始时刻晚于 secs 的区间；其前的区间才可能覆盖 secs
+                auto upper = std::upper_bound(list.constBegin(), list.constEnd(), secs, [](int t, const Interval& item) {
+                    return t < item.startSecs;
+                });
+                for (auto it = upper; it != list.constBegin(); ) {
+                    --it;
+                    if (it->maxEndSoFar <= secs) {
+                        break; // 更早的区间均已结束
+                    }
+                    if (it->endSecs > secs && appliesOn(*it, julianDay)) {
+                        busy = true;
+                        break;
+                    }
+                }
+                if (!busy) {
+                    for (auto it = upper; it != list.constEnd(); ++it) {
+                        if (appliesOn(*it, julianDay)) {
+                            nextStart = it->startSecs;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (!busy) {
+            result.append(classroomId);
+            if (freeUntil) {
+                freeUntil->insert(classroomId, nextStart);
+            }
+        }
+    }
+    return result;
+}
+
+QList<QPair<int, int>> RoomIntervalIndex::freeWindows(int classroomId, qint64 julianDay, int fromSecs, int toSecs) const
+{
+    QList<QPair<int, int>> windows;
+    int cursor = fromSecs;
+    const int dayOfWeek = effectiveDayOfWeek(julianDay);
+
+    auto listIt = dayOfWeek > 0 ? m_intervals.constFind(key(classroomId, dayOfWeek)) : m_intervals.constEnd();
+    if (listIt != m_intervals.constEnd()) {
+        // 区间已按开始时刻排序，顺序合并即可
+        for (const Interval& item : listIt.value()) {
+            if (item.startSecs >= toSecs) {
+                break;
+            }
+            if (item.endSecs <= cursor || !appliesOn(item, julianDay)) {
+                continue;
+            }
+            if (item.startSecs > cursor) {
+                windows.append(qMakePair(cursor, item.startSecs));
+            }
+            cursor = qMax(cursor, item.endSecs);
+        }
+    }
+
+    if (cursor < toSecs) {
+        windows.append(qMakePair(cursor, toSecs));
+    }
+    return windows;
+}
@@ -0,0 +1,67 @@
+#ifndef ROOMINTERVALINDEX_H
+#define ROOMINTERVALINDEX_H
+
+#include <QHash>
+#include <QMap>
+#include <QVector>
+#include <QList>
+#include <QPair>
+#include <QString>
+
+// 教室占用区间索引（内存）：按 (教室, 星期) 保存按开始时间排序的课程区间
+// 查询“某日某时刻的空闲教室”“某教室某日的空闲时段”时只访问对应星期的少量区间，
+// 由 DatabaseManager 在课程增删、校历变化时增量维护
+class RoomIntervalIndex
+{
+public:
+    struct Interval
+    {
+        int courseId = 0;
+        int classroomId = 0;
+        int dayOfWeek = 0;
+        int startSecs = 0;      // 上课时刻（自零点起的秒数）
+        int endSecs = 0;        // 占用结束时刻（不含）：下课分钟的末尾，与 getCurrentCourse 口径一致
+        qint64 startDay = 0;    // 起止日期（儒略日）
+        qint64 endDay = 0;
+        qint64 firstMonday = 0; // 开始日期所在周周一（儒略日）
+        qint64 weekMask = -1;
+        int maxEndSoFar = 0;    // 排序后截至本区间的最大下课时刻（用于提前结束回溯）
+    };
+
+    bool isBuilt() const { return m_built; }
+    void setBuilt(bool built) { m_built = built; }
+    void clear();
+
+    void setRoom(int classroomId, const QString& name) { m_rooms.insert(classroomId, name); }
+    const QMap<int, QString>& rooms() const { return m_rooms; }
+
+    void insert(const Interval& interval);
+    void remove(int courseId);
+
+    // 校历：指定日期按星期几上课（0=停课）；清除后按自然星期
+    void setDayOverride(qint64 julianDay, int dayOfWeek) { m_dayOverrides.insert(julianDay, dayOfWeek); }
+    void clearDayOverride(qint64 julianDay) { m_dayOverrides.remove(julianDay); }
+
+    // 指定日期、时刻空闲的教室；freeUntil 返回各空闲教室当天下一节课的开始时刻（无则为 -1）
+    QList<int> freeRooms(qint64 julianDay, int secs, QHash<int, int>* freeUntil = nullptr) const;
+
+    // 教室在指定日期 [fromSecs, toSecs) 内的空闲时段
+    QList<QPair<int, int>> freeWindows(int classroomId, qint64 julianDay, int fromSecs, int toSecs) const;
+
+private:
+    static quint64 key(int classroomId, int dayOfWeek)
+    {
+        return (static_cast<quint64>(static_cast<quint32>(classroomId)) << 3) | static_cast<quint64>(dayOfWeek);
+    }
+    int effectiveDayOfWeek(qint64 julianDay) const;
+    static bool appliesOn(const Interval& interval, qint64 julianDay);
+    static void updateMaxEnd(QVector<Interval>& list);
+
+    bool m_built = false;
+    QMap<int, QString> m_rooms;                     // 教室ID -> 名称
+    QHash<quint64, QVector<Interval>> m_intervals;  // (教室, 星期) -> 按开始时间排序的区间
+    QHash<int, quint64> m_courseKeys;               // 课程ID -> 所在分组
+    QHash<qint64, int> m_dayOverrides;              // 儒略日 -> 实际星期（0=停课）
+};
+
+#endif // ROOMINTERVALINDEX_H
@@ -0,0 +1,118 @@
+#include "SqlitePragmas.h"
+#include "utility/LogHelper.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QMutex>
+#include <QMutexLocker>
+
+// PRAGMA 不支持绑定参数，字符串取值只接受白名单
+static const QStringList kJournalModes = {"DELETE", "TRUNCATE", "PERSIST", "WAL"};
+static const QStringList kSynchronousModes = {"OFF", "NORMAL", "FULL", "EXTRA"};
+static const QStringList kTempStores = {"DEFAULT", "FILE", "MEMORY"};
+
+static QMutex s_currentMutex;
+static SqlitePragmaProfile s_current = SqlitePragmaProfile::preset("sdcard");
+
+SqlitePragmaProfile SqlitePragmaProfile::preset(const QString& name)
+{
+    SqlitePragmaProfile profile;
+    if (name == "compat") {
+        return profile;
+    }
+
+    profile.journalMode = "WAL";
+    profile.synchronous = "NORMAL";
+    profile.tempStore = "MEMORY";
+    if (name == "ssd") {
+        profile.mmapSizeBytes = 256LL * 1024 * 1024;
+        profile.cacheSizeKb = 64 * 1024;
+    } else {
+        profile.mmapSizeBytes = 0;
+        profile.cacheSizeKb = 8 * 1024;
+    }
+    return profile;
+}
+
+SqlitePragmaProfile SqlitePragmaProfile::fromSettings(const QString& presetName, const QVariantMap& overrides)
+{
+    SqlitePragmaProfile profile = preset(presetName);
+    if (overrides.contains("JournalMode")) {
+        profile.journalMode = overrides.value("JournalMode").toString().toUpper();
+    }
+    if (overrides.contains("Synchronous")) {
+        profile.synchronous = overrides.value("Synchronous").toString().toUpper();
+    }
+    if (overrides.contains("MmapSizeMb")) {
+        profile.mmapSizeBytes = qMax(0LL, overrides.value("MmapSizeMb").toLongLong()) * 1024 * 1024;
+    }
+    if (overrides.contains("CacheSizeKb")) {
+        profile.cacheSizeKb = qMax(0, overrides.value("CacheSizeKb").toInt());
+    }
+    if (overrides.contains("TempStore")) {
+        profile.tempStore = overrides.value("TempStore").toString().toUpper();
+    }
+    if (overrides.contains("BusyTimeoutMs")) {
+        profile.busyTimeoutMs = qMax(0, overrides.value("BusyTimeoutMs").toInt());
+    }
+    return profile;
+}
+
+bool SqlitePragmaProfile::apply(QSqlDatabase& db, bool readOnly) const
+{
+    QStringList pragmas;
+    bool valid = true;
+
+    // busy_timeout 放在最前，切换 journal_mode 时若有其他连接持锁也会等待
+    pragmas << QString("PRAGMA busy_timeout = %1").arg(busyTimeoutMs);
+    if (!readOnly) {
+        if (kJournalModes.contains(journalMode)) {
+            pragmas << "PRAGMA journal_mode = " + journalMode;
+        } else {
+            writeLog("WARNING", "忽略非法的 journal_mode：" + journalMode, "DATABASE");
+            valid = false;
+        }
+    }
+    if (kSynchronousModes.contains(synchronous)) {
+        pragmas << "PRAGMA synchronous = " + synchronous;
+    } else {
+        writeLog("WARNING", "忽略非法的 synchronous：" + synchronous, "DATABASE");
+        valid = false;
+    }
+    if (kTempStores.contains(tempStore)) {
+        pragmas << "PRAGMA temp_store = " + tempStore;
+    } else {
+        writeLog("WARNING", "忽略非法的 temp_store：" + tempStore, "DATABASE");
+        valid = false;
+    }
+    // cache_size 取负值表示按KB计
+    pragmas << QString("PRAGMA cache_size = -%1").arg(cacheSizeKb);
+    pragmas << QString("PRAGMA mmap_size = %1").arg(mmapSizeBytes);
+
+    QSqlQuery query(db);
+    for (const QString& pragma : pragmas) {
+        if (!query.exec(pragma)) {
+            writeLog("WARNING", QString("%1 执行失败：%2").arg(pragma, query.lastError().text()), "DATABASE");
+            valid = false;
+        }
+    }
+    return valid;
+}
+
+QString SqlitePragmaProfile::describe() const
+{
+    return QString("journal_mode=%1, synchronous=%2, mmap_size=%3MB, cache_size=%4KB, temp_store=%5, busy_timeout=%6ms")
+        .arg(journalMode, synchronous).arg(mmapSizeBytes / (1024 * 1024)).arg(cacheSizeKb)
+        .arg(tempStore).arg(busyTimeoutMs);
+}
+
+SqlitePragmaProfile SqlitePragmaProfile::current()
+{
+    QMutexLocker locker(&s_currentMutex);
+    return s_current;
+}
+
+void SqlitePragmaProfile::setCurrent(const SqlitePragmaProfile& profile)
+{
+    QMutexLocker locker(&s_currentMutex);
+    s_current = profile;
+}
@@ -0,0 +1,40 @@
+#ifndef SQLITEPRAGMAS_H
+#define SQLITEPRAGMAS_H
+
+#include <QString>
+#include <QStringList>
+#include <QVariantMap>
+#include <QSqlDatabase>
+
+// SQLite 连接参数（PRAGMA 配置）
+// 主连接与冲突检测、备份、异步查询等工作线程连接在打开后都调用 apply，保持一致的缓存与等待策略
+struct SqlitePragmaProfile
+{
+    QString journalMode = "DELETE";  // DELETE / TRUNCATE / PERSIST / WAL
+    QString synchronous = "FULL";    // OFF / NORMAL / FULL / EXTRA
+    qint64 mmapSizeBytes = 0;        // 内存映射读取上限（0=不映射）
+    int cacheSizeKb = 2000;          // 每个连接的页缓存
+    QString tempStore = "DEFAULT";   // 临时表与排序：DEFAULT / FILE / MEMORY
+    int busyTimeoutMs = 5000;        // 遇到锁时的等待时长
+
+    // 预设：
+    //   sdcard  班牌（SD卡/eMMC）：WAL + NORMAL 减少每次提交的刷盘，不开 mmap（存储出错时映射读会使进程崩溃），8MB缓存，临时数据放内存
+    //   ssd     管理端电脑：WAL + NORMAL，256MB mmap，64MB缓存
+    //   compat  旧版默认（回滚日志、FULL、无 mmap），用于对比
+    static SqlitePragmaProfile preset(const QString& name);
+    static QStringList presetNames() { return {"sdcard", "ssd", "compat"}; }
+    // 以预设为基础，用 overrides 中的项覆盖（键：JournalMode、Synchronous、MmapSizeMb、CacheSizeKb、TempStore、BusyTimeoutMs）
+    static SqlitePragmaProfile fromSettings(const QString& presetName, const QVariantMap& overrides);
+
+    // 在已打开的连接上执行；只读连接不切换 journal_mode（数据库级设置由主连接写入文件）
+    // 非法取值跳过并记日志，返回是否全部生效
+    bool apply(QSqlDatabase& db, bool readOnly) const;
+
+    QString describe() const;
+
+    // 进程内当前生效的配置（线程安全；工作线程打开连接时读取）
+    static SqlitePragmaProfile current();
+    static void setCurrent(const SqlitePragmaProfile& profile);
+};
+
+#endif // SQLITEPRAGMAS_H
@@ -0,0 +1,89 @@
+#include "StringDictionary.h"
+#include "utility/LogHelper.h"
+#include <QSqlQuery>
+#include <QSqlError>
+
+StringDictionary::StringDictionary(const QString& table, const QString& column)
+    : m_table(table), m_column(column)
+{
+}
+
+void StringDictionary::clear()
+{
+    m_ids.clear();
+    m_names.clear();
+    m_loaded = false;
+}
+
+void StringDictionary::insert(int id, const QString& name)
+{
+    // 两张表使用同一个 QString 实例，只占一份字符数据
+    m_ids.insert(name, id);
+    m_names.insert(id, name);
+}
+
+bool StringDictionary::reload(QSqlDatabase& db)
+{
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    if (!query.exec(QString("SELECT id, %1 FROM %2").arg(m_column, m_table))) {
+        writeLog("ERROR", QString("加载字典表%1失败：%2").arg(m_table, query.lastError().text()), "DATABASE");
+        return false;
+    }
+
+    m_ids.clear();
+    m_names.clear();
+    while (query.next()) {
+        insert(query.value(0).toInt(), query.value(1).toString());
+    }
+    m_loaded = true;
+    return true;
+}
+
+int StringDictionary::idFor(QSqlDatabase& db, const QString& name)
+{
+    if (name.isEmpty()) {
+        return 0;
+    }
+    if (!m_loaded) {
+        reload(db);
+    }
+    auto cached = m_ids.constFind(name);
+    if (cached != m_ids.constEnd()) {
+        return cached.value();
+    }
+
+    QSqlQuery query(db);
+    query.prepare(QString("INSERT OR IGNORE INTO %1 (%2) VALUES (?)").arg(m_table, m_column));
+    query.addBindValue(name);
+    if (!query.exec()) {
+        writeLog("ERROR", QString("字典表%1写入失败：%2").arg(m_table, query.lastError().text()), "DATABASE");
+        return 0;
+    }
+
+    // 可能已由其他进程写入，统一按名称回查
+    query.prepare(QString("SELECT id FROM %1 WHERE %2 = ?").arg(m_table, m_column));
+    query.addBindValue(name);
+    if (query.exec() && query.next()) {
+        int id = query.value(0).toInt();
+        insert(id, name);
+        return id;
+    }
+    return 0;
+}
+
+QString StringDictionary::name(QSqlDatabase& db, int id)
+{
+    if (id <= 0) {
+        return QString();
+    }
+    auto cached = m_names.constFind(id);
+    if (cached != m_names.constEnd()) {
+        return cached.value();
+    }
+    // 守护进程或直接写库新增了取值：整体重新加载
+    if (reload(db)) {
+        return m_names.value(id);
+    }
+    return QString();
+}
@@ -0,0 +1,35 @@
+#ifndef STRINGDICTIONARY_H
+#define STRINGDICTIONARY_H
+
+#include <QHash>
+#include <QString>
+#include <QSqlDatabase>
+
+// 字符串字典（驻留池）：对应一张 (id, 名称) 字典表
+// 同一取值在内存中只保留一份 QString，查询结果按 ID 解码后共享同一份隐式共享数据，
+// 避免课表每行都重新构造课程名称、教师、课程类型字符串
+class StringDictionary
+{
+public:
+    StringDictionary(const QString& table, const QString& column);
+
+    // 名称 -> ID（不存在则写入字典表，空名称或失败返回0）
+    int idFor(QSqlDatabase& db, const QString& name);
+    // ID -> 名称（未命中时重新加载一次字典表，仍未命中返回空串）
+    QString name(QSqlDatabase& db, int id);
+
+    void clear();
+    int size() const { return m_names.size(); }
+
+private:
+    bool reload(QSqlDatabase& db);
+    void insert(int id, const QString& name);
+
+    QString m_table;
+    QString m_column;
+    QHash<QString, int> m_ids;   // 名称 -> ID
+    QHash<int, QString> m_names; // ID -> 名称（与 m_ids 的键共享数据）
+    bool m_loaded = false;
+};
+
+#endif // STRINGDICTIONARY_H
@@ -1,5 +1,9 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include "ui/MainWindow.h"
+#include "utility/Clock.h"
+#include "utility/ScheduleSimulator.h"
+#include "utility/LogHelper.h"
 #include <QTextCodec>
 
 int main(int argc, char *argv[])
@@ -14,9 +18,42 @@ int main(int argc, char *argv[])
     a.setApplicationVersion("1.0.0");
     a.setOrganizationName("Qt6Demo");
 
+    // 模拟时间（调试/演示用）：
+    //   --simulate-start "2026-03-02 07:50" --simulate-speed 1000   从指定时刻起按1000倍速运行
+    //   --simulate-start "2026-03-02 07:50" --simulate-jump 2000    每2秒跳到下一个上课/下课时刻
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption startOpt("simulate-start", "模拟时间起点（yyyy-MM-dd HH:mm）", "datetime");
+    QCommandLineOption speedOpt("simulate-speed", "模拟时间倍速", "factor", "1000");
+    QCommandLineOption jumpOpt("simulate-jump", "按课表切换时刻跳转，参数为跳转间隔（毫秒）", "ms");
+    parser.addOptions({startOpt, speedOpt, jumpOpt});
+    parser.process(a);
+
+    if (parser.isSet(startOpt) || parser.isSet(speedOpt) || parser.isSet(jumpOpt)) {
+        QDateTime start = QDateTime::currentDateTime();
+        if (parser.isSet(startOpt)) {
+            start = QDateTime::fromString(parser.value(startOpt), "yyyy-MM-dd HH:mm");
+            if (!start.isValid()) {
+                qCritical() << "模拟时间起点格式错误：" << parser.value(startOpt);
+                return 1;
+            }
+        }
+        // 跳转模式下时间只随切换时刻变化，避免两次跳转之间继续流逝
+        double speed = parser.isSet(jumpOpt) ? 0.0 : parser.value(speedOpt).toDouble();
+        Clock::instance().startSimulation(start, speed);
+        writeLog("INFO", QString("模拟时间已启用：起点%1，倍速%2")
+                 .arg(start.toString("yyyy-MM-dd HH:mm")).arg(speed), "CLOCK");
+    }
+
     // 启动主窗口
     MainWindow w;
     w.show();
 
+    ScheduleSimulator simulator;
+    if (parser.isSet(jumpOpt)) {
+        simulator.start(parser.value(jumpOpt).toInt());
+    }
+
     return a.exec();
-}
\ No newline at end of file
+}
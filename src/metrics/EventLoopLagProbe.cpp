@@ -0,0 +1,28 @@
+#include "EventLoopLagProbe.h"
+#include "MetricsRegistry.h"
+
+EventLoopLagProbe::EventLoopLagProbe(int intervalMs, QObject *parent)
+    : QObject(parent)
+    , m_intervalMs(intervalMs)
+{
+    m_timer = new QTimer(this);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    m_timer->setInterval(intervalMs);
+    connect(m_timer, &QTimer::timeout, this, &EventLoopLagProbe::onTick);
+}
+
+void EventLoopLagProbe::start()
+{
+    m_clock.start();
+    m_timer->start();
+}
+
+void EventLoopLagProbe::onTick()
+{
+    double lag = qMax<qint64>(0, m_clock.restart() - m_intervalMs) / 1000.0;
+
+    MetricsRegistry& registry = MetricsRegistry::instance();
+    registry.setGauge("classboard_gui_event_loop_lag_seconds", lag);
+    registry.observe("classboard_gui_event_loop_lag_hist_seconds", lag);
+    registry.recordTimerWakeup("lag_probe");
+}
@@ -0,0 +1,27 @@
+#ifndef EVENTLOOPLAGPROBE_H
+#define EVENTLOOPLAGPROBE_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+
+// 事件循环延迟探针：按固定周期触发定时器，实际触发时间与预期之差即为事件循环延迟
+// 结果写入 MetricsRegistry（classboard_gui_event_loop_lag_seconds）
+class EventLoopLagProbe : public QObject
+{
+    Q_OBJECT
+public:
+    explicit EventLoopLagProbe(int intervalMs = 500, QObject *parent = nullptr);
+
+    void start();
+
+private slots:
+    void onTick();
+
+private:
+    QTimer* m_timer;
+    QElapsedTimer m_clock;
+    int m_intervalMs;
+};
+
+#endif // EVENTLOOPLAGPROBE_H
@@ -0,0 +1,229 @@
+#include "MetricsRegistry.h"
+#include "utility/LogHelper.h"
+#include <QMutexLocker>
+#include <QFile>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#include <unistd.h>
+#endif
+
+MetricsRegistry& MetricsRegistry::instance()
+{
+    static MetricsRegistry instance;
+    return instance;
+}
+
+// 日志写入计数（LogHelper 不依赖指标模块，由注册表安装钩子）
+static void countLogWrite(const QString& level)
+{
+    MetricsRegistry::instance().incrementCounter("classboard_log_writes_total", 1, QString("level=\"%1\"").arg(level));
+}
+
+MetricsRegistry::MetricsRegistry(QObject* parent) : QObject(parent)
+{
+    m_uptime.start();
+
+    m_latencyBounds = {0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10};
+    m_sizeBounds = {1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 16777216};
+
+    // 已知指标说明
+    describe("classboard_sync_total", "counter", "同步次数（按结果）");
+    describe("classboard_sync_duration_seconds", "histogram", "一次同步总耗时（请求到落库完成）");
+    describe("classboard_sync_bytes", "histogram", "同步响应大小");
+    describe("classboard_sync_parse_seconds", "histogram", "同步报文解析耗时");
+    describe("classboard_sync_apply_seconds", "histogram", "同步数据落库耗时");
+    describe("classboard_provision_total", "counter", "新板卡快照开通次数（snapshot=成功，fallback=退回全量同步）");
+    describe("classboard_provision_seconds", "histogram", "快照开通耗时（下载、校验到替换完成）");
+    describe("classboard_snapshot_bytes", "histogram", "下载的数据库快照大小");
+    describe("classboard_urgent_notices_total", "counter", "紧急通知通道收到的通知数");
+    describe("classboard_urgent_latency_seconds", "histogram", "紧急通知从服务器发布到客户端收到的延迟");
+    describe("classboard_db_query_duration_seconds", "histogram", "DatabaseManager 各方法耗时");
+    describe("classboard_schedule_conflicts", "gauge", "最近一次课表冲突检测的冲突数（按资源类型）");
+    describe("classboard_conflict_analysis_seconds", "histogram", "课表冲突检测耗时");
+    describe("classboard_backup_seconds", "histogram", "数据库在线备份耗时（按方式）");
+    describe("classboard_backup_bytes", "histogram", "数据库快照文件大小");
+    describe("classboard_retention_archived_total", "counter", "数据保留任务移入归档表的行数（按表）");
+    describe("classboard_retention_batch_seconds", "histogram", "数据保留任务单批耗时（归档或回收）");
+    describe("classboard_log_writes_total", "counter", "日志写入条数（按级别）");
+    describe("classboard_gui_event_loop_lag_seconds", "gauge", "GUI事件循环最近一次延迟");
+    describe("classboard_gui_event_loop_lag_hist_seconds", "histogram", "GUI事件循环延迟分布");
+    describe("classboard_gui_stalls_total", "counter", "界面卡顿次数（超过看门狗阈值）");
+    describe("classboard_gui_stall_seconds", "histogram", "界面卡顿持续时间");
+    describe("classboard_timer_wakeups_total", "counter", "定时器唤醒次数");
+    describe("classboard_timer_wakeups_per_minute", "gauge", "最近一分钟定时器唤醒次数");
+    describe("classboard_process_resident_bytes", "gauge", "进程常驻内存");
+    describe("classboard_process_uptime_seconds", "gauge", "进程运行时长");
+
+    setLogWriteHook(&countLogWrite);
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+    // 静态析构之后仍可能写日志
+    setLogWriteHook(nullptr);
+}
+
+void MetricsRegistry::describe(const QString& name, const QString& type, const QString& help)
+{
+    m_descriptions.insert(name, qMakePair(type, help));
+}
+
+void MetricsRegistry::incrementCounter(const QString& name, double value, const QString& labels)
+{
+    QMutexLocker locker(&m_mutex);
+    m_counters[name][labels] += value;
+}
+
+void MetricsRegistry::setGauge(const QString& name, double value, const QString& labels)
+{
+    QMutexLocker locker(&m_mutex);
+    m_gauges[name][labels] = value;
+}
+
+const QVector<double>& MetricsRegistry::bucketBounds(const QString& name) const
+{
+    return name.endsWith("_bytes") ? m_sizeBounds : m_latencyBounds;
+}
+
+void MetricsRegistry::observe(const QString& name, double value, const QString& labels)
+{
+    const QVector<double>& bounds = bucketBounds(name);
+
+    QMutexLocker locker(&m_mutex);
+    Histogram& hist = m_histograms[name][labels];
+    if (hist.buckets.isEmpty()) {
+        hist.buckets.fill(0, bounds.size());
+    }
+    for (int i = 0; i < bounds.size(); i++) {
+        if (value <= bounds[i]) {
+            hist.buckets[i]++;
+            break;
+        }
+    }
+    hist.sum += value;
+    hist.count++;
+}
+
+void MetricsRegistry::recordTimerWakeup(const QString& timerName)
+{
+    const qint64 second = m_uptime.elapsed() / 1000;
+
+    QMutexLocker locker(&m_mutex);
+    m_counters["classboard_timer_wakeups_total"][QString("timer=\"%1\"").arg(timerName)] += 1;
+
+    QVector<quint32>& buckets = m_wakeupBuckets[timerName];
+    if (buckets.isEmpty()) {
+        buckets.fill(0, 60);
+    }
+    // 清空自上次记录以来跳过的桶
+    qint64 last = m_wakeupLastSecond.value(timerName, second);
+    for (qint64 s = last + 1; s <= second && s <= last + 60; s++) {
+        buckets[s % 60] = 0;
+    }
+    m_wakeupLastSecond[timerName] = second;
+    buckets[second % 60]++;
+}
+
+QString MetricsRegistry::joinLabels(const QString& labels, const QString& extra)
+{
+    if (labels.isEmpty() && extra.isEmpty()) return "";
+    if (labels.isEmpty()) return "{" + extra + "}";
+    if (extra.isEmpty()) return "{" + labels + "}";
+    return "{" + labels + "," + extra + "}";
+}
+
+QString MetricsRegistry::formatValue(double value)
+{
+    return QString::number(value, 'g', 12);
+}
+
+QByteArray MetricsRegistry::renderPrometheus()
+{
+    // 采集时刻的进程指标
+    setGauge("classboard_process_resident_bytes", processResidentBytes());
+    setGauge("classboard_process_uptime_seconds", m_uptime.elapsed() / 1000.0);
+
+    QMutexLocker locker(&m_mutex);
+
+    // 最近一分钟唤醒次数
+    const qint64 second = m_uptime.elapsed() / 1000;
+    for (auto it = m_wakeupBuckets.constBegin(); it != m_wakeupBuckets.constEnd(); ++it) {
+        qint64 last = m_wakeupLastSecond.value(it.key(), second);
+        quint64 total = 0;
+        for (qint64 s = second - 59; s <= second; s++) {
+            // 只统计最近一次记录及之前仍在窗口内的桶
+            if (s >= 0 && s <= last && last - s < 60) {
+                total += it.value()[s % 60];
+            }
+        }
+        m_gauges["classboard_timer_wakeups_per_minute"][QString("timer=\"%1\"").arg(it.key())] = total;
+    }
+
+    QString out;
+    auto header = [this, &out](const QString& name, const QString& fallbackType) {
+        QPair<QString, QString> desc = m_descriptions.value(name, qMakePair(fallbackType, QString()));
+        if (!desc.second.isEmpty()) {
+            out += "# HELP " + name + " " + desc.second + "\n";
+        }
+        out += "# TYPE " + name + " " + desc.first + "\n";
+    };
+
+    for (auto it = m_counters.constBegin(); it != m_counters.constEnd(); ++it) {
+        header(it.key(), "counter");
+        for (auto series = it.value().constBegin(); series != it.value().constEnd(); ++series) {
+            out += it.key() + joinLabels(series.key(), "") + " " + formatValue(series.value()) + "\n";
+        }
+    }
+
+    for (auto it = m_gauges.constBegin(); it != m_gauges.constEnd(); ++it) {
+        header(it.key(), "gauge");
+        for (auto series = it.value().constBegin(); series != it.value().constEnd(); ++series) {
+            out += it.key() + joinLabels(series.key(), "") + " " + formatValue(series.value()) + "\n";
+        }
+    }
+
+    for (auto it = m_histograms.constBegin(); it != m_histograms.constEnd(); ++it) {
+        const QVector<double>& bounds = bucketBounds(it.key());
+        header(it.key(), "histogram");
+        for (auto series = it.value().constBegin(); series != it.value().constEnd(); ++series) {
+            const Histogram& hist = series.value();
+            quint64 cumulative = 0;
+            for (int i = 0; i < bounds.size(); i++) {
+                cumulative += hist.buckets.value(i);
+                out += it.key() + "_bucket" + joinLabels(series.key(), QString("le=\"%1\"").arg(formatValue(bounds[i])))
+                       + " " + QString::number(cumulative) + "\n";
+            }
+            out += it.key() + "_bucket" + joinLabels(series.key(), "le=\"+Inf\"") + " " + QString::number(hist.count) + "\n";
+            out += it.key() + "_sum" + joinLabels(series.key(), "") + " " + formatValue(hist.sum) + "\n";
+            out += it.key() + "_count" + joinLabels(series.key(), "") + " " + QString::number(hist.count) + "\n";
+        }
+    }
+
+    return out.toUtf8();
+}
+
+qint64 MetricsRegistry::processResidentBytes()
+{
+#if defined(Q_OS_LINUX)
+    // /proc/self/statm 第二列为常驻页数
+    QFile statm("/proc/self/statm");
+    if (statm.open(QIODevice::ReadOnly)) {
+        QList<QByteArray> fields = statm.readAll().split(' ');
+        if (fields.size() > 1) {
+            return fields[1].toLongLong() * sysconf(_SC_PAGESIZE);
+        }
+    }
+    return 0;
+#elif defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<qint64>(counters.WorkingSetSize);
+    }
+    return 0;
+#else
+    return 0;
+#endif
+}
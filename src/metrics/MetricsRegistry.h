@@ -0,0 +1,88 @@
+#ifndef METRICSREGISTRY_H
+#define METRICSREGISTRY_H
+
+#include <QObject>
+#include <QMutex>
+#include <QMap>
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+#include <QElapsedTimer>
+
+// 运行指标注册表（单例，线程安全）
+// 各模块写入计数器/仪表/直方图，MetricsServer 在独立线程中按Prometheus文本格式输出
+// 标签字符串使用Prometheus语法，例如 method="getCurrentCourse"
+class MetricsRegistry : public QObject
+{
+    Q_OBJECT
+public:
+    static MetricsRegistry& instance();
+    ~MetricsRegistry();
+
+    // 计数器累加
+    void incrementCounter(const QString& name, double value = 1.0, const QString& labels = "");
+    // 仪表设置
+    void setGauge(const QString& name, double value, const QString& labels = "");
+    // 直方图记录（单位：秒或字节，由指标名决定）
+    void observe(const QString& name, double value, const QString& labels = "");
+    // 定时器唤醒记录（同时统计总数与最近一分钟唤醒次数）
+    void recordTimerWakeup(const QString& timerName);
+
+    // 输出Prometheus文本格式
+    QByteArray renderPrometheus();
+
+    // 当前进程常驻内存（字节，不支持的平台返回0）
+    static qint64 processResidentBytes();
+
+private:
+    MetricsRegistry(QObject* parent = nullptr);
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    struct Histogram
+    {
+        QVector<quint64> buckets; // 各上界的非累计计数
+        double sum = 0.0;
+        quint64 count = 0;
+    };
+
+    // 指标说明（HELP/TYPE）
+    void describe(const QString& name, const QString& type, const QString& help);
+    const QVector<double>& bucketBounds(const QString& name) const;
+    static QString joinLabels(const QString& labels, const QString& extra);
+    static QString formatValue(double value);
+
+    QMutex m_mutex;
+    QMap<QString, QMap<QString, double>> m_counters;        // 指标名 -> 标签 -> 值
+    QMap<QString, QMap<QString, double>> m_gauges;
+    QMap<QString, QMap<QString, Histogram>> m_histograms;
+    QHash<QString, QPair<QString, QString>> m_descriptions;  // 指标名 -> (类型, 说明)
+
+    // 最近一分钟定时器唤醒（60个1秒桶的环形缓冲）
+    QHash<QString, QVector<quint32>> m_wakeupBuckets;
+    QHash<QString, qint64> m_wakeupLastSecond;
+    QElapsedTimer m_uptime;
+
+    QVector<double> m_latencyBounds; // 耗时类直方图上界（秒）
+    QVector<double> m_sizeBounds;    // 字节类直方图上界
+};
+
+// 作用域耗时记录：析构时将耗时（秒）写入直方图
+class ScopedMetricsTimer
+{
+public:
+    ScopedMetricsTimer(const QString& name, const QString& labels = "")
+        : m_name(name), m_labels(labels) { m_timer.start(); }
+    ~ScopedMetricsTimer()
+    {
+        MetricsRegistry::instance().observe(m_name, m_timer.nsecsElapsed() / 1e9, m_labels);
+    }
+
+private:
+    QString m_name;
+    QString m_labels;
+    QElapsedTimer m_timer;
+};
+
+#endif // METRICSREGISTRY_H
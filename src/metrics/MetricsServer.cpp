@@ -0,0 +1,115 @@
+#include "MetricsServer.h"
+#include "MetricsRegistry.h"
+
+// -------------------------- 监听器 --------------------------
+MetricsHttpListener::MetricsHttpListener(const QHostAddress& address, quint16 port)
+    : QObject(nullptr)
+    , m_address(address)
+    , m_port(port)
+{
+}
+
+void MetricsHttpListener::listen()
+{
+    // QTcpServer在监听线程内创建，连接与读写均不经过UI线程
+    m_server = new QTcpServer(this);
+    connect(m_server, &QTcpServer::newConnection, this, &MetricsHttpListener::onNewConnection);
+
+    if (!m_server->listen(m_address, m_port)) {
+        writeLog("ERROR", "指标服务监听失败：" + m_server->errorString(), "METRICS");
+        return;
+    }
+    writeLog("INFO", QString("指标服务已启动：http://%1:%2/metrics").arg(m_address.toString()).arg(m_port), "METRICS");
+}
+
+void MetricsHttpListener::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, &MetricsHttpListener::onReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_buffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MetricsHttpListener::onReadyRead()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket) return;
+
+    QByteArray& buffer = m_buffers[socket];
+    buffer.append(socket->readAll());
+
+    // 请求头过大视为异常连接
+    if (buffer.size() > 8192) {
+        socket->abort();
+        return;
+    }
+
+    if (!buffer.contains("\r\n\r\n")) {
+        return;
+    }
+
+    QList<QByteArray> parts = buffer.left(buffer.indexOf("\r\n")).split(' ');
+    buffer.clear();
+
+    if (parts.size() < 2 || parts[0] != "GET") {
+        writeResponse(socket, 405, "Method Not Allowed", "text/plain", "only GET is supported\n");
+        return;
+    }
+
+    QByteArray path = parts[1];
+    if (path == "/metrics" || path.startsWith("/metrics?")) {
+        writeResponse(socket, 200, "OK", "text/plain; version=0.0.4",
+                      MetricsRegistry::instance().renderPrometheus());
+    } else {
+        writeResponse(socket, 404, "Not Found", "text/plain", "see /metrics\n");
+    }
+}
+
+void MetricsHttpListener::writeResponse(QTcpSocket* socket, int status, const QByteArray& reason,
+                                        const QByteArray& contentType, const QByteArray& body)
+{
+    QByteArray header;
+    header += "HTTP/1.1 " + QByteArray::number(status) + " " + reason + "\r\n";
+    header += "Content-Type: " + contentType + "; charset=utf-8\r\n";
+    header += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    header += "Connection: close\r\n\r\n";
+
+    socket->write(header);
+    socket->write(body);
+    socket->disconnectFromHost();
+}
+
+// -------------------------- 服务 --------------------------
+MetricsServer::MetricsServer(const QString& bindAddress, quint16 port, QObject *parent)
+    : QObject(parent)
+{
+    QHostAddress address(bindAddress);
+    if (address.isNull()) {
+        writeLog("WARNING", "指标服务监听地址无效，改用127.0.0.1：" + bindAddress, "METRICS");
+        address = QHostAddress::LocalHost;
+    }
+
+    m_thread = new QThread(this);
+    m_thread->setObjectName("MetricsServer");
+    m_listener = new MetricsHttpListener(address, port);
+    m_listener->moveToThread(m_thread);
+    connect(m_thread, &QThread::started, m_listener, &MetricsHttpListener::listen);
+    connect(m_thread, &QThread::finished, m_listener, &QObject::deleteLater);
+}
+
+MetricsServer::~MetricsServer()
+{
+    m_thread->quit();
+    if (!m_thread->wait(3000)) {
+        m_thread->terminate();
+        writeLog("WARNING", "指标服务线程强制退出", "METRICS");
+    }
+}
+
+void MetricsServer::start()
+{
+    m_thread->start(QThread::LowPriority);
+}
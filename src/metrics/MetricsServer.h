@@ -0,0 +1,53 @@
+#ifndef METRICSSERVER_H
+#define METRICSSERVER_H
+
+#include <QObject>
+#include <QThread>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QHash>
+#include "utility/LogHelper.h" // 包含公共日志头文件
+
+// /metrics HTTP监听器（运行在MetricsServer的独立线程中）
+class MetricsHttpListener : public QObject
+{
+    Q_OBJECT
+public:
+    MetricsHttpListener(const QHostAddress& address, quint16 port);
+
+public slots:
+    void listen();
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+
+private:
+    void writeResponse(QTcpSocket* socket, int status, const QByteArray& reason,
+                       const QByteArray& contentType, const QByteArray& body);
+
+    QHostAddress m_address;
+    quint16 m_port;
+    QTcpServer* m_server = nullptr;
+    QHash<QTcpSocket*, QByteArray> m_buffers;
+};
+
+// 内嵌Prometheus指标服务（可选，默认关闭）
+// 监听线程独立于UI线程，采集时只读取线程安全的 MetricsRegistry
+class MetricsServer : public QObject
+{
+    Q_OBJECT
+public:
+    MetricsServer(const QString& bindAddress, quint16 port, QObject *parent = nullptr);
+    ~MetricsServer();
+
+    // 启动监听线程
+    void start();
+
+private:
+    QThread* m_thread;                 // 监听线程
+    MetricsHttpListener* m_listener;   // 监听器（属于监听线程）
+};
+
+#endif // METRICSSERVER_H
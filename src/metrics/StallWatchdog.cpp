@@ -0,0 +1,83 @@
+#include "StallWatchdog.h"
+#include "Tracer.h"
+#include "MetricsRegistry.h"
+
+StallWatchdog::StallWatchdog(int thresholdMs, const QString& traceFile, QObject *parent)
+    : QObject(parent)
+    , m_thresholdMs(qMax(50, thresholdMs))
+    , m_traceFile(traceFile)
+{
+    m_heartbeatTimer = new QTimer(this);
+    m_heartbeatTimer->setInterval(qMax(10, m_thresholdMs / 5));
+    connect(m_heartbeatTimer, &QTimer::timeout, this, [this]() {
+        m_lastBeatUs = Tracer::instance().nowUs();
+    });
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    m_stopping = true;
+    if (m_monitorThread) {
+        m_monitorThread->wait(3000);
+        delete m_monitorThread;
+    }
+}
+
+void StallWatchdog::start()
+{
+    m_guiTid = Tracer::instance().currentThreadId();
+    m_lastBeatUs = Tracer::instance().nowUs();
+    m_heartbeatTimer->start();
+
+    m_monitorThread = QThread::create([this]() { monitorLoop(); });
+    m_monitorThread->setObjectName("StallWatchdog");
+    m_monitorThread->start(QThread::HighPriority);
+
+    writeLog("INFO", QString("界面卡顿看门狗已启动，阈值%1ms").arg(m_thresholdMs), "TRACE");
+}
+
+void StallWatchdog::monitorLoop()
+{
+    Tracer& tracer = Tracer::instance();
+    const qint64 thresholdUs = qint64(m_thresholdMs) * 1000;
+    const int checkIntervalMs = qMax(10, m_thresholdMs / 4);
+
+    bool inStall = false;
+    qint64 stallStartUs = 0;
+    QStringList stallSpans;
+
+    while (!m_stopping) {
+        QThread::msleep(checkIntervalMs);
+
+        const qint64 lastBeat = m_lastBeatUs;
+        const qint64 gapUs = tracer.nowUs() - lastBeat;
+
+        if (gapUs > thresholdUs) {
+            // 卡顿进行中：首次发现时记录GUI线程当前所在片段
+            if (!inStall) {
+                inStall = true;
+                stallStartUs = lastBeat;
+                stallSpans = tracer.activeSpans(m_guiTid);
+                writeLog("WARNING", QString("检测到界面卡顿（已持续%1ms），当前片段：%2")
+                         .arg(gapUs / 1000).arg(stallSpans.isEmpty() ? "未知" : stallSpans.join(" > ")), "TRACE");
+            }
+            continue;
+        }
+
+        if (inStall) {
+            // 心跳恢复：卡顿结束
+            inStall = false;
+            const qint64 durationUs = lastBeat - stallStartUs;
+            tracer.recordStall(m_guiTid, stallStartUs, durationUs, stallSpans);
+
+            MetricsRegistry::instance().incrementCounter("classboard_gui_stalls_total");
+            MetricsRegistry::instance().observe("classboard_gui_stall_seconds", durationUs / 1e6);
+            writeLog("WARNING", QString("界面卡顿结束，持续%1ms，片段：%2")
+                     .arg(durationUs / 1000).arg(stallSpans.isEmpty() ? "未知" : stallSpans.join(" > ")), "TRACE");
+
+            if (!m_traceFile.isEmpty() && !tracer.dumpChromeTrace(m_traceFile)) {
+                writeLog("ERROR", "追踪文件导出失败：" + m_traceFile, "TRACE");
+            }
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef STALLWATCHDOG_H
+#define STALLWATCHDOG_H
+
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QStringList>
+#include <atomic>
+#include "utility/LogHelper.h" // 包含公共日志头文件
+
+// 界面卡顿看门狗
+// GUI线程定时写入心跳，独立监控线程发现心跳超过阈值未更新即判定卡顿，
+// 记录卡顿时GUI线程正在执行的追踪片段（见 Tracer），卡顿结束后写入日志、指标并导出追踪文件
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+public:
+    // thresholdMs：卡顿判定阈值；traceFile：卡顿结束后导出的trace_event文件（为空则不导出）
+    StallWatchdog(int thresholdMs, const QString& traceFile, QObject *parent = nullptr);
+    ~StallWatchdog();
+
+    // 启动看门狗（须在GUI线程调用）
+    void start();
+
+private:
+    void monitorLoop();
+
+    QTimer* m_heartbeatTimer;          // GUI线程心跳
+    QThread* m_monitorThread = nullptr; // 监控线程
+    int m_thresholdMs;
+    QString m_traceFile;
+    int m_guiTid = 0;                  // GUI线程的追踪线程号
+    std::atomic<qint64> m_lastBeatUs{0};
+    std::atomic<bool> m_stopping{false};
+};
+
+#endif // STALLWATCHDOG_H
@@ -0,0 +1,165 @@
+#include "Tracer.h"
+#include <QMutexLocker>
+#include <QCoreApplication>
+#include <QThread>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonObject>
+
+// 环形缓冲容量（约10万个事件，超出后覆盖最旧的记录）
+static const int kTraceCapacity = 100000;
+
+// 每个线程的追踪线程号（0表示尚未分配）
+static thread_local int t_traceTid = 0;
+
+Tracer& Tracer::instance()
+{
+    static Tracer instance;
+    return instance;
+}
+
+Tracer::Tracer(QObject* parent) : QObject(parent)
+{
+    m_clock.start();
+    m_events.resize(kTraceCapacity);
+}
+
+int Tracer::currentThreadId()
+{
+    if (t_traceTid != 0) {
+        return t_traceTid;
+    }
+
+    QThread* thread = QThread::currentThread();
+    QString name = thread->objectName();
+    if (QCoreApplication::instance() && thread == QCoreApplication::instance()->thread()) {
+        name = "GUI/main";
+    }
+
+    QMutexLocker locker(&m_mutex);
+    t_traceTid = m_nextTid++;
+    m_threadNames.insert(t_traceTid, name.isEmpty() ? QString("thread-%1").arg(t_traceTid) : name);
+    return t_traceTid;
+}
+
+void Tracer::beginSpan(const char* name)
+{
+    int tid = currentThreadId();
+    qint64 ts = nowUs();
+
+    QMutexLocker locker(&m_mutex);
+    m_stacks[tid].append({name, ts});
+}
+
+void Tracer::endSpan()
+{
+    int tid = currentThreadId();
+    qint64 ts = nowUs();
+
+    QMutexLocker locker(&m_mutex);
+    QVector<OpenSpan>& stack = m_stacks[tid];
+    if (stack.isEmpty()) {
+        return;
+    }
+
+    OpenSpan span = stack.takeLast();
+    TraceEvent event;
+    event.name = span.name;
+    event.phase = 'X';
+    event.tsUs = span.startUs;
+    event.durUs = ts - span.startUs;
+    event.tid = tid;
+    appendEvent(event);
+}
+
+QStringList Tracer::activeSpans(int tid)
+{
+    QStringList names;
+    QMutexLocker locker(&m_mutex);
+    for (const OpenSpan& span : m_stacks.value(tid)) {
+        names.append(QString::fromUtf8(span.name));
+    }
+    return names;
+}
+
+void Tracer::recordStall(int tid, qint64 startUs, qint64 durationUs, const QStringList& spans)
+{
+    QJsonObject args;
+    args["duration_ms"] = durationUs / 1000.0;
+    args["stack"] = QJsonArray::fromStringList(spans);
+
+    TraceEvent event;
+    event.name = "stall";
+    event.phase = 'X';
+    event.tsUs = startUs;
+    event.durUs = durationUs;
+    event.tid = tid;
+    event.args = QString::fromUtf8(QJsonDocument(args).toJson(QJsonDocument::Compact));
+
+    QMutexLocker locker(&m_mutex);
+    appendEvent(event);
+}
+
+// 调用方需持有 m_mutex
+void Tracer::appendEvent(const TraceEvent& event)
+{
+    m_events[m_nextEvent] = event;
+    m_nextEvent++;
+    if (m_nextEvent >= kTraceCapacity) {
+        m_nextEvent = 0;
+        m_wrapped = true;
+    }
+}
+
+bool Tracer::dumpChromeTrace(const QString& filePath)
+{
+    QJsonArray traceEvents;
+    const qint64 pid = QCoreApplication::applicationPid();
+
+    {
+        QMutexLocker locker(&m_mutex);
+
+        // 线程名元数据
+        for (auto it = m_threadNames.constBegin(); it != m_threadNames.constEnd(); ++it) {
+            QJsonObject meta;
+            meta["name"] = "thread_name";
+            meta["ph"] = "M";
+            meta["pid"] = pid;
+            meta["tid"] = it.key();
+            meta["args"] = QJsonObject{{"name", it.value()}};
+            traceEvents.append(meta);
+        }
+
+        // 按时间顺序输出环形缓冲
+        int count = m_wrapped ? kTraceCapacity : m_nextEvent;
+        int first = m_wrapped ? m_nextEvent : 0;
+        for (int i = 0; i < count; i++) {
+            const TraceEvent& event = m_events[(first + i) % kTraceCapacity];
+            QJsonObject obj;
+            obj["name"] = QString::fromUtf8(event.name);
+            obj["cat"] = QString(event.name).section('.', 0, 0);
+            obj["ph"] = QString(QChar(event.phase));
+            obj["ts"] = event.tsUs;
+            obj["dur"] = event.durUs;
+            obj["pid"] = pid;
+            obj["tid"] = event.tid;
+            if (!event.args.isEmpty()) {
+                obj["args"] = QJsonDocument::fromJson(event.args.toUtf8()).object();
+            }
+            traceEvents.append(obj);
+        }
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    file.close();
+    return true;
+}
@@ -0,0 +1,97 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QObject>
+#include <QMutex>
+#include <QHash>
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+#include "metrics/MetricsRegistry.h"
+
+// 追踪记录器（单例，线程安全）
+// 记录作用域追踪片段与卡顿事件，可导出Chrome trace_event JSON（chrome://tracing / Perfetto 打开）
+class Tracer : public QObject
+{
+    Q_OBJECT
+public:
+    static Tracer& instance();
+    ~Tracer() = default;
+
+    // 片段开始/结束（name 必须为静态字符串）
+    void beginSpan(const char* name);
+    void endSpan();
+
+    // 当前线程的追踪线程号
+    int currentThreadId();
+    // 指定线程当前未结束的片段（外层在前）
+    QStringList activeSpans(int tid);
+
+    // 记录卡顿事件（起始时间为单调时钟微秒）
+    void recordStall(int tid, qint64 startUs, qint64 durationUs, const QStringList& spans);
+
+    // 单调时钟（微秒，进程内统一时间轴）
+    qint64 nowUs() const { return m_clock.nsecsElapsed() / 1000; }
+
+    // 导出Chrome trace_event JSON
+    bool dumpChromeTrace(const QString& filePath);
+
+private:
+    Tracer(QObject* parent = nullptr);
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    struct OpenSpan
+    {
+        const char* name;
+        qint64 startUs;
+    };
+
+    struct TraceEvent
+    {
+        const char* name = nullptr;
+        char phase = 'X';       // X=完整片段，i=瞬时事件
+        qint64 tsUs = 0;
+        qint64 durUs = 0;
+        int tid = 0;
+        QString args;           // 附加参数（JSON对象文本）
+    };
+
+    void appendEvent(const TraceEvent& event);
+
+    QMutex m_mutex;
+    QElapsedTimer m_clock;
+    QHash<int, QVector<OpenSpan>> m_stacks;   // 线程号 -> 未结束片段
+    QHash<int, QString> m_threadNames;        // 线程号 -> 线程名
+    QVector<TraceEvent> m_events;             // 环形缓冲
+    int m_nextEvent = 0;
+    bool m_wrapped = false;
+    int m_nextTid = 1;
+};
+
+// 作用域追踪片段
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char* name) { Tracer::instance().beginSpan(name); }
+    ~TraceSpan() { Tracer::instance().endSpan(); }
+};
+
+#define CB_TRACE_CONCAT_INNER(a, b) a##b
+#define CB_TRACE_CONCAT(a, b) CB_TRACE_CONCAT_INNER(a, b)
+
+// 追踪宏：Debug构建或 CONFIG+=trace 时生效，其余Release构建中完全移除
+#ifdef CLASSBOARD_TRACE
+#define CB_TRACE_SPAN(name) TraceSpan CB_TRACE_CONCAT(traceSpan_, __LINE__)(name)
+#else
+#define CB_TRACE_SPAN(name) do {} while (0)
+#endif
+
+// 数据库方法入口（name 为字符串字面量）：耗时记入 classboard_db_query_duration_seconds{method="name"}，
+// 同时开启追踪片段 db.name
+#define CB_DB_METHOD(name) \
+    ScopedMetricsTimer CB_TRACE_CONCAT(dbMethodTimer_, __LINE__)("classboard_db_query_duration_seconds", "method=\"" name "\""); \
+    CB_TRACE_SPAN("db." name)
+
+#endif // TRACER_H
@@ -1,8 +1,26 @@
 #include "NetworkWorker.h"
 // 新增：包含教室管理相关逻辑（需要通过教室名称查ID）
 #include "data/DatabaseManager.h"
+#include "data/ConflictAnalyzer.h"
+#include "metrics/MetricsRegistry.h"
+#include "metrics/Tracer.h"
+#include "utility/WeekMask.h"
+#include "utility/Clock.h"
 #include <QJsonArray>
 #include <QJsonObject>
+#include <QUrlQuery>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+// 紧急通知长轮询：请求服务器最长挂起时间（秒）与失败重试间隔上限（毫秒）
+static const int kUrgentHoldSecs = 25;
+static const int kUrgentMaxBackoffMs = 30000;
+
+// 快照下载：读缓冲上限（边收边写盘，内存占用与快照大小无关）与无数据超时
+static const qint64 kSnapshotReadBufferBytes = 1024 * 1024;
+static const int kSnapshotTransferTimeoutMs = 30000;
 
 NetworkWorker::NetworkWorker(QObject *parent) : QObject(parent)
 {
@@ -21,6 +39,17 @@ NetworkWorker::NetworkWorker(QObject *parent) : QObject(parent)
     connect(m_syncTimer, &QTimer::timeout, this, &NetworkWorker::onSyncTimerTimeout);
     connect(this, &NetworkWorker::startSyncTimer, m_syncTimer, QOverload<>::of(&QTimer::start));
 
+    // 紧急通知通道：挂起时间之外再留出网络余量
+    m_urgentManager = new QNetworkAccessManager(this);
+    m_urgentManager->setTransferTimeout((kUrgentHoldSecs + 10) * 1000);
+    connect(m_urgentManager, &QNetworkAccessManager::finished, this, &NetworkWorker::onUrgentReplyFinished);
+    connect(this, &NetworkWorker::startUrgentChannel, this, &NetworkWorker::pollUrgent);
+
+    // 快照开通：随同步定时器启动检查一次，不必等待第一个同步周期
+    m_snapshotManager = new QNetworkAccessManager(this);
+    m_snapshotManager->setTransferTimeout(kSnapshotTransferTimeoutMs);
+    connect(this, &NetworkWorker::startSyncTimer, this, &NetworkWorker::provisionIfNeeded);
+
     // 从设置管理器获取服务器地址
     m_serverUrl = SettingsManager::instance().getServerUrl();
     writeLog("INFO", "网络模块初始化成功，服务器地址：" + m_serverUrl, "NETWORK");
@@ -47,6 +76,20 @@ void NetworkWorker::triggerSync()
 
 // 定时同步任务
 void NetworkWorker::onSyncTimerTimeout()
+{
+    CB_TRACE_SPAN("sync.request");
+    MetricsRegistry::instance().recordTimerWakeup("sync");
+
+    // 快照下载中，替换完成后自行发起增量同步
+    if (m_snapshotReply) {
+        return;
+    }
+    m_syncClock.start();
+    requestSync();
+}
+
+// 发送同步请求
+void NetworkWorker::requestSync()
 {
     // 更新服务器地址（可能已修改）
     m_serverUrl = SettingsManager::instance().getServerUrl();
@@ -60,11 +103,13 @@ void NetworkWorker::onSyncTimerTimeout()
 // 处理网络响应
 void NetworkWorker::onReplyFinished(QNetworkReply* reply)
 {
+    CB_TRACE_SPAN("sync.reply");
     static int retryCount = 0; // 重试计数器
 
     if (reply->error() != QNetworkReply::NoError) {
         QString errMsg = QString("网络请求失败：%1").arg(reply->errorString());
         writeLog("ERROR", errMsg, "NETWORK");
+        MetricsRegistry::instance().incrementCounter("classboard_sync_total", 1, "result=\"network_error\"");
 
         // 断网重试（最多2次）
         if (retryCount < 2) {
@@ -87,18 +132,245 @@ void NetworkWorker::onReplyFinished(QNetworkReply* reply)
     QByteArray jsonData = reply->readAll();
     reply->deleteLater();
     writeLog("INFO", "收到服务器响应，数据长度：" + QString::number(jsonData.size()), "NETWORK");
+    MetricsRegistry::instance().observe("classboard_sync_bytes", jsonData.size());
 
-    // 解析并同步到数据库
-    parseAndSyncData(jsonData);
+    // 解析并同步到数据库（失败时已发出 syncFailed）
+    if (!parseAndSyncData(jsonData)) {
+        return;
+    }
+
+    // 新数据落库后在线程池中检测教师/教室冲突
+    ConflictAnalyzer::instance().analyzeAsync();
 
     emit syncSuccess("数据同步成功！");
     writeLog("INFO", "数据同步完成", "NETWORK");
 }
 
+// -------------------------- 快照开通 --------------------------
+void NetworkWorker::provisionIfNeeded()
+{
+    // 已有数据版本（同步过或已由快照开通）的板卡只做增量同步
+    if (m_snapshotReply || !SettingsManager::instance().isSnapshotProvisionEnabled()
+        || DatabaseManager::instance().getSyncRevision() > 0) {
+        return;
+    }
+
+    // 快照写在数据库同目录，替换时为同一文件系统内的原子改名
+    const QString snapshotPath = DatabaseManager::instance().getDb().databaseName() + ".snapshot";
+    m_snapshotFile = new QFile(snapshotPath, this);
+    if (!m_snapshotFile->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        writeLog("WARNING", "无法创建快照文件，改为全量同步：" + m_snapshotFile->errorString(), "NETWORK");
+        delete m_snapshotFile;
+        m_snapshotFile = nullptr;
+        return;
+    }
+    m_snapshotHash.reset();
+    m_provisionClock.start();
+
+    const QString snapshotUrl = SettingsManager::instance().getSnapshotUrl();
+    QNetworkRequest request{QUrl(snapshotUrl)};
+    request.setRawHeader("User-Agent", "ClassBoardSystem/1.0 (Qt 6.9.2)");
+    request.setRawHeader("Accept", "application/vnd.sqlite3");
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+
+    m_snapshotReply = m_snapshotManager->get(request);
+    m_snapshotReply->setReadBufferSize(kSnapshotReadBufferBytes);
+    connect(m_snapshotReply, &QNetworkReply::readyRead, this, &NetworkWorker::onSnapshotReadyRead);
+    connect(m_snapshotReply, &QNetworkReply::finished, this, &NetworkWorker::onSnapshotFinished);
+    writeLog("INFO", "新板卡开通：下载数据库快照 " + snapshotUrl, "NETWORK");
+}
+
+void NetworkWorker::onSnapshotReadyRead()
+{
+    if (!m_snapshotReply || !m_snapshotFile) {
+        return;
+    }
+
+    const QByteArray chunk = m_snapshotReply->readAll();
+    m_snapshotHash.addData(chunk);
+    if (m_snapshotFile->write(chunk) != chunk.size()) {
+        writeLog("ERROR", "写入快照文件失败：" + m_snapshotFile->errorString(), "NETWORK");
+        m_snapshotReply->abort();
+    }
+}
+
+void NetworkWorker::onSnapshotFinished()
+{
+    CB_TRACE_SPAN("sync.snapshot");
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+
+    // 取走缓冲中剩余的数据
+    onSnapshotReadyRead();
+    QNetworkReply* reply = m_snapshotReply;
+    m_snapshotReply = nullptr;
+    reply->deleteLater();
+
+    QString errMsg;
+    if (reply->error() != QNetworkReply::NoError) {
+        errMsg = reply->errorString();
+    } else {
+        const QByteArray expected = reply->rawHeader("X-Snapshot-SHA256").trimmed().toLower();
+        if (expected.isEmpty()) {
+            errMsg = "服务器未提供快照校验和";
+        } else if (expected != m_snapshotHash.result().toHex()) {
+            errMsg = "快照校验和不一致";
+        } else if (!m_snapshotFile->flush()) {
+            errMsg = "快照写盘失败：" + m_snapshotFile->errorString();
+        }
+    }
+
+#ifdef Q_OS_UNIX
+    // 替换后即成为正式数据库，改名前先落盘，避免掉电后留下内容不完整的库文件
+    if (errMsg.isEmpty()) {
+        ::fsync(m_snapshotFile->handle());
+    }
+#endif
+    const qint64 bytes = m_snapshotFile->size();
+    const QString snapshotPath = m_snapshotFile->fileName();
+    m_snapshotFile->close();
+    delete m_snapshotFile;
+    m_snapshotFile = nullptr;
+
+    bool provisioned = false;
+    if (errMsg.isEmpty()) {
+        // 替换会关闭主连接，须在 DatabaseManager 所在线程执行，期间界面不会并发查询
+        const qint64 revision = reply->rawHeader("X-Snapshot-Revision").toLongLong();
+        DatabaseManager& db = DatabaseManager::instance();
+        QMetaObject::invokeMethod(&db, [&db, &provisioned, snapshotPath, revision]() {
+            provisioned = db.replaceWithSnapshot(snapshotPath, revision);
+        }, db.thread() == QThread::currentThread() ? Qt::DirectConnection : Qt::BlockingQueuedConnection);
+        if (!provisioned) {
+            errMsg = "快照未通过校验或替换失败";
+        }
+    }
+    // 替换成功时快照已改名为数据库文件，这里只清理失败留下的文件
+    QFile::remove(snapshotPath);
+
+    if (provisioned) {
+        metrics.incrementCounter("classboard_provision_total", 1, "result=\"snapshot\"");
+        metrics.observe("classboard_snapshot_bytes", bytes);
+        metrics.observe("classboard_provision_seconds", m_provisionClock.nsecsElapsed() / 1e9);
+        writeLog("INFO", QString("已由数据库快照开通（%1KB，耗时%2秒），开始增量同步")
+                             .arg(bytes / 1024).arg(m_provisionClock.nsecsElapsed() / 1e9, 0, 'f', 2), "NETWORK");
+        emit syncSuccess("已由数据库快照开通");
+    } else {
+        metrics.incrementCounter("classboard_provision_total", 1, "result=\"fallback\"");
+        writeLog("WARNING", "快照开通失败，改为全量同步：" + errMsg, "NETWORK");
+    }
+
+    // 由同步接手：开通成功时只拉取快照版本之后的变化，失败时为全量同步
+    m_syncClock.start();
+    requestSync();
+}
+
+// -------------------------- 紧急通知通道 --------------------------
+void NetworkWorker::pollUrgent()
+{
+    if (m_urgentReply || !SettingsManager::instance().isUrgentChannelEnabled()) {
+        return;
+    }
+
+    QUrl url(SettingsManager::instance().getUrgentUrl());
+    QUrlQuery query;
+    if (m_urgentCursor >= 0) {
+        query.addQueryItem("since", QString::number(m_urgentCursor));
+    }
+    query.addQueryItem("timeout", QString::number(kUrgentHoldSecs));
+    url.setQuery(query);
+
+    QNetworkRequest request(url);
+    request.setRawHeader("User-Agent", "ClassBoardSystem/1.0 (Qt 6.9.2)");
+    request.setRawHeader("Accept", "application/json");
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    m_urgentReply = m_urgentManager->get(request);
+}
+
+void NetworkWorker::onUrgentReplyFinished(QNetworkReply* reply)
+{
+    CB_TRACE_SPAN("urgent.reply");
+    m_urgentReply = nullptr;
+    reply->deleteLater();
+
+    QJsonArray notices;
+    qint64 cursor = m_urgentCursor;
+    QString errMsg;
+    if (reply->error() != QNetworkReply::NoError) {
+        errMsg = reply->errorString();
+    } else {
+        parseUrgentPayload(reply->readAll(), notices, cursor, errMsg);
+    }
+
+    if (!errMsg.isEmpty()) {
+        // 服务器不可用时按指数退避重试，避免空转
+        m_urgentBackoffMs = m_urgentBackoffMs > 0 ? qMin(m_urgentBackoffMs * 2, kUrgentMaxBackoffMs) : 1000;
+        writeLog("WARNING", QString("紧急通知通道异常：%1，%2毫秒后重试").arg(errMsg).arg(m_urgentBackoffMs), "NETWORK");
+        QTimer::singleShot(m_urgentBackoffMs, this, &NetworkWorker::pollUrgent);
+        return;
+    }
+    m_urgentBackoffMs = 0;
+
+    const QDateTime now = Clock::currentDateTime();
+    for (const QJsonValue& val : notices) {
+        QJsonObject obj = val.toObject();
+        QString title = obj["title"].toString();
+        QString content = obj["content"].toString();
+        QString publishTime = obj["publish_time"].toString();
+        QString expireTime = obj["expire_time"].toString();
+        if (publishTime.isEmpty()) {
+            publishTime = now.toString("yyyy-MM-dd HH:mm:ss");
+        }
+        if (expireTime.isEmpty()) {
+            expireTime = now.date().toString("yyyy-MM-dd");
+        }
+
+        // 先推送界面再落库，显示不等待数据库写入
+        emit urgentNoticeReceived(title, content);
+        DatabaseManager::instance().addNotice(title, content, publishTime, expireTime, true);
+
+        MetricsRegistry::instance().incrementCounter("classboard_urgent_notices_total");
+        if (obj.contains("sent_at_ms")) {
+            const qint64 latencyMs = QDateTime::currentMSecsSinceEpoch() - obj["sent_at_ms"].toVariant().toLongLong();
+            MetricsRegistry::instance().observe("classboard_urgent_latency_seconds", qMax<qint64>(0, latencyMs) / 1000.0);
+        }
+        writeLog("INFO", "收到紧急通知：" + title, "NETWORK");
+    }
+
+    m_urgentCursor = cursor;
+    QTimer::singleShot(0, this, &NetworkWorker::pollUrgent);
+}
+
+bool NetworkWorker::parseUrgentPayload(const QByteArray& jsonData, QJsonArray& notices, qint64& cursor, QString& errMsg)
+{
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(jsonData, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        errMsg = "紧急通知解析失败：" + parseError.errorString();
+        return false;
+    }
+
+    QJsonObject root = doc.object();
+    if (root["code"].toInt() != 200 || !root.contains("cursor")) {
+        errMsg = "紧急通知响应无效：" + root["msg"].toString();
+        return false;
+    }
+
+    notices = root["notices"].toArray();
+    cursor = root["cursor"].toVariant().toLongLong();
+    return true;
+}
+
 // 构建网络请求
 QNetworkRequest NetworkWorker::buildRequest()
 {
     QUrl url(m_serverUrl);
+    // 已有数据版本时只请求该版本之后的变化（增量同步）
+    const qint64 revision = DatabaseManager::instance().getSyncRevision();
+    if (revision > 0) {
+        QUrlQuery query(url);
+        query.removeAllQueryItems("since");
+        query.addQueryItem("since", QString::number(revision));
+        url.setQuery(query);
+    }
     QNetworkRequest request(url); // 正确创建QNetworkRequest对象
 
     // 设置请求头
@@ -139,30 +411,85 @@ int NetworkWorker::getClassroomIdByName(const QString& classroomName)
 }
 
 // 解析JSON并同步到本地数据库
-void NetworkWorker::parseAndSyncData(const QByteArray& jsonData)
+bool NetworkWorker::parseAndSyncData(const QByteArray& jsonData)
+{
+    MetricsRegistry& metrics = MetricsRegistry::instance();
+
+    QElapsedTimer stageTimer;
+    stageTimer.start();
+    QJsonObject root;
+    QString errMsg;
+    bool parsed = false;
+    {
+        CB_TRACE_SPAN("sync.parse");
+        parsed = parseSyncPayload(jsonData, root, errMsg);
+    }
+    metrics.observe("classboard_sync_parse_seconds", stageTimer.nsecsElapsed() / 1e9);
+
+    if (!parsed) {
+        writeLog("ERROR", errMsg, "NETWORK");
+        metrics.incrementCounter("classboard_sync_total", 1, "result=\"parse_error\"");
+        emit syncFailed(errMsg);
+        return false;
+    }
+
+    stageTimer.restart();
+    bool applied = false;
+    {
+        CB_TRACE_SPAN("sync.apply");
+        applied = applySyncData(root, errMsg);
+    }
+    metrics.observe("classboard_sync_apply_seconds", stageTimer.nsecsElapsed() / 1e9);
+
+    if (!applied) {
+        writeLog("ERROR", errMsg, "NETWORK");
+        metrics.incrementCounter("classboard_sync_total", 1, "result=\"apply_error\"");
+        emit syncFailed(errMsg);
+        return false;
+    }
+
+    metrics.incrementCounter("classboard_sync_total", 1, "result=\"success\"");
+    if (m_syncClock.isValid()) {
+        metrics.observe("classboard_sync_duration_seconds", m_syncClock.nsecsElapsed() / 1e9);
+        m_syncClock.invalidate();
+    }
+    return true;
+}
+
+// 解析同步报文（校验JSON格式与业务状态码）
+bool NetworkWorker::parseSyncPayload(const QByteArray& jsonData, QJsonObject& root, QString& errMsg)
 {
     QJsonParseError parseError;
     QJsonDocument doc = QJsonDocument::fromJson(jsonData, &parseError);
 
     if (parseError.error != QJsonParseError::NoError) {
-        QString errMsg = QString("JSON解析失败：%1").arg(parseError.errorString());
-        writeLog("ERROR", errMsg, "NETWORK");
-        emit syncFailed(errMsg);
-        return;
+        errMsg = QString("JSON解析失败：%1").arg(parseError.errorString());
+        return false;
     }
 
     if (!doc.isObject()) {
-        writeLog("ERROR", "服务器返回非JSON对象", "NETWORK");
-        emit syncFailed("服务器返回数据格式错误（非JSON对象）");
-        return;
+        errMsg = "服务器返回数据格式错误（非JSON对象）";
+        return false;
     }
 
-    QJsonObject root = doc.object();
+    root = doc.object();
     if (root["code"].toInt() != 200) {
-        QString errMsg = QString("服务器返回错误：%1").arg(root["msg"].toString());
-        writeLog("ERROR", errMsg, "NETWORK");
-        emit syncFailed(errMsg);
-        return;
+        errMsg = QString("服务器返回错误：%1").arg(root["msg"].toString());
+        return false;
+    }
+
+    return true;
+}
+
+// 将同步数据写入本地数据库
+// 课程/通知按服务器端ID写入与删除，增量报文可重复应用；整份报文一个事务，任一行失败则整体回滚，
+// 数据版本仅在提交成功后前移（失败时下次同步重新拉取同一段变化）
+bool NetworkWorker::applySyncData(const QJsonObject& root, QString& errMsg)
+{
+    DatabaseManager& db = DatabaseManager::instance();
+    if (!db.beginSyncApply()) {
+        errMsg = "同步落库失败：无法开启事务";
+        return false;
     }
 
     // 解析班级数据
@@ -182,8 +509,10 @@ void NetworkWorker::parseAndSyncData(const QByteArray& jsonData)
     QJsonArray courseArray = root["courses"].toArray();
     writeLog("INFO", "解析课程数据，数量：" + QString::number(courseArray.size()), "NETWORK");
 
+    bool ok = true;
     for (const QJsonValue& val : courseArray) {
         QJsonObject obj = val.toObject();
+        int serverId = obj["id"].toInt();
         int classId = obj["class_id"].toInt();
         QString courseName = obj["course_name"].toString();
         QString teacher = obj["teacher"].toString();
@@ -194,30 +523,96 @@ void NetworkWorker::parseAndSyncData(const QByteArray& jsonData)
         QString startDate = obj["start_date"].toString();
         QString endDate = obj["end_date"].toString();
         QString classroomName = obj["classroom"].toString();
+        qint64 weekMask = WeekMask::fromJson(obj["weeks"]); // 上课周：位图或“1-8”“odd”等描述，缺省每周
 
         // 将教室名称转换为教室ID（通过辅助函数）
         int classroomId = getClassroomIdByName(classroomName);
 
-        DatabaseManager::instance().deleteCourse(obj["id"].toInt());
-        // 调用修改后的addCourse（最后一个参数改为classroomId）
-        DatabaseManager::instance().addCourse(classId, courseName, teacher, courseType,
-                                             startTime, endTime, dayOfWeek,
-                                             startDate, endDate, classroomId);
+        if (serverId <= 0 || !db.upsertCourse(serverId, classId, courseName, teacher, courseType,
+                                              startTime, endTime, dayOfWeek, startDate, endDate,
+                                              classroomId, weekMask)) {
+            errMsg = QString("课程落库失败（服务器ID：%1）").arg(serverId);
+            ok = false;
+            break;
+        }
+    }
+
+    // 解析校历例外（节假日停课/调休上课，removed=true 表示撤销该日例外）
+    QJsonArray calendarArray = root["calendar"].toArray();
+    if (ok) {
+        writeLog("INFO", "解析校历数据，数量：" + QString::number(calendarArray.size()), "NETWORK");
+    }
+
+    for (int i = 0; ok && i < calendarArray.size(); i++) {
+        QJsonObject obj = calendarArray[i].toObject();
+        QString date = obj["date"].toString();
+        if (obj["removed"].toBool()) {
+            ok = db.removeCalendarException(date);
+        } else {
+            DatabaseManager::CalendarDayKind kind = obj["kind"].toString() == "makeup"
+                    ? DatabaseManager::MakeupDay : DatabaseManager::Holiday;
+            ok = db.setCalendarException(date, kind, obj["as_day_of_week"].toInt(), obj["description"].toString());
+        }
+        if (!ok) {
+            errMsg = "校历落库失败：" + date;
+        }
     }
 
     // 解析通知数据
     QJsonArray noticeArray = root["notices"].toArray();
-    writeLog("INFO", "解析通知数据，数量：" + QString::number(noticeArray.size()), "NETWORK");
+    if (ok) {
+        writeLog("INFO", "解析通知数据，数量：" + QString::number(noticeArray.size()), "NETWORK");
+    }
 
-    for (const QJsonValue& val : noticeArray) {
-        QJsonObject obj = val.toObject();
+    for (int i = 0; ok && i < noticeArray.size(); i++) {
+        QJsonObject obj = noticeArray[i].toObject();
+        int serverId = obj["id"].toInt();
         QString title = obj["title"].toString();
         QString content = obj["content"].toString();
         QString publishTime = obj["publish_time"].toString();
         QString expireTime = obj["expire_time"].toString();
         bool isScrolling = obj["is_scrolling"].toBool();
 
-        DatabaseManager::instance().deleteNotice(obj["id"].toInt());
-        DatabaseManager::instance().addNotice(title, content, publishTime, expireTime, isScrolling);
+        ok = serverId > 0 && db.upsertNotice(serverId, title, content, publishTime, expireTime, isScrolling);
+        if (!ok) {
+            errMsg = QString("通知落库失败（服务器ID：%1）").arg(serverId);
+        }
+    }
+
+    // 服务器上已删除的课程/通知（增量报文：{"removed": {"courses": [ID...], "notices": [ID...]}}）
+    QJsonObject removed = root["removed"].toObject();
+    QJsonArray removedCourses = removed["courses"].toArray();
+    QJsonArray removedNotices = removed["notices"].toArray();
+    if (ok && (!removedCourses.isEmpty() || !removedNotices.isEmpty())) {
+        writeLog("INFO", QString("删除服务器已移除的课程：%1，通知：%2")
+                             .arg(removedCourses.size()).arg(removedNotices.size()), "NETWORK");
+    }
+
+    for (int i = 0; ok && i < removedCourses.size(); i++) {
+        ok = db.removeCourseByServerId(removedCourses[i].toInt());
+        if (!ok) {
+            errMsg = QString("课程删除失败（服务器ID：%1）").arg(removedCourses[i].toInt());
+        }
+    }
+    for (int i = 0; ok && i < removedNotices.size(); i++) {
+        ok = db.removeNoticeByServerId(removedNotices[i].toInt());
+        if (!ok) {
+            errMsg = QString("通知删除失败（服务器ID：%1）").arg(removedNotices[i].toInt());
+        }
+    }
+
+    if (!ok) {
+        db.rollbackSyncApply();
+        return false;
+    }
+    if (!db.commitSyncApply()) {
+        errMsg = "同步落库失败：事务提交失败";
+        return false;
+    }
+
+    // 记录报文对应的数据版本，下次同步由此增量
+    if (root.contains("revision")) {
+        db.setSyncRevision(root["revision"].toVariant().toLongLong());
     }
+    return true;
 }
@@ -13,6 +13,9 @@
 #include <QFile>
 #include <QTextStream>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QCryptographicHash>
 #include "data/DatabaseManager.h"
 #include "settings/SettingsManager.h"
 #include "utility/LogHelper.h" // 包含公共日志头文件
@@ -31,18 +34,41 @@ public:
     // 手动触发同步
     void triggerSync();
 
+    // 解析JSON并同步到本地数据库（公开供基准测试直接调用），失败时已发出 syncFailed 并返回false
+    bool parseAndSyncData(const QByteArray& jsonData);
+
+    // 解析同步报文（不落库），失败返回false并写入错误信息
+    static bool parseSyncPayload(const QByteArray& jsonData, QJsonObject& root, QString& errMsg);
+    // 将解析后的同步数据写入本地数据库（一个事务），失败时整体回滚并返回false、写入错误信息
+    static bool applySyncData(const QJsonObject& root, QString& errMsg);
+
+    // 解析紧急通知长轮询响应：notices 为新通知，cursor 为服务器最新游标
+    static bool parseUrgentPayload(const QByteArray& jsonData, QJsonArray& notices, qint64& cursor, QString& errMsg);
+
 signals:
     // 同步结果通知
     void syncSuccess(const QString& msg);
     void syncFailed(const QString& msg);
     // 内部信号：启动定时同步
     void startSyncTimer();
+    // 收到紧急通知（随后写入本地通知表）
+    void urgentNoticeReceived(const QString& title, const QString& content);
+    // 内部信号：启动紧急通知长轮询
+    void startUrgentChannel();
 
 private slots:
     // 定时同步任务
     void onSyncTimerTimeout();
     // 处理网络响应
     void onReplyFinished(QNetworkReply* reply);
+    // 紧急通知长轮询（与全量同步独立，收到响应后立即发起下一轮）
+    void pollUrgent();
+    void onUrgentReplyFinished(QNetworkReply* reply);
+    // 新板卡快照开通（从未同步时随定时同步启动一次）：流式写盘并计算校验和，
+    // 完成后校验、替换数据库，再从快照的数据版本开始增量同步；任一步失败退回全量同步
+    void provisionIfNeeded();
+    void onSnapshotReadyRead();
+    void onSnapshotFinished();
 
 private:
     QNetworkAccessManager* m_netManager; // 网络管理器
@@ -50,11 +76,23 @@ private:
     QTimer* m_syncTimer;                 // 同步定时器
     int m_syncInterval = 600;            // 默认10分钟
     QString m_serverUrl;                 // 服务器地址
+    QElapsedTimer m_syncClock;           // 本次同步计时（请求发出到落库完成）
+
+    QNetworkAccessManager* m_urgentManager; // 紧急通知长轮询专用（不与全量同步共用完成信号）
+    QPointer<QNetworkReply> m_urgentReply;  // 进行中的长轮询
+    qint64 m_urgentCursor = -1;             // 已收到的紧急通知游标（-1 表示尚未握手）
+    int m_urgentBackoffMs = 0;              // 失败重试间隔（成功后清零）
+
+    QNetworkAccessManager* m_snapshotManager; // 快照下载专用（不与全量同步共用完成信号）
+    QPointer<QNetworkReply> m_snapshotReply;  // 进行中的快照下载（期间不发起同步）
+    QFile* m_snapshotFile = nullptr;          // 下载中的快照文件（数据库同目录）
+    QCryptographicHash m_snapshotHash{QCryptographicHash::Sha256};
+    QElapsedTimer m_provisionClock;           // 快照开通计时（请求发出到替换完成）
 
     // 辅助函数
-    void parseAndSyncData(const QByteArray& jsonData);
     QNetworkRequest buildRequest();
-    int getClassroomIdByName(const QString& classroomName);
+    void requestSync();
+    static int getClassroomIdByName(const QString& classroomName);
 };
 
 #endif // NETWORKWORKER_H
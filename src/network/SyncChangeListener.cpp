@@ -0,0 +1,73 @@
+#include "SyncChangeListener.h"
+#include "SyncNotifier.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+
+SyncChangeListener::SyncChangeListener(QObject *parent) : QObject(parent)
+{
+    m_socket = new QLocalSocket(this);
+    connect(m_socket, &QLocalSocket::readyRead, this, &SyncChangeListener::onReadyRead);
+    connect(m_socket, &QLocalSocket::disconnected, this, &SyncChangeListener::onDisconnected);
+    connect(m_socket, &QLocalSocket::errorOccurred, this, &SyncChangeListener::onDisconnected);
+
+    // 守护进程未启动或重启时每3秒重连
+    m_reconnectTimer = new QTimer(this);
+    m_reconnectTimer->setInterval(3000);
+    m_reconnectTimer->setSingleShot(true);
+    connect(m_reconnectTimer, &QTimer::timeout, this, &SyncChangeListener::tryConnect);
+}
+
+void SyncChangeListener::start()
+{
+    tryConnect();
+}
+
+void SyncChangeListener::tryConnect()
+{
+    if (m_socket->state() != QLocalSocket::UnconnectedState) {
+        return;
+    }
+    m_socket->connectToServer(SyncNotifier::serverName());
+}
+
+void SyncChangeListener::onDisconnected()
+{
+    // 守护进程在替换途中退出：不再等待通知，直接重新打开数据库
+    if (m_released) {
+        m_released = false;
+        emit databaseReplaced();
+    }
+    if (!m_reconnectTimer->isActive()) {
+        m_reconnectTimer->start();
+    }
+}
+
+void SyncChangeListener::onReadyRead()
+{
+    m_buffer.append(m_socket->readAll());
+
+    int pos;
+    while ((pos = m_buffer.indexOf('\n')) >= 0) {
+        QString line = QString::fromUtf8(m_buffer.left(pos));
+        m_buffer.remove(0, pos + 1);
+
+        if (line == "prepare") {
+            emit aboutToReplaceDatabase();
+            m_released = true;
+            m_socket->write("ready\n");
+            m_socket->flush();
+        } else if (line == "replaced" || line == "resume") {
+            m_released = false;
+            emit databaseReplaced();
+        } else if (line.startsWith("changed")) {
+            emit dataChanged(line.mid(8).trimmed());
+        } else if (line.startsWith("failed")) {
+            emit syncFailed(line.mid(7).trimmed());
+        } else if (line.startsWith("urgent")) {
+            QJsonObject obj = QJsonDocument::fromJson(line.mid(7).toUtf8()).object();
+            emit urgentNotice(obj["title"].toString(), obj["content"].toString());
+        } else {
+            writeLog("WARNING", "未知的守护进程消息：" + line, "NETWORK");
+        }
+    }
+}
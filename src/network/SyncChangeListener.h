@@ -0,0 +1,46 @@
+#ifndef SYNCCHANGELISTENER_H
+#define SYNCCHANGELISTENER_H
+
+#include <QObject>
+#include <QLocalSocket>
+#include <QTimer>
+#include "utility/LogHelper.h" // 包含公共日志头文件
+
+// 展示进程侧：监听 classboard-syncd 的数据变更通知（断线自动重连）
+class SyncChangeListener : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SyncChangeListener(QObject *parent = nullptr);
+
+    // 开始连接守护进程
+    void start();
+
+    // 是否已连接守护进程
+    bool isConnected() const { return m_socket->state() == QLocalSocket::ConnectedState; }
+
+signals:
+    // 守护进程已完成同步，数据有更新
+    void dataChanged(const QString& scope);
+    // 守护进程同步失败
+    void syncFailed(const QString& msg);
+    // 守护进程收到紧急通知
+    void urgentNotice(const QString& title, const QString& content);
+    // 守护进程即将替换数据库文件：接收方须在信号处理中（直接连接）关闭全部数据库连接，随后自动回复 ready
+    void aboutToReplaceDatabase();
+    // 守护进程已用快照替换数据库文件，或放弃替换（原文件不变），接收方重新打开数据库连接
+    void databaseReplaced();
+
+private slots:
+    void onReadyRead();
+    void onDisconnected();
+    void tryConnect();
+
+private:
+    QLocalSocket* m_socket;       // 与守护进程的连接
+    QTimer* m_reconnectTimer;     // 重连定时器
+    QByteArray m_buffer;          // 未处理完的消息
+    bool m_released = false;      // 已应守护进程要求关闭数据库连接，等待 replaced/resume
+};
+
+#endif // SYNCCHANGELISTENER_H
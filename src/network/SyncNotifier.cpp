@@ -0,0 +1,122 @@
+#include "SyncNotifier.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDeadlineTimer>
+#include <QLocalSocket>
+
+// 启动时探测已有服务的连接超时
+static const int kProbeTimeoutMs = 500;
+
+SyncNotifier::SyncNotifier(QObject *parent) : QObject(parent)
+{
+    m_server = new QLocalServer(this);
+    // 允许其他用户运行的展示进程连接
+    m_server->setSocketOptions(QLocalServer::WorldAccessOption);
+    connect(m_server, &QLocalServer::newConnection, this, &SyncNotifier::onNewConnection);
+}
+
+SyncNotifier::~SyncNotifier()
+{
+    m_server->close();
+}
+
+bool SyncNotifier::start()
+{
+    // 先探测同名服务：能连上说明已有守护进程在运行，不能抢占其套接字
+    QLocalSocket probe;
+    probe.connectToServer(serverName());
+    if (probe.waitForConnected(kProbeTimeoutMs)) {
+        probe.disconnectFromServer();
+        writeLog("ERROR", "本地通知服务已被其他同步进程占用：" + serverName(), "SYNCD");
+        return false;
+    }
+
+    // 连接失败即为上次异常退出残留的套接字文件，清理后再监听
+    QLocalServer::removeServer(serverName());
+
+    if (!m_server->listen(serverName())) {
+        writeLog("ERROR", "本地通知服务启动失败：" + m_server->errorString(), "SYNCD");
+        return false;
+    }
+
+    writeLog("INFO", "本地通知服务已启动：" + m_server->fullServerName(), "SYNCD");
+    return true;
+}
+
+void SyncNotifier::notifyDataChanged(const QString& scope)
+{
+    broadcast("changed " + scope.toUtf8() + "\n");
+}
+
+void SyncNotifier::notifySyncFailed(const QString& msg)
+{
+    // 消息按行分隔，去掉原因中的换行
+    QString oneLine = msg;
+    oneLine.replace('\n', ' ');
+    broadcast("failed " + oneLine.toUtf8() + "\n");
+}
+
+void SyncNotifier::notifyUrgent(const QString& title, const QString& content)
+{
+    // 紧凑JSON不含换行，可直接作为一行消息
+    QJsonObject obj{{"title", title}, {"content", content}};
+    broadcast("urgent " + QJsonDocument(obj).toJson(QJsonDocument::Compact) + "\n");
+}
+
+bool SyncNotifier::prepareReplace(int timeoutMs)
+{
+    broadcast("prepare\n");
+
+    // 在调用线程内同步等待（替换在主线程进行，期间不处理其他事件）；
+    // 断开的连接会在等待中被移出 m_clients，故遍历副本
+    QDeadlineTimer deadline(timeoutMs);
+    const QList<QLocalSocket*> clients = m_clients;
+    for (QLocalSocket* socket : clients) {
+        QByteArray reply;
+        while (!reply.contains('\n') && socket->state() == QLocalSocket::ConnectedState) {
+            if (socket->bytesAvailable() == 0 && !socket->waitForReadyRead(deadline.remainingTime())) {
+                break;
+            }
+            reply += socket->readAll();
+        }
+        if (socket->state() != QLocalSocket::ConnectedState) {
+            continue;
+        }
+        if (!reply.startsWith("ready")) {
+            writeLog("WARNING", "展示进程未在时限内关闭数据库连接，放弃替换", "SYNCD");
+            notifyReplaceAborted();
+            return false;
+        }
+    }
+    return true;
+}
+
+void SyncNotifier::notifyDatabaseReplaced()
+{
+    broadcast("replaced\n");
+}
+
+void SyncNotifier::notifyReplaceAborted()
+{
+    broadcast("resume\n");
+}
+
+void SyncNotifier::onNewConnection()
+{
+    while (QLocalSocket* socket = m_server->nextPendingConnection()) {
+        m_clients.append(socket);
+        connect(socket, &QLocalSocket::disconnected, this, [this, socket]() {
+            m_clients.removeAll(socket);
+            socket->deleteLater();
+        });
+        writeLog("INFO", QString("展示进程已连接，当前连接数：%1").arg(m_clients.size()), "SYNCD");
+    }
+}
+
+void SyncNotifier::broadcast(const QByteArray& line)
+{
+    for (QLocalSocket* socket : m_clients) {
+        socket->write(line);
+        socket->flush();
+    }
+}
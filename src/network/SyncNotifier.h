@@ -0,0 +1,56 @@
+#ifndef SYNCNOTIFIER_H
+#define SYNCNOTIFIER_H
+
+#include <QObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QList>
+#include "utility/LogHelper.h" // 包含公共日志头文件
+
+// 同步守护进程通知服务（本地套接字广播，classboard-syncd 使用）
+// 协议：每条消息一行UTF-8文本
+//   changed <范围>   数据已更新，展示进程应刷新
+//   failed <原因>    本次同步失败
+//   urgent <JSON>    收到紧急通知（{"title":..,"content":..}，已由守护进程写入通知表）
+//   prepare          即将替换数据库文件：展示进程关闭全部数据库连接后回复一行 ready
+//   replaced         数据库文件已被快照整体替换，展示进程重新打开数据库连接
+//   resume           替换已放弃，展示进程重新打开原数据库文件
+class SyncNotifier : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SyncNotifier(QObject *parent = nullptr);
+    ~SyncNotifier();
+
+    // 本地套接字名称（守护进程与展示进程约定）
+    static QString serverName() { return "classboard-syncd"; }
+
+    // 开始监听（返回是否成功；已有守护进程在监听时失败，不抢占）
+    bool start();
+
+    // 广播数据变更 / 同步失败
+    void notifyDataChanged(const QString& scope = "all");
+    void notifySyncFailed(const QString& msg);
+    // 广播紧急通知
+    void notifyUrgent(const QString& title, const QString& content);
+    // 替换数据库文件前通知展示进程关闭连接，等待全部回复 ready（已断开的不计）
+    // 超时或回复异常时广播 resume 并返回false
+    bool prepareReplace(int timeoutMs);
+    // 广播数据库文件已替换（快照开通）/ 替换已放弃
+    void notifyDatabaseReplaced();
+    void notifyReplaceAborted();
+
+    // 当前连接的展示进程数量
+    int clientCount() const { return m_clients.size(); }
+
+private slots:
+    void onNewConnection();
+
+private:
+    void broadcast(const QByteArray& line);
+
+    QLocalServer* m_server;           // 本地套接字服务
+    QList<QLocalSocket*> m_clients;   // 已连接的展示进程
+};
+
+#endif // SYNCNOTIFIER_H
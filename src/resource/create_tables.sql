@@ -1,8 +1,17 @@
 -- 数据库文件名：classboard.db
 DROP TABLE IF EXISTS course_schedule;
+DROP TABLE IF EXISTS teacher_info;
+DROP TABLE IF EXISTS course_name_info;
+DROP TABLE IF EXISTS course_type_info;
 DROP TABLE IF EXISTS classroom_info;
 DROP TABLE IF EXISTS class_info;
 DROP TABLE IF EXISTS notices;
+DROP TABLE IF EXISTS calendar_exceptions;
+DROP TABLE IF EXISTS effective_schedule;
+DROP TABLE IF EXISTS materialized_dates;
+DROP TABLE IF EXISTS notices_archive;
+DROP TABLE IF EXISTS course_schedule_archive;
+DROP TABLE IF EXISTS sync_state;
 
 -- 1. 班级表
 CREATE TABLE class_info (
@@ -18,21 +27,44 @@ CREATE TABLE classroom_info (
     classroom_name TEXT NOT NULL     -- 教室名称
 );
 
+-- 2.1 教师字典表（课表中的教师名称统一映射为编号）
+CREATE TABLE teacher_info (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    teacher_name TEXT NOT NULL UNIQUE  -- 教师姓名
+);
+
+-- 2.2 课程名称字典表
+CREATE TABLE course_name_info (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    course_name TEXT NOT NULL UNIQUE   -- 课程名称
+);
+
+-- 2.3 课程类型字典表
+CREATE TABLE course_type_info (
+    id INTEGER PRIMARY KEY AUTOINCREMENT,
+    type_name TEXT NOT NULL UNIQUE     -- 课程类型（必修/选修/实验）
+);
+
 -- 3. 课表数据表
 CREATE TABLE course_schedule (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     class_id INTEGER NOT NULL,        -- 关联班级ID
-    course_name TEXT NOT NULL,        -- 课程名称
-    teacher TEXT NOT NULL,            -- 任课教师
-    course_type TEXT NOT NULL,        -- 课程类型（必修/选修/实验）
+    course_name_id INTEGER NOT NULL,  -- 课程名称ID（course_name_info）
+    teacher_id INTEGER,               -- 任课教师ID（teacher_info）
+    course_type_id INTEGER NOT NULL,  -- 课程类型ID（course_type_info）
     start_time TEXT NOT NULL,         -- 上课时间（HH:mm）
     end_time TEXT NOT NULL,           -- 下课时间（HH:mm）
     day_of_week INTEGER NOT NULL CHECK(day_of_week BETWEEN 1 AND 7), -- 星期（1-7），增加范围校验
     start_date TEXT NOT NULL,         -- 课程开始日期（YYYY-MM-DD）
     end_date TEXT NOT NULL,           -- 课程结束日期（YYYY-MM-DD）
     classroom_id INTEGER,             -- 关联教室ID
+    week_mask INTEGER NOT NULL DEFAULT -1, -- 上课周位图（第N周对应第N-1位，-1=每周）
+    server_id INTEGER UNIQUE,         -- 服务器端课程ID（同步按此更新/删除，本地添加的课程为空）
     FOREIGN KEY(class_id) REFERENCES class_info(id) ON DELETE CASCADE,
-    FOREIGN KEY(classroom_id) REFERENCES classroom_info(id) ON DELETE SET NULL 
+    FOREIGN KEY(classroom_id) REFERENCES classroom_info(id) ON DELETE SET NULL,
+    FOREIGN KEY(teacher_id) REFERENCES teacher_info(id) ON DELETE SET NULL,
+    FOREIGN KEY(course_name_id) REFERENCES course_name_info(id),
+    FOREIGN KEY(course_type_id) REFERENCES course_type_info(id)
 );
 
 -- 4. 通知公告表（修正序号）
@@ -41,14 +73,78 @@ CREATE TABLE notices (
     title TEXT NOT NULL,              -- 通知标题
     content TEXT NOT NULL,            -- 通知内容
     publish_time TEXT NOT NULL,       -- 发布时间（YYYY-MM-DD HH:mm:ss）
-    expire_time TEXT,                 -- 过期时间（YYYY-MM-DD）
+    expire_time TEXT,                 -- 过期时间（YYYY-MM-DD，当天有效；或 YYYY-MM-DD HH:mm:ss）
     is_scrolling INTEGER DEFAULT 0 CHECK(is_scrolling IN (0,1)), -- 是否滚动（1=是，0=否），增加取值校验
-    is_valid INTEGER DEFAULT 1 CHECK(is_valid IN (0,1))          -- 是否有效（1=是，0=否），增加取值校验
+    is_valid INTEGER DEFAULT 1 CHECK(is_valid IN (0,1)),         -- 是否有效（1=是，0=否），增加取值校验
+    server_id INTEGER UNIQUE          -- 服务器端通知ID（同步按此更新/删除，本地添加的通知为空）
+);
+
+-- 5. 校历例外表（节假日停课、调休上课）
+CREATE TABLE calendar_exceptions (
+    date TEXT NOT NULL PRIMARY KEY,   -- 日期（YYYY-MM-DD）
+    kind INTEGER NOT NULL CHECK(kind IN (0,1)), -- 0=停课（节假日），1=调休上课
+    as_day_of_week INTEGER CHECK(as_day_of_week BETWEEN 1 AND 7), -- 调休日按星期几的课表上课
+    description TEXT                  -- 说明（如“国庆节”“10月11日补周五课”）
+);
+
+-- 6. 按日期展开的有效课表（由 DatabaseManager 按需生成并增量维护，勿手工修改）
+CREATE TABLE effective_schedule (
+    date TEXT NOT NULL,               -- 日期（YYYY-MM-DD）
+    class_id INTEGER NOT NULL,        -- 班级ID
+    start_time TEXT NOT NULL,         -- 上课时间（HH:mm）
+    end_time TEXT NOT NULL,           -- 下课时间（HH:mm）
+    course_id INTEGER NOT NULL,       -- 关联课程ID
+    PRIMARY KEY (date, class_id, start_time, course_id)
+) WITHOUT ROWID;
+
+-- 7. 已展开的日期（effective_schedule 中存在该日期的完整数据）
+CREATE TABLE materialized_dates (
+    date TEXT NOT NULL PRIMARY KEY
+) WITHOUT ROWID;
+
+-- 8. 归档表（数据保留任务把过期通知、已结课课程从热表移入，结构同原表，另记归档时间）
+CREATE TABLE notices_archive (
+    id INTEGER PRIMARY KEY,           -- 原通知ID
+    title TEXT NOT NULL,
+    content TEXT NOT NULL,
+    publish_time TEXT NOT NULL,
+    expire_time TEXT,
+    is_scrolling INTEGER,
+    is_valid INTEGER,
+    server_id INTEGER,
+    archived_at TEXT NOT NULL         -- 归档时间（YYYY-MM-DD HH:mm:ss）
 );
 
+CREATE TABLE course_schedule_archive (
+    id INTEGER PRIMARY KEY,           -- 原课程ID
+    class_id INTEGER NOT NULL,
+    course_name_id INTEGER NOT NULL,  -- 字典ID仍指向 course_name_info 等字典表
+    teacher_id INTEGER,
+    course_type_id INTEGER NOT NULL,
+    start_time TEXT NOT NULL,
+    end_time TEXT NOT NULL,
+    day_of_week INTEGER NOT NULL,
+    start_date TEXT NOT NULL,
+    end_date TEXT NOT NULL,
+    classroom_id INTEGER,
+    week_mask INTEGER NOT NULL,
+    server_id INTEGER,
+    archived_at TEXT NOT NULL         -- 归档时间（YYYY-MM-DD HH:mm:ss）
+);
+
+-- 9. 同步状态（键值对；revision 为已应用的服务器数据版本，增量同步由此开始）
+CREATE TABLE sync_state (
+    key TEXT NOT NULL PRIMARY KEY,
+    value TEXT NOT NULL
+) WITHOUT ROWID;
+
 -- 索引（优化索引设计）
 CREATE INDEX idx_course_class_id ON course_schedule(class_id);
 CREATE INDEX idx_course_date ON course_schedule(start_date, end_date);
 CREATE INDEX idx_course_week_time ON course_schedule(day_of_week, start_time); 
 CREATE INDEX idx_notices_valid ON notices(is_valid, expire_time);
-CREATE INDEX idx_classroom_name ON classroom_info(classroom_name);
\ No newline at end of file
+CREATE INDEX idx_notices_publish ON notices(publish_time, id);
+CREATE INDEX idx_notices_status_publish ON notices(is_valid, publish_time, id);
+CREATE INDEX idx_classroom_name ON classroom_info(classroom_name);
+CREATE INDEX idx_effective_course ON effective_schedule(course_id);
+CREATE INDEX idx_course_teacher ON course_schedule(teacher_id, day_of_week, start_time);
\ No newline at end of file
@@ -17,8 +17,13 @@ VALUES
     (4, 'D401'),
     (5, 'E502');
 
--- 测试数据：课表
-INSERT INTO course_schedule (class_id, course_name, teacher, course_type, start_time, end_time, day_of_week, start_date, end_date, classroom_id)
+-- 测试数据：课表（先以文本写入临时表，再映射为字典ID）
+CREATE TEMP TABLE course_import (
+    class_id INTEGER, course_name TEXT, teacher TEXT, course_type TEXT,
+    start_time TEXT, end_time TEXT, day_of_week INTEGER, start_date TEXT, end_date TEXT, classroom_id INTEGER
+);
+
+INSERT INTO course_import (class_id, course_name, teacher, course_type, start_time, end_time, day_of_week, start_date, end_date, classroom_id)
 VALUES
     (1, 'Qt 6高级编程', '张教授', '必修课', '14:00', '15:40', 1, '2026-01-02', '2026-06-30', 1),
     (1, '数据结构与算法', '李老师', '必修课', '16:00', '17:40', 1, '2026-01-02', '2026-06-30', 1),
@@ -31,6 +36,19 @@ VALUES
     (6, '网络安全', '吴老师', '必修课', '14:00', '15:40', 1, '2026-01-02', '2026-06-30', 5),
     (6, '密码学', '郑老师', '必修课', '16:00', '17:40', 3, '2026-01-02', '2026-06-30', 5);
 
+INSERT OR IGNORE INTO course_name_info (course_name) SELECT DISTINCT course_name FROM course_import;
+INSERT OR IGNORE INTO teacher_info (teacher_name) SELECT DISTINCT teacher FROM course_import;
+INSERT OR IGNORE INTO course_type_info (type_name) SELECT DISTINCT course_type FROM course_import;
+
+INSERT INTO course_schedule (class_id, course_name_id, teacher_id, course_type_id, start_time, end_time, day_of_week, start_date, end_date, classroom_id)
+SELECT ci.class_id, n.id, t.id, ty.id, ci.start_time, ci.end_time, ci.day_of_week, ci.start_date, ci.end_date, ci.classroom_id
+FROM course_import ci
+JOIN course_name_info n ON n.course_name = ci.course_name
+JOIN teacher_info t ON t.teacher_name = ci.teacher
+JOIN course_type_info ty ON ty.type_name = ci.course_type;
+
+DROP TABLE course_import;
+
 -- 测试数据：通知
 INSERT INTO notices (title, content, publish_time, expire_time, is_scrolling, is_valid)
 VALUES
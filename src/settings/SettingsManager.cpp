@@ -1,4 +1,5 @@
 #include "SettingsManager.h"
+#include <QUrl>
 
 SettingsManager& SettingsManager::instance()
 {
@@ -19,10 +20,34 @@ SettingsManager::SettingsManager(QObject *parent) : QObject(parent)
     m_syncInterval = m_settings->value("Sync/Interval", 600).toInt();
     m_dbPath = m_settings->value("Database/Path", "").toString();
     m_serverUrl = m_settings->value("Server/Url", "http://127.0.0.1:8080/api/sync").toString();
+    m_syncMode = m_settings->value("Sync/Mode", "embedded").toString();
+    m_urgentEnabled = m_settings->value("Urgent/Enabled", true).toBool();
+    m_urgentUrl = m_settings->value("Urgent/Url", "").toString();
+    m_snapshotEnabled = m_settings->value("Snapshot/Enabled", true).toBool();
+    m_snapshotUrl = m_settings->value("Snapshot/Url", "").toString();
+    m_metricsEnabled = m_settings->value("Metrics/Enabled", false).toBool();
+    m_metricsBindAddress = m_settings->value("Metrics/BindAddress", "127.0.0.1").toString();
+    m_metricsPort = m_settings->value("Metrics/Port", 9464).toInt();
+    m_stallWatchdogEnabled = m_settings->value("Diagnostics/StallWatchdog", false).toBool();
+    m_stallThresholdMs = m_settings->value("Diagnostics/StallThresholdMs", 500).toInt();
+    m_traceFilePath = m_settings->value("Diagnostics/TraceFile", "").toString();
+    m_retentionEnabled = m_settings->value("Retention/Enabled", true).toBool();
+    m_retentionDays = m_settings->value("Retention/Days", 30).toInt();
+    m_idleStartHour = m_settings->value("Retention/IdleStartHour", 1).toInt();
+    m_idleEndHour = m_settings->value("Retention/IdleEndHour", 5).toInt();
+    m_pragmaPreset = m_settings->value("Pragma/Preset", "sdcard").toString();
+    m_settings->beginGroup("Pragma");
+    for (const QString& key : m_settings->childKeys()) {
+        if (key != "Preset") {
+            m_pragmaOverrides.insert(key, m_settings->value(key));
+        }
+    }
+    m_settings->endGroup();
     
     qDebug() << "加载配置：同步间隔=" << m_syncInterval 
              << "，数据库路径=" << m_dbPath 
-             << "，服务器地址=" << m_serverUrl;
+             << "，服务器地址=" << m_serverUrl
+             << "，同步模式=" << m_syncMode;
 }
 
 // 获取同步间隔
@@ -66,12 +91,160 @@ void SettingsManager::setServerUrl(const QString& url)
     qDebug() << "设置服务器地址：" << url;
 }
 
+// 设置紧急通知通道开关
+void SettingsManager::setUrgentChannelEnabled(bool enabled)
+{
+    m_urgentEnabled = enabled;
+    qDebug() << "设置紧急通知通道：" << enabled;
+}
+
+// 获取紧急通知地址（未配置时与同步服务器同主机，路径为 /api/urgent）
+QString SettingsManager::getUrgentUrl()
+{
+    if (!m_urgentUrl.isEmpty()) {
+        return m_urgentUrl;
+    }
+    QUrl url(m_serverUrl);
+    url.setPath("/api/urgent");
+    url.setQuery(QString());
+    return url.toString();
+}
+
+// 设置快照开通开关
+void SettingsManager::setSnapshotProvisionEnabled(bool enabled)
+{
+    m_snapshotEnabled = enabled;
+    qDebug() << "设置快照开通：" << enabled;
+}
+
+// 获取数据库快照地址（未配置时与同步服务器同主机，路径为 /api/snapshot）
+QString SettingsManager::getSnapshotUrl()
+{
+    if (!m_snapshotUrl.isEmpty()) {
+        return m_snapshotUrl;
+    }
+    QUrl url(m_serverUrl);
+    url.setPath("/api/snapshot");
+    url.setQuery(QString());
+    return url.toString();
+}
+
+// 获取同步模式
+QString SettingsManager::getSyncMode()
+{
+    return m_syncMode;
+}
+
+// 设置同步模式
+void SettingsManager::setSyncMode(const QString& mode)
+{
+    m_syncMode = (mode == "daemon") ? "daemon" : "embedded";
+    qDebug() << "设置同步模式：" << m_syncMode;
+}
+
+// 设置指标服务开关
+void SettingsManager::setMetricsEnabled(bool enabled)
+{
+    m_metricsEnabled = enabled;
+    qDebug() << "设置指标服务：" << enabled;
+}
+
+// 设置指标服务监听地址
+void SettingsManager::setMetricsBindAddress(const QString& address)
+{
+    m_metricsBindAddress = address;
+    qDebug() << "设置指标服务监听地址：" << address;
+}
+
+// 设置指标服务端口
+void SettingsManager::setMetricsPort(int port)
+{
+    if (port < 1) port = 1;
+    if (port > 65535) port = 65535;
+    m_metricsPort = port;
+    qDebug() << "设置指标服务端口：" << port;
+}
+
+// 设置界面卡顿看门狗开关
+void SettingsManager::setStallWatchdogEnabled(bool enabled)
+{
+    m_stallWatchdogEnabled = enabled;
+    qDebug() << "设置界面卡顿看门狗：" << enabled;
+}
+
+// 设置卡顿判定阈值
+void SettingsManager::setStallThresholdMs(int ms)
+{
+    if (ms < 100) ms = 100; // 最小100毫秒
+    m_stallThresholdMs = ms;
+    qDebug() << "设置卡顿判定阈值：" << ms;
+}
+
+// 获取追踪导出文件（未配置时位于AppData目录）
+QString SettingsManager::getTraceFilePath()
+{
+    if (!m_traceFilePath.isEmpty()) {
+        return m_traceFilePath;
+    }
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/classboard_trace.json";
+}
+
+// 设置数据保留任务开关
+void SettingsManager::setRetentionEnabled(bool enabled)
+{
+    m_retentionEnabled = enabled;
+    qDebug() << "设置数据保留任务：" << enabled;
+}
+
+// 设置保留天数（过期/结课超过该天数的数据才归档）
+void SettingsManager::setRetentionDays(int days)
+{
+    if (days < 1) days = 1; // 最少保留1天
+    m_retentionDays = days;
+    qDebug() << "设置数据保留天数：" << days;
+}
+
+// 设置空闲时段（整点，[start, end)，start大于end时跨零点）
+void SettingsManager::setIdleHours(int startHour, int endHour)
+{
+    m_idleStartHour = qBound(0, startHour, 23);
+    m_idleEndHour = qBound(0, endHour, 23);
+    qDebug() << "设置空闲时段：" << m_idleStartHour << "-" << m_idleEndHour;
+}
+
+// 设置SQLite连接参数预设（未知预设名忽略）
+void SettingsManager::setPragmaPreset(const QString& preset)
+{
+    if (!SqlitePragmaProfile::presetNames().contains(preset)) {
+        qDebug() << "忽略未知的连接参数预设：" << preset;
+        return;
+    }
+    m_pragmaPreset = preset;
+    qDebug() << "设置连接参数预设：" << preset;
+}
+
 // 保存所有设置
 void SettingsManager::saveSettings()
 {
     m_settings->setValue("Sync/Interval", m_syncInterval);
     m_settings->setValue("Database/Path", m_dbPath);
     m_settings->setValue("Server/Url", m_serverUrl);
+    m_settings->setValue("Sync/Mode", m_syncMode);
+    m_settings->setValue("Urgent/Enabled", m_urgentEnabled);
+    m_settings->setValue("Urgent/Url", m_urgentUrl);
+    m_settings->setValue("Snapshot/Enabled", m_snapshotEnabled);
+    m_settings->setValue("Snapshot/Url", m_snapshotUrl);
+    m_settings->setValue("Metrics/Enabled", m_metricsEnabled);
+    m_settings->setValue("Metrics/BindAddress", m_metricsBindAddress);
+    m_settings->setValue("Metrics/Port", m_metricsPort);
+    m_settings->setValue("Diagnostics/StallWatchdog", m_stallWatchdogEnabled);
+    m_settings->setValue("Diagnostics/StallThresholdMs", m_stallThresholdMs);
+    m_settings->setValue("Diagnostics/TraceFile", m_traceFilePath);
+    m_settings->setValue("Retention/Enabled", m_retentionEnabled);
+    m_settings->setValue("Retention/Days", m_retentionDays);
+    m_settings->setValue("Retention/IdleStartHour", m_idleStartHour);
+    m_settings->setValue("Retention/IdleEndHour", m_idleEndHour);
+    m_settings->setValue("Pragma/Preset", m_pragmaPreset);
     m_settings->sync(); // 立即保存
     
     qDebug() << "配置已保存到：" << m_settings->fileName();
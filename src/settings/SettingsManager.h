@@ -7,6 +7,8 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QDebug>
+#include <QVariantMap>
+#include "data/SqlitePragmas.h"
 
 // 设置管理类（单例，Qt 6 QSettings适配）
 class SettingsManager : public QObject
@@ -28,6 +30,51 @@ public:
     QString getServerUrl();
     void setServerUrl(const QString& url);
 
+    // 获取/设置紧急通知通道（长轮询，默认开启；地址未配置时由服务器地址推导为 /api/urgent）
+    bool isUrgentChannelEnabled() { return m_urgentEnabled; }
+    void setUrgentChannelEnabled(bool enabled);
+    QString getUrgentUrl();
+
+    // 获取/设置快照开通（新板卡首次同步前下载预制数据库快照，默认开启；地址未配置时推导为 /api/snapshot）
+    bool isSnapshotProvisionEnabled() { return m_snapshotEnabled; }
+    void setSnapshotProvisionEnabled(bool enabled);
+    QString getSnapshotUrl();
+
+    // 获取/设置同步模式（embedded=本进程同步，daemon=由 classboard-syncd 同步）
+    QString getSyncMode();
+    void setSyncMode(const QString& mode);
+    bool isDaemonSyncMode() { return m_syncMode == "daemon"; }
+
+    // 获取/设置指标服务（/metrics，默认关闭；监听地址127.0.0.1仅本机，0.0.0.0对局域网开放）
+    bool isMetricsEnabled() { return m_metricsEnabled; }
+    void setMetricsEnabled(bool enabled);
+    QString getMetricsBindAddress() { return m_metricsBindAddress; }
+    void setMetricsBindAddress(const QString& address);
+    int getMetricsPort() { return m_metricsPort; }
+    void setMetricsPort(int port);
+
+    // 获取/设置界面卡顿看门狗（默认关闭）与追踪导出文件
+    bool isStallWatchdogEnabled() { return m_stallWatchdogEnabled; }
+    void setStallWatchdogEnabled(bool enabled);
+    int getStallThresholdMs() { return m_stallThresholdMs; }
+    void setStallThresholdMs(int ms);
+    QString getTraceFilePath();
+
+    // 获取/设置数据保留任务（空闲时段内把过期通知、已结课课程移入归档表并回收空间，默认开启）
+    bool isRetentionEnabled() { return m_retentionEnabled; }
+    void setRetentionEnabled(bool enabled);
+    int getRetentionDays() { return m_retentionDays; }
+    void setRetentionDays(int days);
+    int getIdleStartHour() { return m_idleStartHour; }
+    int getIdleEndHour() { return m_idleEndHour; }
+    void setIdleHours(int startHour, int endHour);
+
+    // 获取/设置SQLite连接参数预设（sdcard=班牌默认，ssd=管理端电脑，compat=旧版默认）
+    // 配置文件 [Pragma] 段中单独写出的 JournalMode、Synchronous、MmapSizeMb、CacheSizeKb、TempStore、BusyTimeoutMs 覆盖预设
+    QString getPragmaPreset() { return m_pragmaPreset; }
+    void setPragmaPreset(const QString& preset);
+    SqlitePragmaProfile getPragmaProfile() { return SqlitePragmaProfile::fromSettings(m_pragmaPreset, m_pragmaOverrides); }
+
     // 保存所有设置
     void saveSettings();
 
@@ -41,6 +88,23 @@ private:
     int m_syncInterval = 600;
     QString m_dbPath = "";
     QString m_serverUrl = "http://127.0.0.1:8080/api/sync";
+    QString m_syncMode = "embedded";
+    bool m_urgentEnabled = true;
+    QString m_urgentUrl = "";
+    bool m_snapshotEnabled = true;
+    QString m_snapshotUrl = "";
+    bool m_metricsEnabled = false;
+    QString m_metricsBindAddress = "127.0.0.1";
+    int m_metricsPort = 9464;
+    bool m_stallWatchdogEnabled = false;
+    int m_stallThresholdMs = 500;
+    QString m_traceFilePath = "";
+    bool m_retentionEnabled = true;
+    int m_retentionDays = 30;
+    int m_idleStartHour = 1;
+    int m_idleEndHour = 5;
+    QString m_pragmaPreset = "sdcard";
+    QVariantMap m_pragmaOverrides;      // [Pragma] 段中手工配置的单项（只读取，不回写）
 };
 
 #endif // SETTINGSMANAGER_H
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include <QCoreApplication>
+#include "data/DatabaseManager.h"
+#include "data/RetentionJob.h"
+#include "network/NetworkWorker.h"
+#include "network/SyncNotifier.h"
+#include "metrics/MetricsServer.h"
+#include "settings/SettingsManager.h"
+
+// 替换数据库文件前等待展示进程关闭连接的时限
+static const int kReplacePrepareTimeoutMs = 5000;
+
+// classboard-syncd：无界面同步守护进程
+// 独占网络同步与数据库写入，同步完成后通过本地套接字通知展示进程刷新
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+
+    // 与展示进程保持一致，共用同一AppData目录（数据库、配置、日志）
+    a.setApplicationName("ClassBoardSystem");
+    a.setApplicationVersion("1.0.0");
+    a.setOrganizationName("Qt6Demo");
+
+    writeLog("INFO", "同步守护进程启动", "SYNCD");
+
+    DatabaseManager::instance().setPragmaProfile(SettingsManager::instance().getPragmaProfile());
+    if (!DatabaseManager::instance().init(SettingsManager::instance().getDbPath())) {
+        writeLog("ERROR", "数据库初始化失败，守护进程退出", "SYNCD");
+        return 1;
+    }
+
+    SyncNotifier notifier;
+    if (!notifier.start()) {
+        return 1;
+    }
+
+    // 快照开通替换数据库文件：先等展示进程关闭连接（共用同名 -wal/-shm，不能在其打开时改名），
+    // 替换完成或放弃后通知其重新打开
+    DatabaseManager::instance().setReplaceGuard([&notifier]() {
+        return notifier.prepareReplace(kReplacePrepareTimeoutMs);
+    });
+    QObject::connect(&DatabaseManager::instance(), &DatabaseManager::databaseReplaced,
+                     &notifier, &SyncNotifier::notifyDatabaseReplaced);
+    QObject::connect(&DatabaseManager::instance(), &DatabaseManager::replaceAborted,
+                     &notifier, &SyncNotifier::notifyReplaceAborted);
+
+    // 以应用对象为父对象：与GUI进程一致，同步在主线程事件循环中异步完成
+    NetworkWorker* worker = new NetworkWorker(&a);
+    worker->setSyncInterval(SettingsManager::instance().getSyncInterval());
+    QObject::connect(worker, &NetworkWorker::syncSuccess, &notifier, [&notifier](const QString&) {
+        notifier.notifyDataChanged("all");
+    });
+    QObject::connect(worker, &NetworkWorker::syncFailed, &notifier, &SyncNotifier::notifySyncFailed);
+    QObject::connect(worker, &NetworkWorker::urgentNoticeReceived, &notifier, &SyncNotifier::notifyUrgent);
+    emit worker->startSyncTimer();
+    emit worker->startUrgentChannel();
+
+    // 数据保留任务由独占写入的守护进程执行，归档后通知展示进程刷新
+    QObject::connect(&RetentionJob::instance(), &RetentionJob::finished, &notifier,
+                     [&notifier](int archivedNotices, int archivedCourses) {
+        if (archivedNotices + archivedCourses > 0) {
+            notifier.notifyDataChanged("all");
+        }
+    });
+    RetentionJob::instance().start();
+
+    // 可选：内嵌指标服务（/metrics）
+    if (SettingsManager::instance().isMetricsEnabled()) {
+        MetricsServer* metricsServer = new MetricsServer(SettingsManager::instance().getMetricsBindAddress(),
+                                                         SettingsManager::instance().getMetricsPort(), &a);
+        metricsServer->start();
+    }
+
+    // 启动后立即同步一次
+    worker->triggerSync();
+
+    return a.exec();
+}
@@ -0,0 +1,24 @@
+# 无界面同步守护进程 classboard-syncd
+QT       += core sql network
+QT       -= gui
+
+CONFIG   += console
+CONFIG   -= app_bundle
+
+# 禁用Qt 6前的废弃API
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000
+
+TARGET = classboard-syncd
+TEMPLATE = app
+
+include(../core/classboard_core.pri)
+
+# 源文件
+SOURCES += \
+    main.cpp
+
+# Release模式优化
+CONFIG(release, debug|release): {
+    DEFINES += QT_NO_DEBUG_OUTPUT
+    QMAKE_CXXFLAGS += -O2 -Wall
+}
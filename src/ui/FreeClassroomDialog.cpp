@@ -0,0 +1,100 @@
+#include "FreeClassroomDialog.h"
+#include "ui_FreeClassroomDialog.h"
+#include "data/DatabaseManager.h"
+#include "utility/Clock.h"
+
+#include <QHeaderView>
+#include <QTableWidgetItem>
+#include <QElapsedTimer>
+
+FreeClassroomDialog::FreeClassroomDialog(QWidget *parent)
+    : QDialog(parent)
+    , ui(new Ui::FreeClassroomDialog)
+{
+    ui->setupUi(this);
+    initUI();
+    initConnections();
+    handleNow();
+}
+
+FreeClassroomDialog::~FreeClassroomDialog()
+{
+    delete ui;
+}
+
+void FreeClassroomDialog::initUI()
+{
+    this->setModal(false);
+    this->setAttribute(Qt::WA_DeleteOnClose, true);  // 关闭时自动删除
+
+    ui->roomTable->setColumnCount(2);
+    ui->roomTable->setHorizontalHeaderLabels({"教室", "空闲至"});
+    ui->roomTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    ui->roomTable->verticalHeader()->setVisible(false);
+
+    ui->windowTable->setColumnCount(2);
+    ui->windowTable->setHorizontalHeaderLabels({"空闲开始", "空闲结束"});
+    ui->windowTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    ui->windowTable->verticalHeader()->setVisible(false);
+}
+
+void FreeClassroomDialog::initConnections()
+{
+    connect(ui->queryBtn, &QPushButton::clicked, this, &FreeClassroomDialog::handleQuery);
+    connect(ui->nowBtn, &QPushButton::clicked, this, &FreeClassroomDialog::handleNow);
+    connect(ui->roomTable, &QTableWidget::itemSelectionChanged, this, &FreeClassroomDialog::handleRoomSelected);
+}
+
+// 以当前时间查询
+void FreeClassroomDialog::handleNow()
+{
+    QDateTime now = Clock::currentDateTime();
+    ui->dateEdit->setDate(now.date());
+    ui->timeEdit->setTime(now.time());
+    handleQuery();
+}
+
+void FreeClassroomDialog::handleQuery()
+{
+    QElapsedTimer timer;
+    timer.start();
+    QList<QVariantMap> rooms = DatabaseManager::instance().getFreeClassrooms(ui->dateEdit->date(), ui->timeEdit->time());
+    qint64 elapsedUs = timer.nsecsElapsed() / 1000;
+
+    ui->roomTable->setRowCount(0);
+    ui->windowTable->setRowCount(0);
+    ui->roomTable->setRowCount(rooms.size());
+    for (int row = 0; row < rooms.size(); row++) {
+        const QVariantMap& room = rooms[row];
+        QTableWidgetItem* nameItem = new QTableWidgetItem(room["classroom_name"].toString());
+        nameItem->setData(Qt::UserRole, room["id"]);
+        QString until = room["free_until"].toString();
+        ui->roomTable->setItem(row, 0, nameItem);
+        ui->roomTable->setItem(row, 1, new QTableWidgetItem(until.isEmpty() ? "全天" : until));
+    }
+
+    ui->summaryLabel->setText(QString("%1 %2 空闲教室：%3间（查询耗时%4微秒）")
+                              .arg(ui->dateEdit->date().toString("yyyy-MM-dd"))
+                              .arg(ui->timeEdit->time().toString("HH:mm"))
+                              .arg(rooms.size())
+                              .arg(elapsedUs));
+}
+
+// 选中教室后列出当天空闲时段
+void FreeClassroomDialog::handleRoomSelected()
+{
+    ui->windowTable->setRowCount(0);
+    QList<QTableWidgetItem*> selected = ui->roomTable->selectedItems();
+    if (selected.isEmpty()) {
+        return;
+    }
+
+    int classroomId = ui->roomTable->item(selected.first()->row(), 0)->data(Qt::UserRole).toInt();
+    QList<QVariantMap> windows = DatabaseManager::instance().getFreeWindows(classroomId, ui->dateEdit->date());
+
+    ui->windowTable->setRowCount(windows.size());
+    for (int row = 0; row < windows.size(); row++) {
+        ui->windowTable->setItem(row, 0, new QTableWidgetItem(windows[row]["start_time"].toString()));
+        ui->windowTable->setItem(row, 1, new QTableWidgetItem(windows[row]["end_time"].toString()));
+    }
+}
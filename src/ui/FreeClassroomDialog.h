@@ -0,0 +1,31 @@
+#ifndef FREECLASSROOMDIALOG_H
+#define FREECLASSROOMDIALOG_H
+
+#include <QDialog>
+
+namespace Ui {
+class FreeClassroomDialog;
+}
+
+// 空闲教室查询：指定日期时刻的空闲教室，以及选中教室当天的空闲时段
+class FreeClassroomDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit FreeClassroomDialog(QWidget *parent = nullptr);
+    ~FreeClassroomDialog();
+
+private slots:
+    void handleQuery();
+    void handleNow();
+    void handleRoomSelected();
+
+private:
+    Ui::FreeClassroomDialog *ui;
+
+    void initUI();
+    void initConnections();
+};
+
+#endif // FREECLASSROOMDIALOG_H
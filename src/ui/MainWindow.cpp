@@ -1,5 +1,11 @@
 #include "MainWindow.h"
 #include "ui_MainWindow.h"
+#include "utility/ExportHelper.h"
+#include "utility/Clock.h"
+#include "utility/WeekMask.h"
+#include "data/NoticeRotation.h"
+#include "data/NoticeScheduler.h"
+#include "data/RetentionJob.h"
 
 #include <QFile>
 #include <QIcon>
@@ -9,6 +15,9 @@
 #include <QMessageBox>
 #include <QDateTime>
 #include <QColor>
+#include <QSignalBlocker>
+#include "metrics/MetricsRegistry.h"
+#include "metrics/Tracer.h"
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -18,6 +27,7 @@ MainWindow::MainWindow(QWidget *parent)
     , m_courseTimer(nullptr)
     , m_noticeTimer(nullptr)
     , m_networkWorker(nullptr)
+    , m_syncListener(nullptr)
 {
     ui->setupUi(this);
 
@@ -30,6 +40,7 @@ MainWindow::MainWindow(QWidget *parent)
     }
 
     // 初始化数据库
+    DatabaseManager::instance().setPragmaProfile(SettingsManager::instance().getPragmaProfile());
     DatabaseManager::instance().init(SettingsManager::instance().getDbPath());
 
     // 初始化UI/模型/定时器
@@ -37,23 +48,100 @@ MainWindow::MainWindow(QWidget *parent)
     initModels();
     initTimers();
 
-    // 初始化网络同步
-    m_networkWorker = new NetworkWorker(this);
-    m_networkWorker->setSyncInterval(SettingsManager::instance().getSyncInterval());
-    connect(m_networkWorker, &NetworkWorker::syncSuccess, this, &MainWindow::onSyncSuccess);
-    connect(m_networkWorker, &NetworkWorker::syncFailed, this, &MainWindow::onSyncFailed);
-    emit m_networkWorker->startSyncTimer();
+    // 数据库文件被快照替换后（内嵌模式由本进程替换，daemon模式由 reopen 重新连接后发出）按新库刷新
+    connect(&DatabaseManager::instance(), &DatabaseManager::databaseReplaced, this, &MainWindow::onDatabaseReplaced);
+
+    // 初始化网络同步（daemon模式下由 classboard-syncd 同步，本进程只监听数据变更）
+    if (SettingsManager::instance().isDaemonSyncMode()) {
+        m_syncListener = new SyncChangeListener(this);
+        connect(m_syncListener, &SyncChangeListener::dataChanged, this, [this](const QString&) {
+            // 课表与通知由守护进程改写，本进程的教室区间索引与通知轮播缓存需重建
+            DatabaseManager::instance().invalidateRoomIndex();
+            NoticeRotation::instance().invalidate();
+            NoticeScheduler::instance().reload();
+            onSyncSuccess("同步守护进程已更新数据");
+        });
+        // 守护进程替换数据库文件前须关闭本进程的全部连接（含异步查询线程池），回复后才会改名
+        connect(m_syncListener, &SyncChangeListener::aboutToReplaceDatabase, this, []() {
+            DatabaseManager::instance().release();
+        }, Qt::DirectConnection);
+        connect(m_syncListener, &SyncChangeListener::databaseReplaced, this, []() {
+            // 守护进程已替换数据库文件：重新打开主连接（异步查询连接随之重开），成功后经 databaseReplaced 刷新
+            DatabaseManager::instance().reopen();
+        });
+        connect(m_syncListener, &SyncChangeListener::syncFailed, this, &MainWindow::onSyncFailed);
+        connect(m_syncListener, &SyncChangeListener::urgentNotice, this, [this](const QString& title, const QString& content) {
+            // 守护进程已落库，本进程只需显示并刷新通知缓存
+            onUrgentNotice(title, content);
+            NoticeRotation::instance().invalidate();
+            NoticeScheduler::instance().reload();
+        });
+        m_syncListener->start();
+    } else {
+        m_networkWorker = new NetworkWorker(this);
+        m_networkWorker->setSyncInterval(SettingsManager::instance().getSyncInterval());
+        connect(m_networkWorker, &NetworkWorker::syncSuccess, this, &MainWindow::onSyncSuccess);
+        connect(m_networkWorker, &NetworkWorker::syncFailed, this, &MainWindow::onSyncFailed);
+        connect(m_networkWorker, &NetworkWorker::urgentNoticeReceived, this, &MainWindow::onUrgentNotice);
+        emit m_networkWorker->startSyncTimer();
+        emit m_networkWorker->startUrgentChannel();
+
+        // 数据保留任务（daemon模式下由守护进程执行；通知缓存经 noticesChanged 自动失效）
+        connect(&RetentionJob::instance(), &RetentionJob::finished, this, [this](int, int archivedCourses) {
+            if (archivedCourses > 0) {
+                reloadCourseTable();
+            }
+        });
+        RetentionJob::instance().start();
+    }
+
+    // 可选：内嵌指标服务（/metrics，在独立线程中响应，不占用UI线程）
+    if (SettingsManager::instance().isMetricsEnabled()) {
+        m_metricsServer = new MetricsServer(SettingsManager::instance().getMetricsBindAddress(),
+                                            SettingsManager::instance().getMetricsPort(), this);
+        m_metricsServer->start();
+        m_lagProbe = new EventLoopLagProbe(500, this);
+        m_lagProbe->start();
+    }
+
+    // 可选：界面卡顿看门狗（卡顿结束后导出trace_event文件）
+    if (SettingsManager::instance().isStallWatchdogEnabled()) {
+        m_stallWatchdog = new StallWatchdog(SettingsManager::instance().getStallThresholdMs(),
+                                            SettingsManager::instance().getTraceFilePath(), this);
+        m_stallWatchdog->start();
+    }
+
+    // 模拟时间跳变（跳转到下一节课等）后立即刷新课表与当前课程，不等下一次定时器
+    connect(&Clock::instance(), &Clock::timeJumped, this, [this](const QDateTime&) {
+        reloadCourseTable();
+        if (m_currentClassId != -1) {
+            updateCourseInfo();
+        }
+    });
+
+    // 通知定时发布/过期：到点立即刷新滚动通知，不等下一次轮播
+    connect(&NoticeScheduler::instance(), &NoticeScheduler::noticesActivated, this, [this](const QList<int>& noticeIds) {
+        updateMarqueeNotice();
+        ui->statusBar->showMessage(QString("已发布%1条定时通知").arg(noticeIds.size()), 5000);
+    });
+    connect(&NoticeScheduler::instance(), &NoticeScheduler::noticesDeactivated, this, [this](const QList<int>&) {
+        updateMarqueeNotice();
+    });
+    NoticeScheduler::instance().start();
 
     // 加载初始数据
     loadClassList();
     refreshUI();
 
     // 状态栏提示
-    ui->statusBar->showMessage(QString("系统已就绪 - 当前时间：%1").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
+    ui->statusBar->showMessage(QString("系统已就绪 - 当前时间：%1").arg(Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
 }
 
 MainWindow::~MainWindow()
 {
+    // 尚未执行的课表查询不再需要
+    m_courseFuture.cancel();
+
     if (m_courseTimer) {
         m_courseTimer->stop();
         delete m_courseTimer;
@@ -64,6 +152,11 @@ MainWindow::~MainWindow()
         delete m_noticeTimer;
     }
 
+    // 退出时导出追踪记录
+    if (m_stallWatchdog) {
+        Tracer::instance().dumpChromeTrace(SettingsManager::instance().getTraceFilePath());
+    }
+
     delete ui;
     delete m_courseModel;
     delete m_filterModel;
@@ -84,6 +177,8 @@ void MainWindow::initUI()
     // 下拉框信号
     connect(ui->classComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &MainWindow::onClassSelected);
+    connect(ui->teacherComboBox, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &MainWindow::onTeacherSelected);
 
     // 搜索框信号
     connect(ui->searchEdit, &QLineEdit::textChanged,
@@ -93,13 +188,14 @@ void MainWindow::initUI()
     connect(ui->exportBtn, &QPushButton::clicked, this, &MainWindow::onExportBtnClicked);
     connect(ui->noticeManagerBtn, &QPushButton::clicked, this, &MainWindow::onNoticeManagerBtnClicked);
     connect(ui->settingsBtn, &QPushButton::clicked, this, &MainWindow::onSettingsBtnClicked);
+    connect(ui->freeClassroomBtn, &QPushButton::clicked, this, &MainWindow::onFreeClassroomBtnClicked);
 }
 
 void MainWindow::initModels()
 {
     // 课表模型
     m_courseModel = new QStandardItemModel(this);
-    QStringList courseHeaders = {"星期", "课程名称", "教师", "类型", "开始时间", "结束时间", "教室"};
+    QStringList courseHeaders = {"星期", "课程名称", "教师", "类型", "开始时间", "结束时间", "教室", "上课周"};
     m_courseModel->setHorizontalHeaderLabels(courseHeaders);
 
     // 筛选模型
@@ -125,12 +221,18 @@ void MainWindow::initTimers()
     m_courseTimer = new QTimer(this);
     m_courseTimer->setInterval(1000);
     connect(m_courseTimer, &QTimer::timeout, this, &MainWindow::updateCourseInfo);
+    connect(m_courseTimer, &QTimer::timeout, this, []() {
+        MetricsRegistry::instance().recordTimerWakeup("course");
+    });
     m_courseTimer->start();
 
     // 通知定时器（10秒）
     m_noticeTimer = new QTimer(this);
     m_noticeTimer->setInterval(10000);
     connect(m_noticeTimer, &QTimer::timeout, this, &MainWindow::updateMarqueeNotice);
+    connect(m_noticeTimer, &QTimer::timeout, this, []() {
+        MetricsRegistry::instance().recordTimerWakeup("notice");
+    });
     m_noticeTimer->start();
 }
 
@@ -142,7 +244,7 @@ void MainWindow::onClassSelected(int index)
         m_currentClassId = -1;
         m_currentClassName = "";
         m_courseModel->clear();
-        ui->statusBar->showMessage("未选中任何班级 - 当前时间：" + QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
+        ui->statusBar->showMessage("未选中任何班级 - 当前时间：" + Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
         return;
     }
 
@@ -150,6 +252,13 @@ void MainWindow::onClassSelected(int index)
     m_currentClassId = ui->classComboBox->itemData(index).toInt();
     m_currentClassName = ui->classComboBox->itemText(index);
 
+    // 切换班级时回到班级视图
+    m_currentTeacherId = 0;
+    {
+        QSignalBlocker blocker(ui->teacherComboBox);
+        ui->teacherComboBox->setCurrentIndex(0);
+    }
+
     // 加载课表
     loadCourseTable(m_currentClassId);
     // 立即更新课程信息
@@ -159,7 +268,19 @@ void MainWindow::onClassSelected(int index)
     ui->statusBar->showMessage(QString("已选中：%1（ID：%2） - 当前时间：%3")
                                .arg(m_currentClassName)
                                .arg(m_currentClassId)
-                               .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
+                               .arg(Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
+}
+
+void MainWindow::onTeacherSelected(int index)
+{
+    m_currentTeacherId = index > 0 ? ui->teacherComboBox->itemData(index).toInt() : 0;
+    reloadCourseTable();
+
+    if (m_currentTeacherId > 0) {
+        ui->statusBar->showMessage(QString("教师视图：%1 - 当前时间：%2")
+                                   .arg(ui->teacherComboBox->itemText(index))
+                                   .arg(Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
+    }
 }
 
 void MainWindow::onSearchTextChanged(const QString& text)
@@ -177,14 +298,19 @@ void MainWindow::onExportBtnClicked()
         return;
     }
 
-    QList<QVariantMap> courses = DatabaseManager::instance().getCoursesByClassId(m_currentClassId);
-    bool success = ExportHelper::exportCoursesToExcel(courses, QString("%1课表").arg(m_currentClassName));
-
-    if (success) {
-        QMessageBox::information(this, "成功", QString("%1课表导出成功！").arg(m_currentClassName));
-    } else {
-        QMessageBox::critical(this, "失败", "课表导出失败！\n请确认：\n1. 已安装Microsoft Office\n2. 有桌面写入权限");
-    }
+    // 查询在后台执行，结果送达前禁用按钮防止重复导出
+    const QString className = m_currentClassName;
+    ui->exportBtn->setEnabled(false);
+    AsyncDatabase::instance().getCoursesByClassId(m_currentClassId).then(this, [this, className](const QList<QVariantMap>& courses) {
+        ui->exportBtn->setEnabled(true);
+        bool success = ExportHelper::exportCoursesToExcel(courses, QString("%1课表").arg(className));
+
+        if (success) {
+            QMessageBox::information(this, "成功", QString("%1课表导出成功！").arg(className));
+        } else {
+            QMessageBox::critical(this, "失败", "课表导出失败！\n请确认：\n1. 已安装Microsoft Office\n2. 有桌面写入权限");
+        }
+    });
 }
 
 void MainWindow::onNoticeManagerBtnClicked()
@@ -215,9 +341,21 @@ void MainWindow::onSettingsBtnClicked()
     m_settingsDialog->activateWindow();  // 激活窗口
 }
 
+void MainWindow::onFreeClassroomBtnClicked()
+{
+    if (!m_freeClassroomDialog) {
+        m_freeClassroomDialog = new FreeClassroomDialog(this);
+    }
+
+    m_freeClassroomDialog->show();
+    m_freeClassroomDialog->raise();
+    m_freeClassroomDialog->activateWindow();
+}
+
 // -------------------------- 定时器槽函数 --------------------------
 void MainWindow::updateCourseInfo()
 {
+    CB_TRACE_SPAN("ui.updateCourseInfo");
     if (m_currentClassId == -1) return;
 
     QVariantMap currentCourse = DatabaseManager::instance().getCurrentCourse(m_currentClassId);
@@ -227,111 +365,220 @@ void MainWindow::updateCourseInfo()
     updateNextCourse(nextCourse);
 
     ui->statusBar->showMessage(QString("系统已就绪 - 当前时间：%1 | 选中：%2")
-                               .arg(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"))
+                               .arg(Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"))
                                .arg(m_currentClassName));
 }
 
 void MainWindow::updateMarqueeNotice()
 {
-    QList<QVariantMap> scrollNotices = DatabaseManager::instance().getValidNotices(true);
+    CB_TRACE_SPAN("ui.updateMarqueeNotice");
+    // 轮播环已缓存格式化文本，通知无变化时不访问数据库
+    QString noticeText = NoticeRotation::instance().next();
 
-    if (scrollNotices.isEmpty()) {
+    if (noticeText.isEmpty()) {
         ui->marqueeLabel->setText("欢迎使用教室班牌信息展示系统 - 暂无滚动通知");
         return;
     }
 
-    static int noticeIndex = 0;
-    if (noticeIndex >= scrollNotices.size()) noticeIndex = 0;
-
-    QVariantMap notice = scrollNotices[noticeIndex];
-    QString noticeText = QString("[%1] %2：%3")
-                         .arg(notice["publish_time"].toString().left(10))
-                         .arg(notice["title"].toString())
-                         .arg(notice["content"].toString());
-
     startMarquee(noticeText);
-    noticeIndex++;
 }
 
 // -------------------------- 辅助函数 --------------------------
 void MainWindow::refreshUI()
 {
+    CB_TRACE_SPAN("ui.refreshUI");
+    // 重新加载班级列表会切回班级视图，这里记住当前教师视图并在之后恢复
+    int teacherId = m_currentTeacherId;
     loadClassList();
+    loadTeacherList(teacherId);
+    reloadCourseTable();
 
     if (m_currentClassId != -1) {
-        loadCourseTable(m_currentClassId);
         updateCourseInfo();
     }
 
     updateMarqueeNotice();
 }
 
+void MainWindow::onDatabaseReplaced()
+{
+    // 新库的课表与通知均与旧库不同：重建教室区间索引与通知缓存后整体刷新
+    DatabaseManager::instance().invalidateRoomIndex();
+    NoticeRotation::instance().invalidate();
+    NoticeScheduler::instance().reload();
+    refreshUI();
+}
+
 void MainWindow::loadClassList()
 {
-    // 清空下拉框
-    ui->classComboBox->clear();
+    CB_TRACE_SPAN("ui.loadClassList");
+    // 从数据库取班级列表（后台查询，只采用最后一次请求的结果）
+    const int request = ++m_classListRequest;
+    AsyncDatabase::instance().getAllClasses().then(this, [this, request](const QList<QVariantMap>& classes) {
+        if (request != m_classListRequest) return;
+
+        // 重建下拉框期间不触发切换，之后按需手动切换
+        int selectIndex = -1;
+        {
+            QSignalBlocker blocker(ui->classComboBox);
+            ui->classComboBox->clear();
+
+            // 手动添加每个班级到下拉框，保持原选中的班级
+            for (const QVariantMap& cls : classes) {
+                int classId = cls["id"].toInt();
+                QString className = cls["class_name"].toString();
+                ui->classComboBox->addItem(className, classId);
+                if (classId == m_currentClassId) {
+                    selectIndex = ui->classComboBox->count() - 1;
+                }
+            }
 
-    // 从数据库取班级列表
-    QList<QVariantMap> classes = DatabaseManager::instance().getAllClasses();
+            // 原班级已不存在时默认选中第一个班级
+            if (selectIndex < 0 && ui->classComboBox->count() > 0) {
+                selectIndex = 0;
+            }
+            ui->classComboBox->setCurrentIndex(selectIndex);
+        }
 
-    // 手动添加每个班级到下拉框
-    for (const QVariantMap& cls : classes) {
-        int classId = cls["id"].toInt();
-        QString className = cls["class_name"].toString();
-        ui->classComboBox->addItem(className, classId);
-    }
+        // 启用下拉框
+        ui->classComboBox->setEnabled(ui->classComboBox->count() > 0);
+
+        if (selectIndex < 0) {
+            m_currentClassId = -1;
+            m_currentClassName = "";
+            m_courseModel->clear();
+            ui->statusBar->showMessage("暂无班级数据 - 当前时间：" + Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
+        } else if (ui->classComboBox->itemData(selectIndex).toInt() != m_currentClassId) {
+            onClassSelected(selectIndex);
+        } else {
+            // 班级未变（教师视图保持不变），只同步可能被修改的班级名称
+            m_currentClassName = ui->classComboBox->itemText(selectIndex);
+        }
+    });
+}
 
-    // 启用下拉框
-    ui->classComboBox->setEnabled(ui->classComboBox->count() > 0);
+void MainWindow::loadTeacherList(int selectTeacherId)
+{
+    CB_TRACE_SPAN("ui.loadTeacherList");
+    // 教师列表同样后台查询，只采用最后一次请求的结果
+    const int request = ++m_teacherListRequest;
+    AsyncDatabase::instance().getAllTeachers().then(this, [this, request, selectTeacherId](const QList<QVariantMap>& teachers) {
+        if (request != m_teacherListRequest) return;
+
+        int selectIndex = 0;
+        {
+            QSignalBlocker blocker(ui->teacherComboBox);
+            ui->teacherComboBox->clear();
+            ui->teacherComboBox->addItem("（按班级）", 0);
+
+            for (const QVariantMap& teacher : teachers) {
+                int teacherId = teacher["id"].toInt();
+                ui->teacherComboBox->addItem(teacher["teacher_name"].toString(), teacherId);
+                if (teacherId == selectTeacherId) {
+                    selectIndex = ui->teacherComboBox->count() - 1;
+                }
+            }
+            ui->teacherComboBox->setCurrentIndex(selectIndex);
+        }
 
-    // 默认选中第一个班级
-    if (ui->classComboBox->count() > 0) {
-        ui->classComboBox->setCurrentIndex(0);
-    } else {
-        m_currentClassId = -1;
-        m_currentClassName = "";
-        m_courseModel->clear();
-        ui->statusBar->showMessage("暂无班级数据 - 当前时间：" + QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
+        // 原教师已不存在时回到班级视图
+        const int teacherId = ui->teacherComboBox->itemData(selectIndex).toInt();
+        if (teacherId != m_currentTeacherId) {
+            m_currentTeacherId = teacherId;
+            reloadCourseTable();
+        }
+    });
+}
+
+void MainWindow::reloadCourseTable()
+{
+    if (m_currentTeacherId > 0) {
+        loadTeacherTable(m_currentTeacherId);
+    } else if (m_currentClassId != -1) {
+        loadCourseTable(m_currentClassId);
     }
 }
 
 void MainWindow::loadCourseTable(int classId)
 {
-    m_courseModel->clear();
-    QStringList courseHeaders = {"星期", "课程名称", "教师", "类型", "开始时间", "结束时间", "教室"};
-    m_courseModel->setHorizontalHeaderLabels(courseHeaders);
+    CB_TRACE_SPAN("ui.loadCourseTable");
+    // 快速切换班级时取消尚未执行的旧查询；已在执行的查询结果按序号丢弃
+    m_courseFuture.cancel();
+    const int request = ++m_courseRequest;
 
-    QList<QVariantMap> courses = DatabaseManager::instance().getCoursesByClassId(classId);
-
-    for (const QVariantMap& course : courses) {
-        QList<QStandardItem*> items;
-
-        // 星期转换
-        QStringList weekDays = { "", "周一", "周二", "周三", "周四", "周五", "周六", "周日" };
-        int dayOfWeekInt = course["day_of_week"].toInt();
-        QString dayOfWeek = (dayOfWeekInt >= 1 && dayOfWeekInt <=7) ? weekDays[dayOfWeekInt] : "未知";
-
-        items.append(new QStandardItem(dayOfWeek));
-        items.append(new QStandardItem(course["course_name"].toString()));
-        items.append(new QStandardItem(course["teacher"].toString()));
-        items.append(new QStandardItem(course["course_type"].toString()));
-        items.append(new QStandardItem(course["start_time"].toString()));
-        items.append(new QStandardItem(course["end_time"].toString()));
-        QString classroomName = course["classroom_name"].toString();
-                if (classroomName.isEmpty()) {
-                    classroomName = "未分配";
-                }
-        items.append(new QStandardItem(classroomName));
+    // 结果送达后再清空模型，查询期间保留旧课表而不是闪成空表
+    m_courseFuture = AsyncDatabase::instance().getCoursesByClassId(classId);
+    m_courseFuture.then(this, [this, request](const QList<QVariantMap>& courses) {
+        if (request != m_courseRequest) return;
 
-        for (QStandardItem* item : items) {
-            item->setEditable(false);
-            if (TimeHelper::isTimeInRange(course["start_time"].toString(), course["end_time"].toString())) {
-                item->setBackground(QColor(255, 240, 240));
-            }
+        m_courseModel->clear();
+        QStringList courseHeaders = {"星期", "课程名称", "教师", "类型", "开始时间", "结束时间", "教室", "上课周"};
+        m_courseModel->setHorizontalHeaderLabels(courseHeaders);
+
+        const DayTime now = TimeHelper::now();
+        for (const QVariantMap& course : courses) {
+            appendCourseRow(course, course["teacher"].toString(), now);
+        }
+    });
+}
+
+void MainWindow::loadTeacherTable(int teacherId)
+{
+    CB_TRACE_SPAN("ui.loadTeacherTable");
+    // 与班级课表共用请求序号：两种视图快速切换时只显示最后一次请求的结果
+    m_courseFuture.cancel();
+    const int request = ++m_courseRequest;
+
+    m_courseFuture = AsyncDatabase::instance().getCoursesByTeacher(teacherId);
+    m_courseFuture.then(this, [this, request](const QList<QVariantMap>& courses) {
+        if (request != m_courseRequest) return;
+
+        m_courseModel->clear();
+        QStringList courseHeaders = {"星期", "课程名称", "班级", "类型", "开始时间", "结束时间", "教室", "上课周"};
+        m_courseModel->setHorizontalHeaderLabels(courseHeaders);
+
+        const DayTime now = TimeHelper::now();
+        for (const QVariantMap& course : courses) {
+            appendCourseRow(course, course["class_name"].toString(), now);
         }
+    });
+}
 
-        m_courseModel->appendRow(items);
+// 课表一行：第三列在班级视图为教师、在教师视图为班级
+void MainWindow::appendCourseRow(const QVariantMap& course, const QString& ownerText, const DayTime& now)
+{
+    // 星期转换
+    static const QStringList weekDays = { "", "周一", "周二", "周三", "周四", "周五", "周六", "周日" };
+
+    QList<QStandardItem*> items;
+
+    int dayOfWeekInt = course["day_of_week"].toInt();
+    QString dayOfWeek = (dayOfWeekInt >= 1 && dayOfWeekInt <=7) ? weekDays[dayOfWeekInt] : "未知";
+
+    items.append(new QStandardItem(dayOfWeek));
+    items.append(new QStandardItem(course["course_name"].toString()));
+    items.append(new QStandardItem(ownerText));
+    items.append(new QStandardItem(course["course_type"].toString()));
+    items.append(new QStandardItem(course["start_time"].toString()));
+    items.append(new QStandardItem(course["end_time"].toString()));
+    QString classroomName = course["classroom_name"].toString();
+    if (classroomName.isEmpty()) {
+        classroomName = "未分配";
     }
+    items.append(new QStandardItem(classroomName));
+    items.append(new QStandardItem(WeekMask::toString(course["week_mask"].toLongLong())));
+
+    // 每行只判断一次是否正在上课（起止时间已在查询时解析为秒数）
+    const bool inProgress = TimeHelper::isTimeInRange(DayTime(course["start_secs"].toInt()),
+                                                      DayTime(course["end_secs"].toInt()), now);
+    for (QStandardItem* item : items) {
+        item->setEditable(false);
+        if (inProgress) {
+            item->setBackground(QColor(255, 240, 240));
+        }
+    }
+
+    m_courseModel->appendRow(items);
 }
 
 void MainWindow::updateCurrentCourse(const QVariantMap& course)
@@ -340,7 +587,7 @@ void MainWindow::updateCurrentCourse(const QVariantMap& course)
         ui->currentCourseName->setText("暂无课程");
         ui->currentCourseTeacher->setText("任课教师：暂无");
         ui->currentCourseTime->setText("上课时间：--:-- 至 --:--");
-        ui->countdownLabel->setText("倒计时：00:00:00");
+        updateCountdown(-1);
         return;
     }
 
@@ -353,8 +600,28 @@ void MainWindow::updateCurrentCourse(const QVariantMap& course)
     ui->currentCourseTime->setText(QString("上课时间：%1 至 %2")
                                    .arg(course["start_time"].toString(), course["end_time"].toString()));
 
-    QString countdown = TimeHelper::getCountdown(course["end_time"].toString());
-    ui->countdownLabel->setText(QString("倒计时：%1").arg(countdown));
+    updateCountdown(course["end_secs"].toInt());
+}
+
+// 倒计时：数字直接写入复用的文本缓冲（缓冲不与标签共享，不会重新分配），秒数未变化时不刷新标签
+void MainWindow::updateCountdown(int endSecs)
+{
+    int remaining = 0;
+    if (endSecs >= 0) {
+        remaining = qMax(0, TimeHelper::now().secsTo(DayTime(endSecs)));
+    }
+    if (remaining == m_lastCountdownSecs) {
+        return;
+    }
+    m_lastCountdownSecs = remaining;
+
+    static const QString prefix = "倒计时：";
+    if (m_countdownText.size() != prefix.size() + 8) {
+        m_countdownText = prefix + "00:00:00";
+    }
+    TimeHelper::formatCountdown(remaining, m_countdownText.data() + prefix.size());
+    // 传给标签的是副本（标签本就要持有一份文本）：若与标签共享，下次 data() 会触发分离并重新分配缓冲
+    ui->countdownLabel->setText(QString(m_countdownText.constData(), m_countdownText.size()));
 }
 
 void MainWindow::updateNextCourse(const QVariantMap& course)
@@ -387,6 +654,7 @@ void MainWindow::startMarquee(const QString& text)
     QTimer* marqueeTimer = new QTimer(this);
     marqueeTimer->setInterval(500); // 滚动速度（已调整为适中）
     connect(marqueeTimer, &QTimer::timeout, this, [=]() {
+        MetricsRegistry::instance().recordTimerWakeup("marquee");
         if (pos > fullText.length()) {
             pos = 0;
         }
@@ -407,13 +675,24 @@ void MainWindow::startMarquee(const QString& text)
 void MainWindow::onSyncSuccess(const QString& msg)
 {
     ui->statusBar->showMessage(QString("数据同步成功：%1 | 当前时间：%2")
-                               .arg(msg).arg(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
+                               .arg(msg).arg(Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
     refreshUI();
 }
 
+void MainWindow::onUrgentNotice(const QString& title, const QString& content)
+{
+    if (!m_urgentOverlay) {
+        m_urgentOverlay = new UrgentOverlay(this);
+    }
+    m_urgentOverlay->showNotice(title, content);
+    ui->statusBar->showMessage(QString("收到紧急通知：%1 | 当前时间：%2")
+                               .arg(title, Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
+}
+
 void MainWindow::onSyncFailed(const QString& msg)
 {
+    CB_TRACE_SPAN("ui.onSyncFailed");
     ui->statusBar->showMessage(QString("数据同步失败：%1 | 当前时间：%2")
-                               .arg(msg).arg(QDateTime::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
+                               .arg(msg).arg(Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss")));
     QMessageBox::warning(this, "同步警告", msg);
 }
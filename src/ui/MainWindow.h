@@ -8,13 +8,20 @@
 #include <QMessageBox>
 #include <QDateTime>
 #include <QPointer>
+#include <QFuture>
 #include "data/DatabaseManager.h"
+#include "data/AsyncDatabase.h"
 #include "network/NetworkWorker.h"
+#include "network/SyncChangeListener.h"
+#include "metrics/MetricsServer.h"
+#include "metrics/EventLoopLagProbe.h"
+#include "metrics/StallWatchdog.h"
 #include "settings/SettingsManager.h"
 #include "utility/TimeHelper.h"
-#include "utility/ExportHelper.h"
 #include "ui/NoticeManager.h"
 #include "ui/SettingsDialog.h"
+#include "ui/FreeClassroomDialog.h"
+#include "ui/UrgentOverlay.h"
 
 QT_BEGIN_NAMESPACE
 namespace Ui { class MainWindow; }
@@ -31,10 +38,12 @@ public:
 private slots:
     // 界面交互槽函数
     void onClassSelected(int index);
+    void onTeacherSelected(int index);
     void onSearchTextChanged(const QString& text);
     void onExportBtnClicked();
     void onNoticeManagerBtnClicked();
     void onSettingsBtnClicked();
+    void onFreeClassroomBtnClicked();
 
     // 定时器槽函数
     void updateCourseInfo();
@@ -44,6 +53,8 @@ private slots:
     void refreshUI();
     void onSyncSuccess(const QString& msg);
     void onSyncFailed(const QString& msg);
+    void onUrgentNotice(const QString& title, const QString& content);
+    void onDatabaseReplaced();               // 数据库文件已被快照替换（两种同步模式共用）
 
 private:
     Ui::MainWindow *ui;
@@ -55,26 +66,48 @@ private:
     // 状态变量
     int m_currentClassId = -1;               // 当前选中班级ID
     QString m_currentClassName = "";         // 当前选中班级名称
+    int m_currentTeacherId = 0;              // 教师视图的教师ID（0表示班级视图）
+
+    // 异步查询：新请求发出时取消旧请求，结果送达时序号不一致则丢弃
+    QFuture<QList<QVariantMap>> m_courseFuture;
+    int m_courseRequest = 0;                 // 课表加载序号（班级课表与教师课表共用）
+    int m_classListRequest = 0;              // 班级列表加载序号
+    int m_teacherListRequest = 0;            // 教师列表加载序号
 
     // 定时器
     QTimer* m_courseTimer = nullptr;         // 课程信息更新定时器（1秒）
     QTimer* m_noticeTimer = nullptr;         // 通知滚动定时器（5秒）
 
+    // 倒计时显示缓冲（每秒只改写其中的数字）
+    QString m_countdownText;
+    int m_lastCountdownSecs = -1;
+
     // 核心组件
     NetworkWorker* m_networkWorker = nullptr;  // 网络同步组件
+    SyncChangeListener* m_syncListener = nullptr; // 守护进程变更监听（daemon同步模式）
+    MetricsServer* m_metricsServer = nullptr;  // 指标服务（可选）
+    EventLoopLagProbe* m_lagProbe = nullptr;   // GUI事件循环延迟探针（随指标服务启用）
+    StallWatchdog* m_stallWatchdog = nullptr;  // 界面卡顿看门狗（可选）
 
     // 使用QPointer管理对话框，当对话框被删除时会自动设置为nullptr
     QPointer<NoticeManager> m_noticeManager;   // 通知管理窗口
     QPointer<SettingsDialog> m_settingsDialog; // 系统设置窗口
+    QPointer<FreeClassroomDialog> m_freeClassroomDialog; // 空闲教室查询窗口
+    UrgentOverlay* m_urgentOverlay = nullptr;  // 紧急通知覆盖层（首次收到时创建）
 
     // 辅助函数
     void initUI();                           // 初始化UI
     void initModels();                       // 初始化数据模型
     void initTimers();                       // 初始化定时器
     void loadClassList();                    // 加载班级列表
+    void loadTeacherList(int selectTeacherId = 0); // 加载教师列表（保持指定教师选中）
     void loadCourseTable(int classId);       // 加载班级课表
+    void loadTeacherTable(int teacherId);    // 加载教师课表
+    void reloadCourseTable();                // 按当前视图（班级/教师）重新加载课表
+    void appendCourseRow(const QVariantMap& course, const QString& ownerText, const DayTime& now);
     void updateCurrentCourse(const QVariantMap& course); // 更新当前课程
     void updateNextCourse(const QVariantMap& course);     // 更新下节课
+    void updateCountdown(int endSecs);       // 更新倒计时（endSecs<0 表示无课程）
     void startMarquee(const QString& text);  // 启动通知滚动
 };
 
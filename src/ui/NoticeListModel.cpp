@@ -0,0 +1,264 @@
+#include "NoticeListModel.h"
+
+// 每页条数（约为一屏半，首屏一次取够，滚动时再按页追加）
+static const int kNoticePageSize = 64;
+
+NoticeListModel::NoticeListModel(QObject* parent) : QAbstractTableModel(parent)
+{
+}
+
+int NoticeListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+int NoticeListModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant NoticeListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size()) {
+        return QVariant();
+    }
+    if (role != Qt::DisplayRole && role != Qt::ToolTipRole) {
+        return QVariant();
+    }
+
+    const QVariantMap& notice = m_rows[index.row()];
+    switch (index.column()) {
+    case IdColumn: return notice["id"];
+    case TitleColumn:
+        return (role == Qt::DisplayRole && notice.contains("title_highlight")) ? notice["title_highlight"] : notice["title"];
+    case ContentColumn:
+        return (role == Qt::DisplayRole && notice.contains("snippet")) ? notice["snippet"] : notice["content"];
+    case PublishTimeColumn: return notice["publish_time"];
+    case ExpireTimeColumn: return notice["expire_time"];
+    case ScrollingColumn: return notice["is_scrolling"].toBool() ? "是" : "否";
+    case ValidColumn: return notice["is_valid"].toBool() ? "是" : "否";
+    default: return QVariant();
+    }
+}
+
+QVariant NoticeListModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    switch (section) {
+    case IdColumn: return "ID";
+    case TitleColumn: return "标题";
+    case ContentColumn: return "内容";
+    case PublishTimeColumn: return "发布时间";
+    case ExpireTimeColumn: return "过期时间";
+    case ScrollingColumn: return "是否滚动";
+    case ValidColumn: return "是否有效";
+    default: return QVariant();
+    }
+}
+
+bool NoticeListModel::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && !m_exhausted;
+}
+
+void NoticeListModel::fetchMore(const QModelIndex& parent)
+{
+    if (parent.isValid() || m_exhausted) {
+        return;
+    }
+
+    if (isSearching()) {
+        QList<QVariantMap> hits = DatabaseManager::instance().searchNotices(m_searchText, kNoticePageSize, m_rows.size());
+        m_exhausted = hits.size() < kNoticePageSize;
+        if (!hits.isEmpty()) {
+            beginInsertRows(QModelIndex(), m_rows.size(), m_rows.size() + hits.size() - 1);
+            m_rows.append(hits);
+            endInsertRows();
+        }
+        return;
+    }
+
+    // 从已加载的最后一行之后继续取（首页时游标为空）
+    QString afterPublishTime;
+    int afterId = 0;
+    if (!m_rows.isEmpty()) {
+        afterPublishTime = m_rows.last()["publish_time"].toString();
+        afterId = m_rows.last()["id"].toInt();
+    }
+
+    QList<QVariantMap> page = DatabaseManager::instance().getNoticePage(
+        m_status, m_fromDate, m_toDate, afterPublishTime, afterId, kNoticePageSize);
+    m_exhausted = page.size() < kNoticePageSize;
+    if (page.isEmpty()) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), m_rows.size(), m_rows.size() + page.size() - 1);
+    m_rows.append(page);
+    endInsertRows();
+}
+
+void NoticeListModel::setFilter(DatabaseManager::NoticeStatusFilter status, const QString& fromDate,
+                                const QString& toDate)
+{
+    m_status = status;
+    m_fromDate = fromDate;
+    m_toDate = toDate;
+    reload();
+}
+
+void NoticeListModel::setSearchText(const QString& keyword)
+{
+    m_searchText = keyword.trimmed();
+    reload();
+}
+
+void NoticeListModel::reload()
+{
+    beginResetModel();
+    m_rows.clear();
+    m_exhausted = false;
+    endResetModel();
+    fetchMore(QModelIndex());
+}
+
+QVariantMap NoticeListModel::noticeAt(int row) const
+{
+    return (row >= 0 && row < m_rows.size()) ? m_rows[row] : QVariantMap();
+}
+
+void NoticeListModel::refreshNotice(int noticeId)
+{
+    QVariantMap notice = DatabaseManager::instance().getNoticeById(noticeId);
+    int row = rowOfNotice(noticeId);
+
+    if (isSearching()) {
+        // 检索结果按相关度排列，只同步已列出的行（保留命中片段），新通知不插入
+        if (row < 0) {
+            return;
+        }
+        if (notice.isEmpty()) {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_rows.removeAt(row);
+            endRemoveRows();
+            return;
+        }
+        notice["title_highlight"] = m_rows[row]["title_highlight"];
+        notice["snippet"] = m_rows[row]["snippet"];
+        m_rows[row] = notice;
+        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+        return;
+    }
+
+    if (notice.isEmpty() || !matchesFilter(notice)) {
+        if (row >= 0) {
+            beginRemoveRows(QModelIndex(), row, row);
+            m_rows.removeAt(row);
+            endRemoveRows();
+        }
+        return;
+    }
+
+    if (row >= 0 && m_rows[row]["publish_time"] == notice["publish_time"]) {
+        // 排序键未变，原地更新
+        m_rows[row] = notice;
+        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+        return;
+    }
+    if (row >= 0) {
+        beginRemoveRows(QModelIndex(), row, row);
+        m_rows.removeAt(row);
+        endRemoveRows();
+    }
+
+    // 排在已加载范围之后的行留给后续翻页取出，避免重复
+    if (!m_exhausted && (m_rows.isEmpty() || !sortsBefore(notice, m_rows.last()))) {
+        return;
+    }
+    int insertAt = 0;
+    while (insertAt < m_rows.size() && sortsBefore(m_rows[insertAt], notice)) {
+        insertAt++;
+    }
+    beginInsertRows(QModelIndex(), insertAt, insertAt);
+    m_rows.insert(insertAt, notice);
+    endInsertRows();
+}
+
+void NoticeListModel::removeNotice(int noticeId)
+{
+    int row = rowOfNotice(noticeId);
+    if (row < 0) {
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row);
+    m_rows.removeAt(row);
+    endRemoveRows();
+}
+
+void NoticeListModel::refreshNotices(const QList<int>& noticeIds)
+{
+    if (noticeIds.size() > kNoticePageSize) {
+        reload();
+        return;
+    }
+    for (int noticeId : noticeIds) {
+        refreshNotice(noticeId);
+    }
+}
+
+void NoticeListModel::removeNotices(const QList<int>& noticeIds)
+{
+    if (noticeIds.size() > kNoticePageSize) {
+        reload();
+        return;
+    }
+    for (int noticeId : noticeIds) {
+        removeNotice(noticeId);
+    }
+}
+
+int NoticeListModel::rowOfNotice(int noticeId) const
+{
+    for (int row = 0; row < m_rows.size(); row++) {
+        if (m_rows[row]["id"].toInt() == noticeId) {
+            return row;
+        }
+    }
+    return -1;
+}
+
+// 与 DatabaseManager::getNoticePage 的筛选条件保持一致
+bool NoticeListModel::matchesFilter(const QVariantMap& notice) const
+{
+    bool isValid = notice["is_valid"].toBool();
+    switch (m_status) {
+    case DatabaseManager::ValidNotices:
+        if (!isValid) return false;
+        break;
+    case DatabaseManager::InvalidNotices:
+        if (isValid) return false;
+        break;
+    case DatabaseManager::ScrollingNotices:
+        if (!isValid || !notice["is_scrolling"].toBool()) return false;
+        break;
+    default:
+        break;
+    }
+
+    QString publishDate = notice["publish_time"].toString().left(10);
+    if (!m_fromDate.isEmpty() && publishDate < m_fromDate) return false;
+    if (!m_toDate.isEmpty() && publishDate > m_toDate) return false;
+    return true;
+}
+
+bool NoticeListModel::sortsBefore(const QVariantMap& a, const QVariantMap& b)
+{
+    QString timeA = a["publish_time"].toString();
+    QString timeB = b["publish_time"].toString();
+    if (timeA != timeB) {
+        return timeA > timeB;
+    }
+    return a["id"].toInt() > b["id"].toInt();
+}
@@ -0,0 +1,63 @@
+#ifndef NOTICELISTMODEL_H
+#define NOTICELISTMODEL_H
+
+#include <QAbstractTableModel>
+#include <QVariantMap>
+#include "data/DatabaseManager.h"
+
+// 通知列表模型（通知管理界面用）
+// 按 (publish_time, id) 倒序键集分页：视图滚动到底部时经 canFetchMore/fetchMore 再取一页
+// （检索模式按相关度排序，以偏移量翻页），
+// 增删改后只刷新受影响的行，不重新查询整表
+class NoticeListModel : public QAbstractTableModel
+{
+    Q_OBJECT
+public:
+    enum Column { IdColumn = 0, TitleColumn, ContentColumn, PublishTimeColumn,
+                  ExpireTimeColumn, ScrollingColumn, ValidColumn, ColumnCount };
+
+    explicit NoticeListModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    // 设置筛选条件（SQL端过滤）并从第一页重新加载；日期为 yyyy-MM-dd，空表示不限
+    void setFilter(DatabaseManager::NoticeStatusFilter status, const QString& fromDate, const QString& toDate);
+    // 全文检索模式：关键词非空时按相关度列出命中通知（内容列显示命中片段），忽略状态/日期筛选
+    void setSearchText(const QString& keyword);
+    bool isSearching() const { return !m_searchText.isEmpty(); }
+    QString searchText() const { return m_searchText; }
+    // 按当前条件从第一页重新加载
+    void reload();
+
+    // 指定行的通知（id、title、content、publish_time、expire_time、is_scrolling、is_valid）
+    QVariantMap noticeAt(int row) const;
+
+    // 单条通知变更后同步该行：已删除或不再符合筛选条件则移除，新通知插入到排序位置
+    void refreshNotice(int noticeId);
+    // 移除单条通知所在行
+    void removeNotice(int noticeId);
+    // 批量版本（多选操作后调用）：条数超过一页时直接按当前条件重新加载
+    void refreshNotices(const QList<int>& noticeIds);
+    void removeNotices(const QList<int>& noticeIds);
+
+private:
+    int rowOfNotice(int noticeId) const;
+    bool matchesFilter(const QVariantMap& notice) const;
+    // a 是否排在 b 之前（publish_time、id 均倒序）
+    static bool sortsBefore(const QVariantMap& a, const QVariantMap& b);
+
+    QList<QVariantMap> m_rows;          // 已加载的通知（按排序顺序）
+    bool m_exhausted = false;           // 已加载到最后一页
+    DatabaseManager::NoticeStatusFilter m_status = DatabaseManager::AllNotices;
+    QString m_fromDate;
+    QString m_toDate;
+    QString m_searchText;               // 检索关键词（空表示普通列表）
+};
+
+#endif // NOTICELISTMODEL_H
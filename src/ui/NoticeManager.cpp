@@ -1,7 +1,10 @@
 #include "NoticeManager.h"
 #include "ui_NoticeManager.h"
+#include "NoticeListModel.h"
 #include "data/DatabaseManager.h"
+#include "data/AsyncDatabase.h"
 #include "utility/ExportHelper.h"
+#include "utility/Clock.h"
 
 #include <QMessageBox>
 #include <QHeaderView>
@@ -13,12 +16,16 @@
 #include <QDateTimeEdit>
 #include <QDateEdit>
 #include <QCheckBox>
+#include <QComboBox>
+#include <QTimer>
 #include <QHBoxLayout>
+#include <algorithm>
 
 NoticeManager::NoticeManager(QWidget *parent)
     : QDialog(parent)
     , ui(new Ui::NoticeManager)
     , m_noticeModel(nullptr)
+    , m_searchDebounce(nullptr)
 {
     ui->setupUi(this);
     initUI();
@@ -29,7 +36,6 @@ NoticeManager::NoticeManager(QWidget *parent)
 NoticeManager::~NoticeManager()
 {
     delete ui;
-    delete m_noticeModel;
 }
 
 // 初始化UI
@@ -41,29 +47,21 @@ void NoticeManager::initUI()
     this->setAttribute(Qt::WA_DeleteOnClose, true);  // 关闭时自动删除
 }
 
-// 初始化数据模型
+// 初始化数据模型（分页加载，滚动到底部时再取下一页）
 void NoticeManager::initModel()
 {
-    m_noticeModel = new QSqlTableModel(this, DatabaseManager::instance().getDb());
-    m_noticeModel->setTable("notices");
-
-    // 设置表头
-    m_noticeModel->setHeaderData(0, Qt::Horizontal, "ID");
-    m_noticeModel->setHeaderData(1, Qt::Horizontal, "标题");
-    m_noticeModel->setHeaderData(2, Qt::Horizontal, "内容");
-    m_noticeModel->setHeaderData(3, Qt::Horizontal, "发布时间");
-    m_noticeModel->setHeaderData(4, Qt::Horizontal, "过期时间");
-    m_noticeModel->setHeaderData(5, Qt::Horizontal, "是否滚动");
-    m_noticeModel->setHeaderData(6, Qt::Horizontal, "是否有效");
-
-    // 按发布时间降序排序
-    m_noticeModel->setSort(3, Qt::DescendingOrder);
-    m_noticeModel->select();
+    m_noticeModel = new NoticeListModel(this);
+
+    // 日期筛选默认近30天
+    ui->fromDateEdit->setDate(Clock::currentDate().addDays(-30));
+    ui->toDateEdit->setDate(Clock::currentDate());
 
     // 绑定到TableView
     ui->noticeTableView->setModel(m_noticeModel);
     ui->noticeTableView->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     ui->noticeTableView->verticalHeader()->setVisible(false);
+
+    applyFilter();
 }
 
 // 初始化信号槽
@@ -72,14 +70,67 @@ void NoticeManager::initConnections()
     connect(ui->addBtn, &QPushButton::clicked, this, &NoticeManager::handleAddNotice);
     connect(ui->deleteBtn, &QPushButton::clicked, this, &NoticeManager::handleDeleteNotice);
     connect(ui->scrollBtn, &QPushButton::clicked, this, &NoticeManager::handleToggleScroll);
+    connect(ui->invalidateBtn, &QPushButton::clicked, this, &NoticeManager::handleInvalidateNotice);
     connect(ui->exportNoticeBtn, &QPushButton::clicked, this, &NoticeManager::handleExportNotice);
+
+    // 筛选条件变化后从第一页重新查询
+    connect(ui->statusFilterCombo, &QComboBox::currentIndexChanged, this, &NoticeManager::applyFilter);
+    connect(ui->dateFilterCheck, &QCheckBox::toggled, this, [this](bool checked) {
+        ui->fromDateEdit->setEnabled(checked);
+        ui->toDateEdit->setEnabled(checked);
+        applyFilter();
+    });
+    connect(ui->fromDateEdit, &QDateEdit::dateChanged, this, &NoticeManager::applyFilter);
+    connect(ui->toDateEdit, &QDateEdit::dateChanged, this, &NoticeManager::applyFilter);
+
+    // 全文检索（输入停顿300ms后执行）
+    m_searchDebounce = new QTimer(this);
+    m_searchDebounce->setSingleShot(true);
+    m_searchDebounce->setInterval(300);
+    connect(m_searchDebounce, &QTimer::timeout, this, &NoticeManager::applySearch);
+    connect(ui->searchEdit, &QLineEdit::textChanged, m_searchDebounce, qOverload<>(&QTimer::start));
+    connect(ui->searchEdit, &QLineEdit::returnPressed, this, &NoticeManager::applySearch);
+}
+
+// 按当前筛选条件重新加载
+void NoticeManager::applyFilter()
+{
+    if (!m_noticeModel) {
+        return;
+    }
+    auto status = static_cast<DatabaseManager::NoticeStatusFilter>(ui->statusFilterCombo->currentIndex());
+    QString fromDate;
+    QString toDate;
+    if (ui->dateFilterCheck->isChecked()) {
+        fromDate = ui->fromDateEdit->date().toString("yyyy-MM-dd");
+        toDate = ui->toDateEdit->date().toString("yyyy-MM-dd");
+    }
+    m_noticeModel->setFilter(status, fromDate, toDate);
+}
+
+// 按搜索框内容检索；清空后恢复按筛选条件的列表
+void NoticeManager::applySearch()
+{
+    m_searchDebounce->stop();
+    QString keyword = ui->searchEdit->text().trimmed();
+    if (keyword == m_noticeModel->searchText()) {
+        return;
+    }
+
+    // 检索结果按相关度排列，与状态/日期筛选互斥
+    bool searching = !keyword.isEmpty();
+    ui->statusFilterCombo->setEnabled(!searching);
+    ui->dateFilterCheck->setEnabled(!searching);
+    ui->fromDateEdit->setEnabled(!searching && ui->dateFilterCheck->isChecked());
+    ui->toDateEdit->setEnabled(!searching && ui->dateFilterCheck->isChecked());
+    m_noticeModel->setSearchText(keyword);
 }
 
 // 刷新通知列表（你的主窗口会调用）
 void NoticeManager::refreshNoticeList()
 {
     if (m_noticeModel) {
-        m_noticeModel->select();
+        m_noticeModel->reload();
     }
 }
 
@@ -89,65 +140,116 @@ void NoticeManager::handleAddNotice()
     showAddNoticeDialog();
 }
 
-// 删除通知
+// 当前选中的通知（按列表顺序）
+QList<QVariantMap> NoticeManager::selectedNotices() const
+{
+    QList<QVariantMap> notices;
+    QModelIndexList rows = ui->noticeTableView->selectionModel()->selectedRows();
+    std::sort(rows.begin(), rows.end());
+    for (const QModelIndex& index : rows) {
+        notices.append(m_noticeModel->noticeAt(index.row()));
+    }
+    return notices;
+}
+
+// 删除通知（支持多选，一个事务）
 void NoticeManager::handleDeleteNotice()
 {
-    QModelIndex index = ui->noticeTableView->currentIndex();
-    if (!index.isValid()) {
-        QMessageBox::warning(this, "警告", "请先选中一条通知！");
+    QList<QVariantMap> notices = selectedNotices();
+    if (notices.isEmpty()) {
+        QMessageBox::warning(this, "警告", "请先选中至少一条通知！");
         return;
     }
 
-    int noticeId = m_noticeModel->data(m_noticeModel->index(index.row(), 0)).toInt();
-    QString noticeTitle = m_noticeModel->data(m_noticeModel->index(index.row(), 1)).toString();
+    QList<int> noticeIds;
+    for (const QVariantMap& notice : notices) {
+        noticeIds.append(notice["id"].toInt());
+    }
 
-    if (QMessageBox::question(this, "确认删除", QString("是否删除通知「%1」（ID：%2）？")
-                              .arg(noticeTitle).arg(noticeId)) == QMessageBox::Yes) {
-        bool success = DatabaseManager::instance().deleteNotice(noticeId);
-        if (success) {
-            QMessageBox::information(this, "成功", "通知删除成功！");
-            refreshNoticeList();
-        } else {
-            QMessageBox::critical(this, "失败", "通知删除失败！");
-        }
+    QString question = notices.size() == 1
+        ? QString("是否删除通知「%1」（ID：%2）？").arg(notices.first()["title"].toString()).arg(noticeIds.first())
+        : QString("是否删除选中的 %1 条通知？").arg(notices.size());
+    if (QMessageBox::question(this, "确认删除", question) != QMessageBox::Yes) {
+        return;
+    }
+
+    int deleted = DatabaseManager::instance().deleteNotices(noticeIds);
+    if (deleted >= 0) {
+        m_noticeModel->removeNotices(noticeIds);
+        QMessageBox::information(this, "成功", QString("已删除 %1 条通知！").arg(deleted));
+    } else {
+        QMessageBox::critical(this, "失败", "通知删除失败！");
     }
 }
 
-// 切换滚动状态
+// 切换滚动状态（多选时：只要有未滚动的就全部开启，否则全部关闭）
 void NoticeManager::handleToggleScroll()
 {
-    QModelIndex index = ui->noticeTableView->currentIndex();
-    if (!index.isValid()) {
-        QMessageBox::warning(this, "警告", "请先选中一条通知！");
+    QList<QVariantMap> notices = selectedNotices();
+    if (notices.isEmpty()) {
+        QMessageBox::warning(this, "警告", "请先选中至少一条通知！");
         return;
     }
 
-    int noticeId = m_noticeModel->data(m_noticeModel->index(index.row(), 0)).toInt();
-    bool isScrolling = m_noticeModel->data(m_noticeModel->index(index.row(), 5)).toInt() == 1;
+    QList<int> noticeIds;
+    bool enable = false;
+    for (const QVariantMap& notice : notices) {
+        noticeIds.append(notice["id"].toInt());
+        if (!notice["is_scrolling"].toBool()) {
+            enable = true;
+        }
+    }
 
-    bool success = DatabaseManager::instance().updateNoticeStatus(noticeId, !isScrolling, true);
-    if (success) {
-        QString status = !isScrolling ? "开启" : "关闭";
-        QMessageBox::information(this, "成功", QString("通知滚动状态已%1！").arg(status));
-        refreshNoticeList();
+    int updated = DatabaseManager::instance().setNoticesScrolling(noticeIds, enable);
+    if (updated >= 0) {
+        m_noticeModel->refreshNotices(noticeIds);
+        QString status = enable ? "开启" : "关闭";
+        QMessageBox::information(this, "成功", QString("已%1 %2 条通知的滚动显示！").arg(status).arg(updated));
     } else {
         QMessageBox::critical(this, "失败", "通知状态更新失败！");
     }
 }
 
-// 导出通知
-void NoticeManager::handleExportNotice()
+// 设为无效（支持多选，一个事务）
+void NoticeManager::handleInvalidateNotice()
 {
-    QList<QVariantMap> notices = DatabaseManager::instance().getValidNotices(false);
-    bool success = ExportHelper::exportNoticesToExcel(notices, "所有通知");
+    QList<QVariantMap> notices = selectedNotices();
+    if (notices.isEmpty()) {
+        QMessageBox::warning(this, "警告", "请先选中至少一条通知！");
+        return;
+    }
+
+    QList<int> noticeIds;
+    for (const QVariantMap& notice : notices) {
+        noticeIds.append(notice["id"].toInt());
+    }
 
-    if (success) {
-        QMessageBox::information(this, "成功", "通知导出成功！");
+    int updated = DatabaseManager::instance().invalidateNotices(noticeIds);
+    if (updated >= 0) {
+        m_noticeModel->refreshNotices(noticeIds);
+        QMessageBox::information(this, "成功", QString("已将 %1 条通知设为无效！").arg(updated));
     } else {
-        QMessageBox::critical(this, "失败", "通知导出失败！\n请确认已安装Excel！");
+        QMessageBox::critical(this, "失败", "通知状态更新失败！");
     }
 }
 
+// 导出通知
+void NoticeManager::handleExportNotice()
+{
+    // 查询在后台执行，结果送达前禁用按钮防止重复导出
+    ui->exportNoticeBtn->setEnabled(false);
+    AsyncDatabase::instance().getValidNotices(false).then(this, [this](const QList<QVariantMap>& notices) {
+        ui->exportNoticeBtn->setEnabled(true);
+        bool success = ExportHelper::exportNoticesToExcel(notices, "所有通知");
+
+        if (success) {
+            QMessageBox::information(this, "成功", "通知导出成功！");
+        } else {
+            QMessageBox::critical(this, "失败", "通知导出失败！\n请确认已安装Excel！");
+        }
+    });
+}
+
 // 显示添加通知对话框
 void NoticeManager::showAddNoticeDialog()
 {
@@ -167,10 +269,10 @@ void NoticeManager::showAddNoticeDialog()
     contentEdit->setPlaceholderText("请输入通知内容");
     contentEdit->setMinimumHeight(150);
 
-    QDateTimeEdit* publishTimeEdit = new QDateTimeEdit(QDateTime::currentDateTime(), &dialog);
+    QDateTimeEdit* publishTimeEdit = new QDateTimeEdit(Clock::currentDateTime(), &dialog);
     publishTimeEdit->setDisplayFormat("yyyy-MM-dd HH:mm:ss");
 
-    QDateEdit* expireTimeEdit = new QDateEdit(QDate::currentDate().addDays(7), &dialog);
+    QDateEdit* expireTimeEdit = new QDateEdit(Clock::currentDate().addDays(7), &dialog);
     expireTimeEdit->setDisplayFormat("yyyy-MM-dd");
     expireTimeEdit->setCalendarPopup(true);
 
@@ -206,11 +308,13 @@ void NoticeManager::showAddNoticeDialog()
             return;
         }
 
-        bool success = DatabaseManager::instance().addNotice(title, content, publishTime, expireTime, isScrolling);
+        int noticeId = 0;
+        bool success = DatabaseManager::instance().addNotice(title, content, publishTime, expireTime,
+                                                             isScrolling, &noticeId);
         if (success) {
+            m_noticeModel->refreshNotice(noticeId);
             QMessageBox::information(&dialog, "成功", "通知添加成功！");
             dialog.accept();
-            refreshNoticeList();
         } else {
             QMessageBox::critical(&dialog, "失败", "通知添加失败！");
         }
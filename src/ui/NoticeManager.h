@@ -2,12 +2,14 @@
 #define NOTICEMANAGER_H
 
 #include <QDialog>
-#include <QSqlTableModel>
 #include <QCloseEvent>
+#include <QVariantMap>
 
 // 前置声明
 class DatabaseManager;
 class ExportHelper;
+class NoticeListModel;
+class QTimer;
 
 namespace Ui {
 class NoticeManager;
@@ -29,17 +31,22 @@ private slots:
     void handleAddNotice();
     void handleDeleteNotice();
     void handleToggleScroll();
+    void handleInvalidateNotice();
     void handleExportNotice();
+    void applyFilter();
+    void applySearch();
 
 private:
     Ui::NoticeManager *ui;
-    QSqlTableModel *m_noticeModel;
+    NoticeListModel *m_noticeModel;
+    QTimer *m_searchDebounce;      // 输入停顿后再检索，避免每敲一个字查询一次
 
     // 辅助函数
     void initUI();
     void initModel();
     void initConnections();
     void showAddNoticeDialog();
+    QList<QVariantMap> selectedNotices() const;
 };
 
 #endif // NOTICEMANAGER_H
@@ -1,11 +1,13 @@
 #include "SettingsDialog.h"
 #include "ui_SettingsDialog.h"
 #include "settings/SettingsManager.h"
+#include "data/DatabaseManager.h"
 
 #include <QMessageBox>
 #include <QFileDialog>
 #include <QStandardPaths>
 #include <QUrl>
+#include <QDateTime>
 
 SettingsDialog::SettingsDialog(QWidget *parent)
     : QDialog(parent)
@@ -37,6 +39,36 @@ void SettingsDialog::initConnections()
     connect(ui->saveBtn, &QPushButton::clicked, this, &SettingsDialog::handleSaveSettings);
     connect(ui->selectDbBtn, &QPushButton::clicked, this, &SettingsDialog::handleSelectDbPath);
     connect(ui->resetBtn, &QPushButton::clicked, this, &SettingsDialog::handleResetToDefault);
+    connect(ui->backupDbBtn, &QPushButton::clicked, this, &SettingsDialog::handleBackupDatabase);
+
+    // 备份在后台完成，对话框仍打开时提示结果
+    connect(&DatabaseManager::instance(), &DatabaseManager::backupFinished, this,
+            [this](bool success, const QString& filePath, const QString& message) {
+        ui->backupDbBtn->setEnabled(true);
+        if (success) {
+            QMessageBox::information(this, "成功", QString("数据库已备份到：\n%1\n%2").arg(filePath, message));
+        } else {
+            QMessageBox::critical(this, "失败", "数据库备份失败：\n" + message);
+        }
+    });
+    ui->backupDbBtn->setEnabled(!DatabaseManager::instance().isBackupRunning());
+}
+
+// 在线备份数据库（后台线程中分步复制，不阻塞界面与同步）
+void SettingsDialog::handleBackupDatabase()
+{
+    QString defaultPath = QStandardPaths::writableLocation(QStandardPaths::DocumentsLocation)
+                          + QString("/classboard_snapshot_%1.db").arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmm"));
+    QString filePath = QFileDialog::getSaveFileName(this, "备份数据库", defaultPath, "SQLite数据库 (*.db)");
+    if (filePath.isEmpty()) {
+        return;
+    }
+
+    if (DatabaseManager::instance().backupAsync(filePath)) {
+        ui->backupDbBtn->setEnabled(false);
+    } else {
+        QMessageBox::warning(this, "警告", "无法开始备份（可能已有备份正在进行）！");
+    }
 }
 
 // 保存设置
@@ -23,6 +23,7 @@ private slots:
     void handleSaveSettings();
     void handleSelectDbPath();
     void handleResetToDefault();
+    void handleBackupDatabase();
 
 private:
     Ui::SettingsDialog *ui;
@@ -0,0 +1,89 @@
+#include "UrgentOverlay.h"
+#include "utility/Clock.h"
+#include <QVBoxLayout>
+#include <QEvent>
+
+UrgentOverlay::UrgentOverlay(QWidget *parent) : QWidget(parent)
+{
+    this->setAttribute(Qt::WA_StyledBackground, true);
+    this->setObjectName("urgentOverlay");
+    this->setStyleSheet("#urgentOverlay { background-color: rgba(176, 0, 0, 235); }"
+                        "QLabel { color: white; }"
+                        "QPushButton { font-size: 20px; padding: 10px 40px; }");
+
+    m_titleLabel = new QLabel(this);
+    m_titleLabel->setAlignment(Qt::AlignCenter);
+    m_titleLabel->setWordWrap(true);
+    m_titleLabel->setStyleSheet("font-size: 48px; font-weight: bold;");
+
+    m_contentLabel = new QLabel(this);
+    m_contentLabel->setAlignment(Qt::AlignCenter);
+    m_contentLabel->setWordWrap(true);
+    m_contentLabel->setStyleSheet("font-size: 28px;");
+
+    m_pendingLabel = new QLabel(this);
+    m_pendingLabel->setAlignment(Qt::AlignCenter);
+    m_pendingLabel->setStyleSheet("font-size: 16px;");
+
+    m_dismissBtn = new QPushButton("知道了", this);
+    connect(m_dismissBtn, &QPushButton::clicked, this, &UrgentOverlay::onDismissClicked);
+
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(80, 60, 80, 60);
+    layout->addStretch();
+    layout->addWidget(m_titleLabel);
+    layout->addSpacing(30);
+    layout->addWidget(m_contentLabel);
+    layout->addStretch();
+    layout->addWidget(m_pendingLabel);
+    layout->addWidget(m_dismissBtn, 0, Qt::AlignHCenter);
+
+    // 跟随父窗口大小
+    parent->installEventFilter(this);
+    this->setGeometry(parent->rect());
+    this->hide();
+}
+
+void UrgentOverlay::showNotice(const QString& title, const QString& content)
+{
+    m_queue.append(qMakePair(QString("【紧急】%1").arg(title), content));
+    showCurrent();
+}
+
+void UrgentOverlay::onDismissClicked()
+{
+    if (!m_queue.isEmpty()) {
+        m_queue.removeFirst();
+    }
+    if (m_queue.isEmpty()) {
+        this->hide();
+        return;
+    }
+    showCurrent();
+}
+
+void UrgentOverlay::showCurrent()
+{
+    if (m_queue.isEmpty()) {
+        return;
+    }
+
+    m_titleLabel->setText(m_queue.first().first);
+    m_contentLabel->setText(m_queue.first().second);
+    m_pendingLabel->setText(m_queue.size() > 1
+                            ? QString("还有%1条紧急通知").arg(m_queue.size() - 1)
+                            : Clock::currentDateTime().toString("yyyy-MM-dd HH:mm:ss"));
+
+    this->setGeometry(parentWidget()->rect());
+    this->show();
+    this->raise();
+    m_dismissBtn->setFocus();
+}
+
+bool UrgentOverlay::eventFilter(QObject* watched, QEvent* event)
+{
+    if (watched == parentWidget() && event->type() == QEvent::Resize) {
+        this->setGeometry(parentWidget()->rect());
+    }
+    return QWidget::eventFilter(watched, event);
+}
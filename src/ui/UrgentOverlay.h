@@ -0,0 +1,37 @@
+#ifndef URGENTOVERLAY_H
+#define URGENTOVERLAY_H
+
+#include <QWidget>
+#include <QLabel>
+#include <QPushButton>
+#include <QList>
+#include <QPair>
+
+// 紧急通知全屏覆盖层：盖住主窗口全部内容并随窗口缩放，
+// 点击“知道了”关闭；显示期间收到的通知排队依次显示
+class UrgentOverlay : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit UrgentOverlay(QWidget *parent);
+
+    void showNotice(const QString& title, const QString& content);
+
+protected:
+    bool eventFilter(QObject* watched, QEvent* event) override;
+
+private slots:
+    void onDismissClicked();
+
+private:
+    void showCurrent();
+
+    QLabel* m_titleLabel = nullptr;
+    QLabel* m_contentLabel = nullptr;
+    QLabel* m_pendingLabel = nullptr;
+    QPushButton* m_dismissBtn = nullptr;
+    QList<QPair<QString, QString>> m_queue;  // 待显示的（标题，内容），队首为当前显示
+};
+
+#endif // URGENTOVERLAY_H
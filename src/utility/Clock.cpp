@@ -0,0 +1,65 @@
+#include "Clock.h"
+#include <QMutexLocker>
+
+Clock& Clock::instance()
+{
+    static Clock instance;
+    return instance;
+}
+
+QDateTime Clock::now() const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_simulated) {
+        return QDateTime::currentDateTime();
+    }
+    qint64 simMs = static_cast<qint64>(m_realElapsed.elapsed() * m_speed);
+    return m_simBase.addMSecs(simMs);
+}
+
+void Clock::startSimulation(const QDateTime& start, double speed)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_simulated = true;
+        m_speed = qMax(0.0, speed);
+        m_simBase = start;
+        m_realElapsed.start();
+    }
+    emit timeJumped(start);
+}
+
+void Clock::jumpTo(const QDateTime& target)
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_simulated) {
+            return;
+        }
+        m_simBase = target;
+        m_realElapsed.start();
+    }
+    emit timeJumped(target);
+}
+
+void Clock::resetToSystem()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_simulated = false;
+        m_speed = 1.0;
+    }
+    emit timeJumped(QDateTime::currentDateTime());
+}
+
+bool Clock::isSimulated() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_simulated;
+}
+
+double Clock::speed() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_speed;
+}
@@ -0,0 +1,54 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <QObject>
+#include <QMutex>
+#include <QDate>
+#include <QTime>
+#include <QDateTime>
+#include <QElapsedTimer>
+
+// 时钟（单例，线程安全）
+// 所有与课表/通知相关的“当前时间”都从这里取，默认等同系统时间；
+// 模拟模式下可从指定起点按倍速运行，或直接跳转到指定时刻，用于复现整周/整学期的课表切换
+class Clock : public QObject
+{
+    Q_OBJECT
+public:
+    static Clock& instance();
+    ~Clock() = default;
+
+    // 当前时间（模拟模式下为模拟时间）
+    static QDateTime currentDateTime() { return instance().now(); }
+    static QDate currentDate() { return instance().now().date(); }
+    static QTime currentTime() { return instance().now().time(); }
+
+    QDateTime now() const;
+
+    // 进入模拟模式：从 start 开始，按 speed 倍速流逝（speed=0 时时间静止，只随 jumpTo 变化）
+    void startSimulation(const QDateTime& start, double speed = 1.0);
+    // 跳转到指定时刻（仅模拟模式有效，保持当前倍速）
+    void jumpTo(const QDateTime& target);
+    // 恢复系统时间
+    void resetToSystem();
+
+    bool isSimulated() const;
+    double speed() const;
+
+signals:
+    // 模拟时间发生跳变（进入模拟、跳转、恢复系统时间）
+    void timeJumped(const QDateTime& now);
+
+private:
+    Clock(QObject* parent = nullptr) : QObject(parent) {}
+    Clock(const Clock&) = delete;
+    Clock& operator=(const Clock&) = delete;
+
+    mutable QMutex m_mutex;
+    bool m_simulated = false;
+    double m_speed = 1.0;
+    QDateTime m_simBase;        // 模拟起点
+    QElapsedTimer m_realElapsed; // 自模拟起点以来的真实流逝时间
+};
+
+#endif // CLOCK_H
@@ -1,4 +1,11 @@
 #include "ExportHelper.h"
+#include "utility/LogHelper.h"
+
+// Excel导出依赖ActiveQt（仅Windows提供axcontainer模块）
+#ifdef QT_AXCONTAINER_LIB
+#include <QAxObject>
+#include <QFileDialog>
+#include <QStandardPaths>
 
 QAxObject* ExportHelper::initExcel(QAxObject*& worksheet, QAxObject*& workbook)
 {
@@ -270,3 +277,30 @@ bool ExportHelper::exportNoticesToExcel(const QList<QVariantMap>& notices, const
     }
 }
 
+#else // QT_AXCONTAINER_LIB
+
+QAxObject* ExportHelper::initExcel(QAxObject*& worksheet, QAxObject*& workbook)
+{
+    worksheet = nullptr;
+    workbook = nullptr;
+    return nullptr;
+}
+
+bool ExportHelper::writeToWorksheet(QAxObject*, const QList<QVariantMap>&, const QStringList&)
+{
+    return false;
+}
+
+bool ExportHelper::exportCoursesToExcel(const QList<QVariantMap>&, const QString&)
+{
+    writeLog("WARNING", "当前平台不支持Excel导出（缺少axcontainer模块）", "EXPORT");
+    return false;
+}
+
+bool ExportHelper::exportNoticesToExcel(const QList<QVariantMap>&, const QString&)
+{
+    writeLog("WARNING", "当前平台不支持Excel导出（缺少axcontainer模块）", "EXPORT");
+    return false;
+}
+
+#endif // QT_AXCONTAINER_LIB
@@ -4,11 +4,10 @@
 #include <QObject>
 #include <QList>
 #include <QVariantMap>
-#include <QAxObject>
-#include <QFileDialog>
-#include <QStandardPaths>
-#include <QDateTime>
-#include <QThread>
+#include <QStringList>
+
+// 仅在实现文件中引入ActiveQt，避免QAxObject扩散到包含本头文件的模块
+class QAxObject;
 
 class ExportHelper : public QObject
 {
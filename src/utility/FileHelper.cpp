@@ -0,0 +1,20 @@
+#include "FileHelper.h"
+#include <QDir>
+#include <QFile>
+
+#if defined(Q_OS_WIN)
+#include <windows.h>
+#else
+#include <cstdio>
+#endif
+
+bool FileHelper::replaceFileAtomically(const QString& from, const QString& to)
+{
+#if defined(Q_OS_WIN)
+    return MoveFileExW(reinterpret_cast<const wchar_t*>(QDir::toNativeSeparators(from).utf16()),
+                       reinterpret_cast<const wchar_t*>(QDir::toNativeSeparators(to).utf16()),
+                       MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(QFile::encodeName(from).constData(), QFile::encodeName(to).constData()) == 0;
+#endif
+}
@@ -0,0 +1,14 @@
+#ifndef FILEHELPER_H
+#define FILEHELPER_H
+
+#include <QString>
+
+class FileHelper
+{
+public:
+    // 同一文件系统内原子替换文件：to 处始终是完整的旧文件或新文件
+    // （QFile::rename 不覆盖已有文件，先删后改名会留下目标缺失的窗口，期间崩溃即丢失旧文件）
+    static bool replaceFileAtomically(const QString& from, const QString& to);
+};
+
+#endif // FILEHELPER_H
@@ -7,6 +7,19 @@
 #include <QFile>
 #include <QTextStream>
 #include <QDateTime>
+#include <atomic>
+
+// 日志写入钩子（每写一条调用一次，参数为级别）；由指标模块安装，未安装时不做任何统计
+using LogWriteHook = void (*)(const QString& level);
+
+inline std::atomic<LogWriteHook>& logWriteHook() {
+    static std::atomic<LogWriteHook> hook{nullptr};
+    return hook;
+}
+
+inline void setLogWriteHook(LogWriteHook hook) {
+    logWriteHook().store(hook);
+}
 
 // 全局内联日志函数（避免重复定义，支持模块区分）
 inline void writeLog(const QString& level, const QString& msg, const QString& module = "COMMON") {
@@ -20,6 +33,10 @@ inline void writeLog(const QString& level, const QString& msg, const QString& mo
                << " [" << module << "] [" << level << "] " << msg << "\n";
         logFile.close();
     }
+
+    if (LogWriteHook hook = logWriteHook().load(std::memory_order_relaxed)) {
+        hook(level);
+    }
 }
 
 #endif // LOGHELPER_H
@@ -0,0 +1,64 @@
+#include "ScheduleSimulator.h"
+#include "Clock.h"
+#include "data/DatabaseManager.h"
+
+ScheduleSimulator::ScheduleSimulator(QObject *parent)
+    : QObject(parent)
+    , m_timer(new QTimer(this))
+{
+    connect(m_timer, &QTimer::timeout, this, &ScheduleSimulator::onTick);
+}
+
+QDateTime ScheduleSimulator::nextTransition(const QDateTime& from, int maxDays)
+{
+    for (int offset = 0; offset <= maxDays; offset++) {
+        QDate date = from.date().addDays(offset);
+        QList<QTime> times = DatabaseManager::instance().getTransitionTimes(date);
+        for (const QTime& time : times) {
+            QDateTime candidate(date, time);
+            if (candidate > from) {
+                return candidate;
+            }
+        }
+    }
+    return QDateTime();
+}
+
+QDateTime ScheduleSimulator::step()
+{
+    if (!Clock::instance().isSimulated()) {
+        writeLog("WARNING", "未处于模拟时间模式，忽略课表跳转", "CLOCK");
+        return QDateTime();
+    }
+
+    QDateTime next = nextTransition(Clock::currentDateTime());
+    if (!next.isValid()) {
+        return next;
+    }
+
+    Clock::instance().jumpTo(next);
+    emit transitionReached(next);
+    return next;
+}
+
+void ScheduleSimulator::start(int intervalMs, const QDateTime& until)
+{
+    m_until = until;
+    m_timer->start(qMax(1, intervalMs));
+    writeLog("INFO", QString("课表跳转模拟已启动，间隔%1毫秒").arg(intervalMs), "CLOCK");
+}
+
+void ScheduleSimulator::stop()
+{
+    m_timer->stop();
+}
+
+void ScheduleSimulator::onTick()
+{
+    QDateTime next = step();
+    if (!next.isValid() || (m_until.isValid() && next >= m_until)) {
+        m_timer->stop();
+        writeLog("INFO", "课表跳转模拟结束", "CLOCK");
+        emit finished();
+    }
+}
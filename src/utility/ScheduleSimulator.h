@@ -0,0 +1,38 @@
+#ifndef SCHEDULESIMULATOR_H
+#define SCHEDULESIMULATOR_H
+
+#include <QObject>
+#include <QTimer>
+#include <QDateTime>
+
+// 课表切换模拟器：在 Clock 模拟模式下，依次跳转到下一个课表切换时刻（上课/下课）
+// 用于不等待真实时间即可走完一整周/一整学期的课表变化
+class ScheduleSimulator : public QObject
+{
+    Q_OBJECT
+public:
+    explicit ScheduleSimulator(QObject *parent = nullptr);
+
+    // from 之后的下一个切换时刻（maxDays 天内没有课程时返回无效时间）
+    static QDateTime nextTransition(const QDateTime& from, int maxDays = 14);
+
+    // 单步：把 Clock 跳到下一个切换时刻，返回跳转后的时间（无后续切换时返回无效时间）
+    QDateTime step();
+
+    // 自动跳转：每 intervalMs 真实毫秒跳一次，到达 until（可为空）后停止
+    void start(int intervalMs, const QDateTime& until = QDateTime());
+    void stop();
+
+signals:
+    void transitionReached(const QDateTime& at);
+    void finished();
+
+private slots:
+    void onTick();
+
+private:
+    QTimer* m_timer;
+    QDateTime m_until;
+};
+
+#endif // SCHEDULESIMULATOR_H
@@ -1,17 +1,41 @@
 #include "TimeHelper.h"
+#include "Clock.h"
+
+static_assert("08:00"_hm.secs == 8 * 3600, "DayTime literal");
+static_assert(!"24:00"_hm.isValid() && !"8:60"_hm.isValid(), "DayTime literal range");
+
+// 运行时解析 HH:mm（不经过 QTime::fromString，不分配内存）
+DayTime DayTime::parse(QStringView str)
+{
+    char buf[5];
+    const qsizetype len = str.size();
+    if (len != 4 && len != 5) {
+        return DayTime();
+    }
+    for (qsizetype i = 0; i < len; i++) {
+        char16_t ch = str[i].unicode();
+        if (ch > 0x7f) return DayTime();
+        buf[i] = static_cast<char>(ch);
+    }
+    return parse(buf, static_cast<size_t>(len));
+}
+
+DayTime TimeHelper::now()
+{
+    return DayTime::fromQTime(Clock::currentTime());
+}
 
 // 计算倒计时（目标时间为当天的HH:mm）
 QString TimeHelper::getCountdown(const QString& targetTimeStr)
 {
-    QTime now = QTime::currentTime();
-    QTime target = parseTime(targetTimeStr);
+    DayTime target = DayTime::parse(targetTimeStr);
 
     if (!target.isValid()) {
         return "00:00:00";
     }
 
     // 计算秒数差
-    int diffSec = now.secsTo(target);
+    int diffSec = now().secsTo(target);
     if (diffSec <= 0) {
         return "00:00:00"; // 已结束
     }
@@ -22,32 +46,59 @@ QString TimeHelper::getCountdown(const QString& targetTimeStr)
 // 判断当前时间是否在时间段内
 bool TimeHelper::isTimeInRange(const QString& startTimeStr, const QString& endTimeStr)
 {
-    QTime now = QTime::currentTime();
-    QTime start = parseTime(startTimeStr);
-    QTime end = parseTime(endTimeStr);
+    DayTime start = DayTime::parse(startTimeStr);
+    DayTime end = DayTime::parse(endTimeStr);
 
     if (!start.isValid() || !end.isValid()) {
         return false;
     }
 
-    return now >= start && now <= end;
+    return isTimeInRange(start, end, now());
 }
 
 // 格式化秒数为XX:XX:XX
 QString TimeHelper::formatTimeDiff(int seconds)
 {
-    int hours = seconds / 3600;
-    int minutes = (seconds % 3600) / 60;
-    int secs = seconds % 60;
-
-    return QString("%1:%2:%3")
-           .arg(hours, 2, 10, QChar('0'))
-           .arg(minutes, 2, 10, QChar('0'))
-           .arg(secs, 2, 10, QChar('0'));
+    QChar buf[8];
+    formatCountdown(seconds, buf);
+    return QString(buf, 8);
+}
+
+void TimeHelper::formatCountdown(int seconds, QChar* out)
+{
+    seconds = qBound(0, seconds, 99 * 3600 + 59 * 60 + 59);
+    const int hours = seconds / 3600;
+    const int minutes = (seconds % 3600) / 60;
+    const int secs = seconds % 60;
+
+    out[0] = QChar(u'0' + hours / 10);
+    out[1] = QChar(u'0' + hours % 10);
+    out[2] = QChar(u':');
+    out[3] = QChar(u'0' + minutes / 10);
+    out[4] = QChar(u'0' + minutes % 10);
+    out[5] = QChar(u':');
+    out[6] = QChar(u'0' + secs / 10);
+    out[7] = QChar(u'0' + secs % 10);
 }
 
-// 解析HH:mm格式时间
-QTime TimeHelper::parseTime(const QString& timeStr)
+qint64 TimeHelper::julianDayFromIso(QStringView str)
 {
-    return QTime::fromString(timeStr, "HH:mm");
-}
\ No newline at end of file
+    if (str.size() != 10 || str[4] != u'-' || str[7] != u'-') {
+        return -1;
+    }
+    auto number = [&str](int from, int count) {
+        int value = 0;
+        for (int i = from; i < from + count; i++) {
+            char16_t ch = str[i].unicode();
+            if (ch < u'0' || ch > u'9') return -1;
+            value = value * 10 + (ch - u'0');
+        }
+        return value;
+    };
+    const int year = number(0, 4), month = number(5, 2), day = number(8, 2);
+    if (year < 0 || month < 0 || day < 0) {
+        return -1;
+    }
+    QDate date(year, month, day);
+    return date.isValid() ? date.toJulianDay() : -1;
+}
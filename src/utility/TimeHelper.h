@@ -4,8 +4,60 @@
 #include <QObject>
 #include <QTime>
 #include <QString>
+#include <QStringView>
 #include <QDateTime>
 
+// 一天内的时刻（自零点起的秒数），课表时间统一用它做比较与相减，避免反复解析 HH:mm 字符串
+struct DayTime
+{
+    int secs = -1;  // -1 表示无效
+
+    constexpr DayTime() = default;
+    constexpr explicit DayTime(int seconds) : secs(seconds) {}
+    constexpr DayTime(int hour, int minute, int second = 0) : secs(hour * 3600 + minute * 60 + second) {}
+
+    constexpr bool isValid() const { return secs >= 0; }
+    constexpr int hour() const { return secs / 3600; }
+    constexpr int minute() const { return secs % 3600 / 60; }
+    // 到 other 的秒数（other 更晚时为正）
+    constexpr int secsTo(DayTime other) const { return other.secs - secs; }
+
+    friend constexpr bool operator==(DayTime a, DayTime b) { return a.secs == b.secs; }
+    friend constexpr bool operator!=(DayTime a, DayTime b) { return a.secs != b.secs; }
+    friend constexpr bool operator<(DayTime a, DayTime b) { return a.secs < b.secs; }
+    friend constexpr bool operator<=(DayTime a, DayTime b) { return a.secs <= b.secs; }
+    friend constexpr bool operator>(DayTime a, DayTime b) { return a.secs > b.secs; }
+    friend constexpr bool operator>=(DayTime a, DayTime b) { return a.secs >= b.secs; }
+
+    // 解析 HH:mm / H:mm（字面量可在编译期求值，格式错误返回无效时刻）
+    static constexpr DayTime parse(const char* str, size_t len)
+    {
+        size_t colon = (len == 5) ? 2 : (len == 4 ? 1 : 0);
+        if (colon == 0 || str[colon] != ':') return DayTime();
+        int hour = 0;
+        for (size_t i = 0; i < colon; i++) {
+            if (str[i] < '0' || str[i] > '9') return DayTime();
+            hour = hour * 10 + (str[i] - '0');
+        }
+        if (str[colon + 1] < '0' || str[colon + 1] > '5' || str[colon + 2] < '0' || str[colon + 2] > '9') {
+            return DayTime();
+        }
+        int minute = (str[colon + 1] - '0') * 10 + (str[colon + 2] - '0');
+        return hour < 24 ? DayTime(hour, minute) : DayTime();
+    }
+    static DayTime parse(QStringView str);
+    static DayTime fromQTime(const QTime& time)
+    {
+        return time.isValid() ? DayTime(time.msecsSinceStartOfDay() / 1000) : DayTime();
+    }
+};
+
+// 课表时间字面量，例如 "08:00"_hm
+constexpr DayTime operator""_hm(const char* str, size_t len)
+{
+    return DayTime::parse(str, len);
+}
+
 // 时间工具类（Qt 6.9.2适配）
 class TimeHelper : public QObject
 {
@@ -13,18 +65,26 @@ class TimeHelper : public QObject
 public:
     explicit TimeHelper(QObject *parent = nullptr) : QObject(parent) {}
 
+    // 当前时刻（取自 Clock，支持模拟时间）
+    static DayTime now();
+
     // 计算倒计时（目标时间：HH:mm格式，返回XX:XX:XX）
     static QString getCountdown(const QString& targetTimeStr);
 
     // 判断当前时间是否在[startTime, endTime]范围内
     static bool isTimeInRange(const QString& startTimeStr, const QString& endTimeStr);
+    static bool isTimeInRange(DayTime start, DayTime end, DayTime now) { return now >= start && now <= end; }
 
     // 格式化时间差为XX小时XX分XX秒
     static QString formatTimeDiff(int seconds);
 
-private:
-    // 解析时间字符串为QTime（HH:mm）
-    static QTime parseTime(const QString& timeStr);
+    // 倒计时格式化：写入调用方提供的8个字符（HH:mm:ss），不分配内存；负数按0处理，超过99小时封顶
+    static void formatCountdown(int seconds, QChar* out);
+
+    // 解析 yyyy-MM-dd 为儒略日（不经过 QDate::fromString，格式错误返回 -1）
+    static qint64 julianDayFromIso(QStringView str);
+    // 儒略日对应日期所在周的周一（儒略日模7为0对应周一）
+    static constexpr qint64 mondayOfJulianDay(qint64 julianDay) { return julianDay - julianDay % 7; }
 };
 
-#endif // TIMEHELPER_H
\ No newline at end of file
+#endif // TIMEHELPER_H
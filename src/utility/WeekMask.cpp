@@ -0,0 +1,115 @@
+#include "WeekMask.h"
+#include <QStringList>
+#include <QRegularExpression>
+
+static_assert(WeekMask::range(1, 8) == 0xFF, "WeekMask range");
+static_assert(WeekMask::contains(WeekMask::oddWeeks(), 3) && !WeekMask::contains(WeekMask::oddWeeks(), 4), "WeekMask odd");
+
+int WeekMask::weekOf(const QDate& startDate, const QDate& date)
+{
+    if (!startDate.isValid() || !date.isValid() || date < startDate) {
+        return 0;
+    }
+    QDate firstMonday = startDate.addDays(1 - startDate.dayOfWeek());
+    return static_cast<int>(firstMonday.daysTo(date) / 7) + 1;
+}
+
+bool WeekMask::overlaps(qint64 maskA, qint64 firstMondayA, qint64 maskB, qint64 firstMondayB)
+{
+    // 统一到开始较早的课程的周序号：B 的第1周对应 A 的第 offset+1 周
+    if (firstMondayB < firstMondayA) {
+        qSwap(maskA, maskB);
+        qSwap(firstMondayA, firstMondayB);
+    }
+    // A 每周上课时覆盖 B 的任一上课周（包括移位后超出64位的周）
+    if (maskA == kAllWeeks) {
+        return maskB != 0;
+    }
+    const qint64 offset = (firstMondayB - firstMondayA) / 7;
+    if (offset >= kMaxWeeks) {
+        return false; // A 的上课周都在 B 开始之前
+    }
+    const quint64 alignedB = static_cast<quint64>(maskB) << offset;
+    return (static_cast<quint64>(maskA) & alignedB) != 0;
+}
+
+qint64 WeekMask::parse(const QString& spec)
+{
+    QString text = spec.trimmed().toLower();
+    text.remove("周");
+    if (text.isEmpty() || text == "all" || text == "每") {
+        return kAllWeeks;
+    }
+    if (text == "odd" || text == "单") {
+        return oddWeeks();
+    }
+    if (text == "even" || text == "双") {
+        return evenWeeks();
+    }
+    if (text.startsWith("0x")) {
+        // 十六进制位图（JSON数字超过53位会丢精度，完整64周位图用字符串传输）
+        bool ok = false;
+        quint64 raw = text.mid(2).toULongLong(&ok, 16);
+        return ok ? static_cast<qint64>(raw) : 0;
+    }
+
+    qint64 mask = 0;
+    const QStringList parts = text.split(QRegularExpression("[,，]"), Qt::SkipEmptyParts);
+    for (const QString& part : parts) {
+        QStringList bounds = part.split('-');
+        bool okFirst = false, okLast = false;
+        int first = bounds.value(0).trimmed().toInt(&okFirst);
+        int last = bounds.size() > 1 ? bounds.value(1).trimmed().toInt(&okLast) : first;
+        if (bounds.size() == 1) okLast = okFirst;
+        if (!okFirst || !okLast || bounds.size() > 2 || first < 1 || last > kMaxWeeks || first > last) {
+            return 0;
+        }
+        mask |= range(first, last);
+    }
+    return mask;
+}
+
+qint64 WeekMask::fromJson(const QJsonValue& value)
+{
+    if (value.isUndefined() || value.isNull()) {
+        return kAllWeeks;
+    }
+    if (value.isDouble()) {
+        return static_cast<qint64>(value.toDouble());
+    }
+    return parse(value.toString());
+}
+
+QString WeekMask::toString(qint64 mask)
+{
+    if (mask == kAllWeeks) return "每周";
+    if (mask == oddWeeks()) return "单周";
+    if (mask == evenWeeks()) return "双周";
+    if (mask == 0) return "无";
+
+    // 连续区间合并显示
+    QStringList ranges;
+    int week = 1;
+    while (week <= kMaxWeeks) {
+        if (!contains(mask, week)) {
+            week++;
+            continue;
+        }
+        int first = week;
+        while (week + 1 <= kMaxWeeks && contains(mask, week + 1)) {
+            week++;
+        }
+        ranges.append(first == week ? QString::number(first) : QString("%1-%2").arg(first).arg(week));
+        week++;
+    }
+    return ranges.join(",") + "周";
+}
+
+QString WeekMask::sqlContains(const QString& course, const QString& dateExpr)
+{
+    // 周序号（从0开始）= (日期 - 开始日期所在周周一) / 7
+    // 用 1 << 周序号 取位：SQLite 左移64位及以上结果为0，因此第64周以后只有每周上课（-1）的课程匹配，与 contains() 一致
+    // （右移负数位图会补1，不能用 week_mask >> 周序号）；早于开始日期的日期由调用方按 start_date 排除
+    return QString("(%1.week_mask = -1 OR (%1.week_mask & (1 << CAST((julianday(%2) - julianday(%1.start_date, 'weekday 0', '-6 days')) / 7 AS INTEGER))) != 0)")
+           .arg(course, dateExpr);
+}
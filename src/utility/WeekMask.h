@@ -0,0 +1,51 @@
+#ifndef WEEKMASK_H
+#define WEEKMASK_H
+
+#include <QString>
+#include <QDate>
+#include <QJsonValue>
+
+// 教学周位图：第N周（从1开始）对应第N-1位，最多64周；-1（全部位为1）表示每周都上
+// 周次从课程开始日期所在周的周一起算
+class WeekMask
+{
+public:
+    static constexpr qint64 kAllWeeks = -1;
+    static constexpr int kMaxWeeks = 64;
+
+    // 第 first 至 last 周（含）
+    static constexpr qint64 range(int first, int last)
+    {
+        qint64 mask = 0;
+        for (int week = qMax(1, first); week <= qMin(kMaxWeeks, last); week++) {
+            mask |= qint64(1) << (week - 1);
+        }
+        return mask;
+    }
+    static constexpr qint64 oddWeeks() { return qint64(0x5555555555555555LL); }
+    static constexpr qint64 evenWeeks() { return qint64(0xAAAAAAAAAAAAAAAAULL); }
+
+    static constexpr bool contains(qint64 mask, int week)
+    {
+        return week >= 1 && week <= kMaxWeeks ? ((mask >> (week - 1)) & 1) != 0 : mask == kAllWeeks;
+    }
+
+    // 两门课程的上课周是否有交集（firstMonday 为各自开始日期所在周周一的儒略日）
+    static bool overlaps(qint64 maskA, qint64 firstMondayA, qint64 maskB, qint64 firstMondayB);
+
+    // 课程开始日期为 startDate 时，date 所在的教学周（从1开始，早于开始周返回0）
+    static int weekOf(const QDate& startDate, const QDate& date);
+
+    // 解析周次描述：“1-8”“1,3,5-7”“odd/单”“even/双”“all/空”“0x位图”；格式错误返回0
+    static qint64 parse(const QString& spec);
+    // 同步字段：数字为位图，字符串按 parse 解析，缺省为每周
+    static qint64 fromJson(const QJsonValue& value);
+
+    // 显示文本，例如“1-8周”“单周”“每周”
+    static QString toString(qint64 mask);
+
+    // SQL表达式：date 所在教学周是否包含在 course 的 week_mask 中（course 为表别名或表名）
+    static QString sqlContains(const QString& course, const QString& dateExpr);
+};
+
+#endif // WEEKMASK_H
@@ -0,0 +1,18 @@
+# DatabaseManager 热点路径基准测试（QtTest QBENCHMARK）
+QT       += core sql network testlib
+QT       -= gui
+
+CONFIG   += console testcase
+CONFIG   -= app_bundle
+
+TARGET = bench_database
+TEMPLATE = app
+
+include(../../src/core/classboard_core.pri)
+
+# 源文件
+SOURCES += \
+    tst_bench_database.cpp
+
+# 基准测试始终使用优化编译
+QMAKE_CXXFLAGS_RELEASE += -O2
@@ -0,0 +1,1019 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QDate>
+#include <QTime>
+#include <QDateTime>
+#include <QStandardPaths>
+#include <QFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QSysInfo>
+#include <QSignalSpy>
+#include <QElapsedTimer>
+#include <QAtomicInt>
+#include <QtConcurrent/QtConcurrentRun>
+#include "data/DatabaseManager.h"
+#include "data/AsyncDatabase.h"
+#include "data/DatabaseBackup.h"
+#include "data/SqlitePragmas.h"
+#include "data/ConflictAnalyzer.h"
+#include "data/NoticeRotation.h"
+#include "data/NoticeScheduler.h"
+#include "metrics/MetricsRegistry.h"
+#include "network/NetworkWorker.h"
+#include "utility/Clock.h"
+#include "utility/ScheduleSimulator.h"
+#include "utility/WeekMask.h"
+
+// DatabaseManager 热点路径基准测试
+// 运行：./bench_database [QtTest参数]
+// 未指定 -o 时默认输出 bench_database.csv 与 bench_database.json（目录可用 BENCH_OUTPUT_DIR 指定）
+class BenchDatabase : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void getCurrentCourse_data();
+    void getCurrentCourse();
+    void getNextCourse_data();
+    void getNextCourse();
+    void getCoursesByClassId_data();
+    void getCoursesByClassId();
+    void asyncCoursesByClassId_data();
+    void asyncCoursesByClassId();
+    void getCoursesByTeacher_data();
+    void getCoursesByTeacher();
+    void getValidNotices_data();
+    void getValidNotices();
+    void noticePage_data();
+    void noticePage();
+    void bulkNoticeScrolling_data();
+    void bulkNoticeScrolling();
+    void searchNotices_data();
+    void searchNotices();
+    void noticeRotation_data();
+    void noticeRotation();
+    void noticeScheduler_data();
+    void noticeScheduler();
+    void searchClasses_data();
+    void searchClasses();
+    void getFreeClassrooms_data();
+    void getFreeClassrooms();
+    void syncApply_data();
+    void syncApply();
+    void semesterSimulation();
+    void pragmaSyncApply_data();
+    void pragmaSyncApply();
+    void pragmaReadLatency_data();
+    void pragmaReadLatency();
+    void onlineBackup_data();
+    void onlineBackup();
+    void snapshotProvision_data();
+    void snapshotProvision();
+    void retentionArchive_data();
+    void retentionArchive();
+    void conflictAnalysis_data();
+    void conflictAnalysis();
+    void dictionaryFootprint_data();
+    void dictionaryFootprint();
+
+private:
+    // 数据集规模（课程行数）
+    static void addDatasetSizes();
+    static void addSyncSizes();
+    static void addPragmaPresets();
+    // 按规模生成数据集（规模不变时复用）
+    void seedDataset(int courseRows);
+    QByteArray buildSyncPayload(int courseRows);
+
+    QTemporaryDir m_tempDir;
+    NetworkWorker* m_worker = nullptr;
+    int m_seededRows = -1;
+    int m_classCount = 0;
+};
+
+static const int kCoursesPerClass = 50;
+static const int kTeacherCount = 800;
+static const int kCourseNameCount = 300;
+
+// 附加指标（计时之外的计数、占用、最大单次耗时等），由 main 写入JSON报告的 extra 数组
+static QJsonArray& extraResults()
+{
+    static QJsonArray results;
+    return results;
+}
+
+static void recordExtra(const QString& metric, double value)
+{
+    QJsonObject result;
+    result["function"] = QString::fromUtf8(QTest::currentTestFunction());
+    result["tag"] = QString::fromUtf8(QTest::currentDataTag());
+    result["metric"] = metric;
+    result["value"] = value;
+    extraResults().append(result);
+}
+
+void BenchDatabase::initTestCase()
+{
+    // 日志与配置文件写入测试目录，不污染真实AppData
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(m_tempDir.isValid());
+
+    QString dbPath = m_tempDir.filePath("bench_classboard.db");
+    QVERIFY(DatabaseManager::instance().init(dbPath));
+
+    m_worker = new NetworkWorker();
+}
+
+void BenchDatabase::cleanupTestCase()
+{
+    delete m_worker;
+    m_worker = nullptr;
+}
+
+void BenchDatabase::addDatasetSizes()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("rows=1000") << 1000;
+    QTest::newRow("rows=10000") << 10000;
+    QTest::newRow("rows=100000") << 100000;
+}
+
+void BenchDatabase::addSyncSizes()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("rows=100") << 100;
+    QTest::newRow("rows=1000") << 1000;
+    QTest::newRow("rows=5000") << 5000;
+}
+
+void BenchDatabase::addPragmaPresets()
+{
+    QTest::addColumn<QString>("preset");
+    for (const QString& preset : SqlitePragmaProfile::presetNames()) {
+        QTest::newRow(qPrintable("preset=" + preset)) << preset;
+    }
+}
+
+// 生成数据集：每班50节课，均匀分布在周一至周日的8个时段
+void BenchDatabase::seedDataset(int courseRows)
+{
+    if (m_seededRows == courseRows) {
+        return;
+    }
+
+    QSqlDatabase db = DatabaseManager::instance().getDb();
+    QSqlQuery query(db);
+    QVERIFY(db.transaction());
+
+    const QStringList tables = {"course_schedule", "notices", "classroom_info", "class_info", "teacher_info",
+                                "course_name_info", "course_type_info", "calendar_exceptions"};
+    for (const QString& table : tables) {
+        QVERIFY2(query.exec("DELETE FROM " + table), qPrintable(query.lastError().text()));
+    }
+
+    m_classCount = qMax(1, courseRows / kCoursesPerClass);
+    const int classroomCount = qMax(1, m_classCount / 2);
+
+    // 班级
+    QVariantList ids, names, grades, departments;
+    for (int i = 1; i <= m_classCount; i++) {
+        ids << i;
+        names << QString("班级%1").arg(i);
+        grades << QString("%1级").arg(2020 + i % 4);
+        departments << QString("学院%1").arg(i % 12);
+    }
+    query.prepare("INSERT INTO class_info (id, class_name, grade, department) VALUES (?, ?, ?, ?)");
+    query.addBindValue(ids);
+    query.addBindValue(names);
+    query.addBindValue(grades);
+    query.addBindValue(departments);
+    QVERIFY2(query.execBatch(), qPrintable(query.lastError().text()));
+
+    // 教室
+    QVariantList roomIds, roomNames;
+    for (int i = 1; i <= classroomCount; i++) {
+        roomIds << i;
+        roomNames << QString("R%1").arg(i, 4, 10, QChar('0'));
+    }
+    query.prepare("INSERT INTO classroom_info (id, classroom_name) VALUES (?, ?)");
+    query.addBindValue(roomIds);
+    query.addBindValue(roomNames);
+    QVERIFY2(query.execBatch(), qPrintable(query.lastError().text()));
+
+    // 字典：教师、课程名称、课程类型（ID 从1开始连续编号）
+    auto seedDictionary = [&query](const QString& table, const QString& column, const QString& pattern, int count) {
+        QVariantList dictIds, dictNames;
+        for (int i = 0; i < count; i++) {
+            dictIds << i + 1;
+            dictNames << pattern.arg(i);
+        }
+        query.prepare(QString("INSERT INTO %1 (id, %2) VALUES (?, ?)").arg(table, column));
+        query.addBindValue(dictIds);
+        query.addBindValue(dictNames);
+        return query.execBatch();
+    };
+    QVERIFY2(seedDictionary("teacher_info", "teacher_name", "教师%1", kTeacherCount), qPrintable(query.lastError().text()));
+    QVERIFY2(seedDictionary("course_name_info", "course_name", "课程%1", kCourseNameCount), qPrintable(query.lastError().text()));
+    query.prepare("INSERT INTO course_type_info (id, type_name) VALUES (1, '必修课'), (2, '选修课')");
+    QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+
+    // 课程（日期范围覆盖今天）
+    const QDate today = QDate::currentDate();
+    const QString startDate = today.addDays(-30).toString("yyyy-MM-dd");
+    const QString endDate = today.addDays(120).toString("yyyy-MM-dd");
+    QVariantList classIds, courseNameIds, teacherIds, typeIds, startTimes, endTimes, days, startDates, endDates, rooms, weekMasks;
+    for (int i = 0; i < courseRows; i++) {
+        int slot = i % kCoursesPerClass;
+        QTime start = QTime(8, 0).addSecs((slot / 7) * 70 * 60);
+        classIds << (i / kCoursesPerClass) % m_classCount + 1;
+        courseNameIds << i % kCourseNameCount + 1;
+        teacherIds << i % kTeacherCount + 1;
+        typeIds << (i % 5 == 0 ? 2 : 1);
+        startTimes << start.toString("HH:mm");
+        endTimes << start.addSecs(60 * 60).toString("HH:mm");
+        days << slot % 7 + 1;
+        startDates << startDate;
+        endDates << endDate;
+        rooms << i % classroomCount + 1;
+        // 四分之一课程只在单周上课，覆盖上课周位图过滤
+        weekMasks << (i % 4 == 3 ? WeekMask::oddWeeks() : WeekMask::kAllWeeks);
+    }
+    query.prepare(R"(
+        INSERT INTO course_schedule (class_id, course_name_id, teacher_id, course_type_id,
+                                    start_time, end_time, day_of_week, start_date, end_date, classroom_id, week_mask)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+    )");
+    query.addBindValue(classIds);
+    query.addBindValue(courseNameIds);
+    query.addBindValue(teacherIds);
+    query.addBindValue(typeIds);
+    query.addBindValue(startTimes);
+    query.addBindValue(endTimes);
+    query.addBindValue(days);
+    query.addBindValue(startDates);
+    query.addBindValue(endDates);
+    query.addBindValue(rooms);
+    query.addBindValue(weekMasks);
+    QVERIFY2(query.execBatch(), qPrintable(query.lastError().text()));
+
+    // 通知（约为课程数的1/10，一半滚动，部分已过期）
+    QVariantList titles, contents, publishTimes, expireTimes, scrolling;
+    const int noticeCount = qMax(1, courseRows / 10);
+    for (int i = 0; i < noticeCount; i++) {
+        titles << QString("通知%1").arg(i);
+        contents << QString("通知内容%1：请各班级按时参加活动。").arg(i);
+        publishTimes << today.addDays(-(i % 60)).toString("yyyy-MM-dd") + " 08:00:00";
+        expireTimes << today.addDays(i % 3 == 0 ? -1 : 30).toString("yyyy-MM-dd");
+        scrolling << i % 2;
+    }
+    query.prepare(R"(
+        INSERT INTO notices (title, content, publish_time, expire_time, is_scrolling, is_valid)
+        VALUES (?, ?, ?, ?, ?, 1)
+    )");
+    query.addBindValue(titles);
+    query.addBindValue(contents);
+    query.addBindValue(publishTimes);
+    query.addBindValue(expireTimes);
+    query.addBindValue(scrolling);
+    QVERIFY2(query.execBatch(), qPrintable(query.lastError().text()));
+
+    QVERIFY(db.commit());
+    // 课表绕过 addCourse 直接写入，有效课表需按需重新展开
+    DatabaseManager::instance().invalidateEffectiveSchedule();
+    query.exec("ANALYZE");
+    m_seededRows = courseRows;
+}
+
+// 构造与服务器格式一致的同步报文
+QByteArray BenchDatabase::buildSyncPayload(int courseRows)
+{
+    const QDate today = QDate::currentDate();
+    QJsonArray courses;
+    for (int i = 0; i < courseRows; i++) {
+        int slot = i % kCoursesPerClass;
+        QTime start = QTime(8, 0).addSecs((slot / 7) * 70 * 60);
+        QJsonObject course;
+        course["id"] = 1000000 + i;
+        course["class_id"] = (i / kCoursesPerClass) % qMax(1, m_classCount) + 1;
+        course["course_name"] = QString("课程%1").arg(i % kCourseNameCount);
+        course["teacher"] = QString("教师%1").arg(i % kTeacherCount);
+        course["course_type"] = "必修课";
+        course["start_time"] = start.toString("HH:mm");
+        course["end_time"] = start.addSecs(60 * 60).toString("HH:mm");
+        course["day_of_week"] = slot % 7 + 1;
+        course["start_date"] = today.addDays(-30).toString("yyyy-MM-dd");
+        course["end_date"] = today.addDays(120).toString("yyyy-MM-dd");
+        course["classroom"] = QString("R%1").arg(i % 20 + 1, 4, 10, QChar('0'));
+        courses.append(course);
+    }
+
+    QJsonArray notices;
+    for (int i = 0; i < qMax(1, courseRows / 10); i++) {
+        QJsonObject notice;
+        notice["id"] = 1000000 + i;
+        notice["title"] = QString("同步通知%1").arg(i);
+        notice["content"] = QString("同步通知内容%1").arg(i);
+        notice["publish_time"] = today.toString("yyyy-MM-dd") + " 08:00:00";
+        notice["expire_time"] = today.addDays(7).toString("yyyy-MM-dd");
+        notice["is_scrolling"] = i % 2 == 0;
+        notices.append(notice);
+    }
+
+    QJsonObject root;
+    root["code"] = 200;
+    root["msg"] = "ok";
+    root["classes"] = QJsonArray();
+    root["courses"] = courses;
+    root["notices"] = notices;
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+// -------------------------- 查询热点 --------------------------
+void BenchDatabase::getCurrentCourse_data() { addDatasetSizes(); }
+void BenchDatabase::getCurrentCourse()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    int classId = 0;
+    QBENCHMARK {
+        DatabaseManager::instance().getCurrentCourse(classId % m_classCount + 1);
+        classId++;
+    }
+}
+
+void BenchDatabase::getNextCourse_data() { addDatasetSizes(); }
+void BenchDatabase::getNextCourse()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    int classId = 0;
+    QBENCHMARK {
+        DatabaseManager::instance().getNextCourse(classId % m_classCount + 1);
+        classId++;
+    }
+}
+
+void BenchDatabase::getCoursesByClassId_data() { addDatasetSizes(); }
+void BenchDatabase::getCoursesByClassId()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    int classId = 0;
+    QBENCHMARK {
+        QList<QVariantMap> courses = DatabaseManager::instance().getCoursesByClassId(classId % m_classCount + 1);
+        Q_UNUSED(courses);
+        classId++;
+    }
+}
+
+// 异步课表查询往返（提交到线程池、池线程只读连接执行、取回结果），与同步版本对比调度开销
+void BenchDatabase::asyncCoursesByClassId_data() { addDatasetSizes(); }
+void BenchDatabase::asyncCoursesByClassId()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    // 结果与同步查询一致
+    QFuture<QList<QVariantMap>> first = AsyncDatabase::instance().getCoursesByClassId(1);
+    first.waitForFinished();
+    QList<QVariantMap> expected = DatabaseManager::instance().getCoursesByClassId(1);
+    QCOMPARE(first.result().size(), expected.size());
+    if (!expected.isEmpty()) {
+        QCOMPARE(first.result().first().value("course_name"), expected.first().value("course_name"));
+        QCOMPARE(first.result().first().value("teacher"), expected.first().value("teacher"));
+    }
+
+    int classId = 0;
+    QBENCHMARK {
+        QFuture<QList<QVariantMap>> future = AsyncDatabase::instance().getCoursesByClassId(classId % m_classCount + 1);
+        future.waitForFinished();
+        Q_UNUSED(future.result());
+        classId++;
+    }
+}
+
+void BenchDatabase::getCoursesByTeacher_data() { addDatasetSizes(); }
+void BenchDatabase::getCoursesByTeacher()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    int teacherId = 0;
+    QBENCHMARK {
+        QList<QVariantMap> courses = DatabaseManager::instance().getCoursesByTeacher(teacherId % kTeacherCount + 1);
+        Q_UNUSED(courses);
+        teacherId++;
+    }
+}
+
+void BenchDatabase::getValidNotices_data() { addDatasetSizes(); }
+void BenchDatabase::getValidNotices()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    QBENCHMARK {
+        QList<QVariantMap> notices = DatabaseManager::instance().getValidNotices(true);
+        Q_UNUSED(notices);
+    }
+}
+
+// 通知管理分页：从列表中部的游标再取一页（键集分页，耗时不随翻页深度增长）
+void BenchDatabase::noticePage_data() { addDatasetSizes(); }
+void BenchDatabase::noticePage()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    // 定位到列表中部的游标
+    QSqlQuery query(DatabaseManager::instance().getDb());
+    QVERIFY(query.exec(QString("SELECT publish_time, id FROM notices ORDER BY publish_time DESC, id DESC "
+                               "LIMIT 1 OFFSET %1").arg(rows / 20)));
+    QVERIFY(query.next());
+    const QString afterPublishTime = query.value(0).toString();
+    const int afterId = query.value(1).toInt();
+
+    QBENCHMARK {
+        QList<QVariantMap> page = DatabaseManager::instance().getNoticePage(
+            DatabaseManager::ValidNotices, "", "", afterPublishTime, afterId, 64);
+        Q_UNUSED(page);
+    }
+}
+
+// 多选批量操作：500条通知切换滚动状态（一个事务），每轮开关各一次以保持数据不变
+void BenchDatabase::bulkNoticeScrolling_data() { addDatasetSizes(); }
+void BenchDatabase::bulkNoticeScrolling()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    QList<int> noticeIds;
+    QSqlQuery query(DatabaseManager::instance().getDb());
+    QVERIFY(query.exec("SELECT id FROM notices WHERE is_scrolling = 1 ORDER BY id LIMIT 500"));
+    while (query.next()) {
+        noticeIds.append(query.value(0).toInt());
+    }
+    QVERIFY(!noticeIds.isEmpty());
+
+    QBENCHMARK {
+        QCOMPARE(DatabaseManager::instance().setNoticesScrolling(noticeIds, false), noticeIds.size());
+        QCOMPARE(DatabaseManager::instance().setNoticesScrolling(noticeIds, true), noticeIds.size());
+    }
+}
+
+// 通知全文检索：精确编号（少量命中，按相关度）与宽泛关键词（大量命中，按发布先后）
+void BenchDatabase::searchNotices_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::addColumn<QString>("keyword");
+    for (int rows : {1000, 10000, 100000}) {
+        QTest::newRow(qPrintable(QString("rows=%1 selective").arg(rows))) << rows << QString("通知内容%1").arg(rows / 20);
+        QTest::newRow(qPrintable(QString("rows=%1 broad").arg(rows))) << rows << QString("请各班级");
+    }
+}
+
+void BenchDatabase::searchNotices()
+{
+    QFETCH(int, rows);
+    QFETCH(QString, keyword);
+    seedDataset(rows);
+
+    QBENCHMARK {
+        QList<QVariantMap> hits = DatabaseManager::instance().searchNotices(keyword, 64);
+        QVERIFY(!hits.isEmpty());
+    }
+}
+
+// 轮播只前移缓存环的下标，首次调用时加载
+void BenchDatabase::noticeRotation_data() { addDatasetSizes(); }
+void BenchDatabase::noticeRotation()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+    NoticeRotation::instance().invalidate();
+    QVERIFY(NoticeRotation::instance().size() > 0);
+
+    QBENCHMARK {
+        QString text = NoticeRotation::instance().next();
+        Q_UNUSED(text);
+    }
+}
+
+// 调度表重载：读取有效通知的发布/过期时刻并重建最小堆（首轮同时批量置过期通知无效）
+void BenchDatabase::noticeScheduler_data() { addDatasetSizes(); }
+void BenchDatabase::noticeScheduler()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    QBENCHMARK {
+        NoticeScheduler::instance().reload();
+    }
+    QVERIFY(NoticeScheduler::instance().pendingEvents() > 0);
+}
+
+void BenchDatabase::searchClasses_data() { addDatasetSizes(); }
+void BenchDatabase::searchClasses()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    QBENCHMARK {
+        QList<QVariantMap> classes = DatabaseManager::instance().searchClasses("学院1");
+        Q_UNUSED(classes);
+    }
+}
+
+void BenchDatabase::getFreeClassrooms_data() { addDatasetSizes(); }
+void BenchDatabase::getFreeClassrooms()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    // 首次查询构建区间索引，不计入测量
+    const QDate today = QDate::currentDate();
+    DatabaseManager::instance().getFreeClassrooms(today, QTime(9, 30));
+
+    int step = 0;
+    QBENCHMARK {
+        QList<QVariantMap> rooms = DatabaseManager::instance().getFreeClassrooms(today, QTime(8, 0).addSecs((step % 40) * 15 * 60));
+        Q_UNUSED(rooms);
+        step++;
+    }
+}
+
+// -------------------------- 同步落库 --------------------------
+void BenchDatabase::syncApply_data() { addSyncSizes(); }
+void BenchDatabase::syncApply()
+{
+    QFETCH(int, rows);
+    seedDataset(1000);
+    QByteArray payload = buildSyncPayload(rows);
+
+    QBENCHMARK_ONCE {
+        QVERIFY(m_worker->parseAndSyncData(payload));
+    }
+
+    // 同步会改写数据集，后续用例需重新生成
+    m_seededRows = -1;
+}
+
+// -------------------------- 连接参数 --------------------------
+// 同一同步报文在各连接参数预设下的落库耗时（整份报文一个事务，差异来自日志模式与提交时的写盘）
+void BenchDatabase::pragmaSyncApply_data() { addPragmaPresets(); }
+void BenchDatabase::pragmaSyncApply()
+{
+    QFETCH(QString, preset);
+    seedDataset(1000);
+    QByteArray payload = buildSyncPayload(1000);
+
+    const SqlitePragmaProfile previous = SqlitePragmaProfile::current();
+    DatabaseManager::instance().setPragmaProfile(SqlitePragmaProfile::preset(preset));
+    bool applied = false;
+    QBENCHMARK_ONCE {
+        applied = m_worker->parseAndSyncData(payload);
+    }
+    DatabaseManager::instance().setPragmaProfile(previous);
+    QVERIFY(applied);
+
+    m_seededRows = -1;
+}
+
+// 另一连接（模拟同步守护进程）持续小事务写入时，主连接查询班级课表的耗时
+// 回滚日志模式下写事务提交期间读被阻塞（等待 busy_timeout），WAL 模式下读写互不阻塞
+void BenchDatabase::pragmaReadLatency_data() { addPragmaPresets(); }
+void BenchDatabase::pragmaReadLatency()
+{
+    QFETCH(QString, preset);
+    seedDataset(10000);
+
+    const SqlitePragmaProfile previous = SqlitePragmaProfile::current();
+    const SqlitePragmaProfile profile = SqlitePragmaProfile::preset(preset);
+    DatabaseManager::instance().setPragmaProfile(profile);
+
+    int maxNoticeId = 0;
+    QSqlQuery query(DatabaseManager::instance().getDb());
+    if (query.exec("SELECT MAX(id) FROM notices") && query.next()) {
+        maxNoticeId = query.value(0).toInt();
+    }
+    QVERIFY(maxNoticeId > 0);
+
+    QAtomicInt stop(0);
+    const QString dbPath = DatabaseManager::instance().getDb().databaseName();
+    QFuture<int> writer = QtConcurrent::run([dbPath, profile, maxNoticeId, &stop]() {
+        int commits = 0;
+        {
+            QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "bench_writer");
+            db.setDatabaseName(dbPath);
+            if (db.open()) {
+                profile.apply(db, false);
+                QSqlQuery update(db);
+                update.prepare("UPDATE notices SET is_scrolling = 1 - is_scrolling WHERE id = ?");
+                int id = 0;
+                while (!stop.loadRelaxed()) {
+                    db.transaction();
+                    for (int i = 0; i < 50; i++) {
+                        update.addBindValue(id++ % maxNoticeId + 1);
+                        update.exec();
+                    }
+                    if (db.commit()) {
+                        commits++;
+                    }
+                }
+                db.close();
+            }
+        }
+        QSqlDatabase::removeDatabase("bench_writer");
+        return commits;
+    });
+
+    int classId = 0;
+    qint64 maxReadNs = 0;
+    QBENCHMARK {
+        QElapsedTimer read;
+        read.start();
+        QList<QVariantMap> courses = DatabaseManager::instance().getCoursesByClassId(classId % m_classCount + 1);
+        Q_UNUSED(courses);
+        maxReadNs = qMax(maxReadNs, read.nsecsElapsed());
+        classId++;
+    }
+
+    stop.storeRelaxed(1);
+    const int commits = writer.result();
+    DatabaseManager::instance().setPragmaProfile(previous);
+
+    QVERIFY(commits > 0);
+    recordExtra("max_read_ms", maxReadNs / 1e6);
+    recordExtra("writer_commits", commits);
+}
+
+// -------------------------- 模拟时间 --------------------------
+// 用模拟时钟逐个跳过整个学期（数据集日期范围）的上课/下课时刻，每个时刻刷新一次当前/下节课
+void BenchDatabase::semesterSimulation()
+{
+    seedDataset(1000);
+
+    const QDate today = QDate::currentDate();
+    const QDateTime semesterStart(today.addDays(-30), QTime(0, 0));
+    const QDateTime semesterEnd(today.addDays(121), QTime(0, 0));
+
+    ScheduleSimulator simulator;
+    int transitions = 0;
+    int busyTransitions = 0;
+
+    QBENCHMARK_ONCE {
+        Clock::instance().startSimulation(semesterStart, 0.0);
+        while (true) {
+            QDateTime at = simulator.step();
+            if (!at.isValid() || at >= semesterEnd) {
+                break;
+            }
+            transitions++;
+
+            QVariantMap current = DatabaseManager::instance().getCurrentCourse(1);
+            DatabaseManager::instance().getNextCourse(1);
+            if (!current.isEmpty()) {
+                // 当前课程必须覆盖模拟时刻
+                QVERIFY(current["start_time"].toString() <= at.toString("HH:mm"));
+                QVERIFY(current["end_time"].toString() >= at.toString("HH:mm"));
+                busyTransitions++;
+            }
+        }
+    }
+    Clock::instance().resetToSystem();
+
+    // 每天8个时段（上课+下课各一次切换），约150天
+    QVERIFY(transitions > 150 * 8);
+    QVERIFY(busyTransitions > 0);
+    recordExtra("transitions", transitions);
+    recordExtra("busy_transitions", busyTransitions);
+}
+
+// -------------------------- 在线备份 --------------------------
+// 后台备份期间主线程持续查询当前课程，记录单次查询的最大耗时（备份不应阻塞读）
+void BenchDatabase::onlineBackup_data() { addDatasetSizes(); }
+void BenchDatabase::onlineBackup()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    const QString target = m_tempDir.filePath(QString("snapshot_%1.db").arg(rows));
+    QSignalSpy finished(&DatabaseManager::instance(), &DatabaseManager::backupFinished);
+    qint64 maxReadNs = 0;
+    int reads = 0;
+
+    QBENCHMARK_ONCE {
+        QVERIFY(DatabaseManager::instance().backupAsync(target));
+        QElapsedTimer deadline;
+        deadline.start();
+        while (finished.isEmpty() && deadline.elapsed() < 60000) {
+            QElapsedTimer read;
+            read.start();
+            DatabaseManager::instance().getCurrentCourse(1);
+            maxReadNs = qMax(maxReadNs, read.nsecsElapsed());
+            reads++;
+            QCoreApplication::processEvents();
+        }
+    }
+
+    QCOMPARE(finished.size(), 1);
+    QVERIFY2(finished.first().at(0).toBool(), qPrintable(finished.first().at(2).toString()));
+    QVERIFY(QFileInfo(target).size() > 0);
+    recordExtra("snapshot_bytes", QFileInfo(target).size());
+    recordExtra("reads_during_backup", reads);
+    recordExtra("max_read_ms", maxReadNs / 1e6);
+}
+
+// -------------------------- 快照开通 --------------------------
+// 用当前数据集的快照整体替换数据库（校验、关闭连接、改名、重新连接），对比 syncApply 的逐行落库
+void BenchDatabase::snapshotProvision_data() { addDatasetSizes(); }
+void BenchDatabase::snapshotProvision()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    const QString snapshot = m_tempDir.filePath(QString("provision_%1.db").arg(rows));
+    const DatabaseBackup::Result backup = DatabaseBackup::run(DatabaseManager::instance().getDb().databaseName(), snapshot);
+    QVERIFY2(backup.ok, qPrintable(backup.error));
+    const int courses = DatabaseManager::instance().getCoursesByClassId(1).size();
+
+    QSignalSpy replaced(&DatabaseManager::instance(), &DatabaseManager::databaseReplaced);
+    QBENCHMARK_ONCE {
+        QVERIFY(DatabaseManager::instance().replaceWithSnapshot(snapshot, rows));
+    }
+
+    // 快照已改名为数据库文件，内容与替换前一致
+    QCOMPARE(replaced.size(), 1);
+    QVERIFY(!QFile::exists(snapshot));
+    QCOMPARE(DatabaseManager::instance().getSyncRevision(), qint64(rows));
+    QCOMPARE(DatabaseManager::instance().getCoursesByClassId(1).size(), courses);
+    recordExtra("snapshot_bytes", backup.bytes);
+
+    // 清除版本，避免影响其他用例的同步请求
+    QVERIFY(DatabaseManager::instance().setSyncRevision(0));
+}
+
+// -------------------------- 数据保留 --------------------------
+// 按数据保留任务的批大小归档全部过期通知与（以学期结束后为截止日期的）全部课程，再回收空闲页
+void BenchDatabase::retentionArchive_data() { addDatasetSizes(); }
+void BenchDatabase::retentionArchive()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    const QDate today = QDate::currentDate();
+    const QString noticeBefore = today.toString("yyyy-MM-dd");
+    const QString courseBefore = today.addDays(121).toString("yyyy-MM-dd");
+    const int batchSize = 200;
+    int notices = 0;
+    int courses = 0;
+    int batches = 0;
+
+    QBENCHMARK_ONCE {
+        int moved = 0;
+        do {
+            moved = DatabaseManager::instance().archiveExpiredNotices(noticeBefore, batchSize);
+            QVERIFY(moved >= 0);
+            notices += moved;
+            batches++;
+        } while (moved == batchSize);
+        do {
+            moved = DatabaseManager::instance().archiveEndedCourses(courseBefore, batchSize);
+            QVERIFY(moved >= 0);
+            courses += moved;
+            batches++;
+        } while (moved == batchSize);
+        int freePages = -1;
+        int remaining = 0;
+        while ((remaining = DatabaseManager::instance().incrementalVacuum(256)) > 0
+               && (freePages < 0 || remaining < freePages)) {
+            freePages = remaining;
+            batches++;
+        }
+    }
+
+    // 约1/3的通知已于昨天过期
+    QCOMPARE(courses, rows);
+    QVERIFY(notices > 0);
+    recordExtra("archived_notices", notices);
+    recordExtra("archived_courses", courses);
+    recordExtra("batches", batches);
+
+    // 热表已被清空，后续用例需重新生成数据
+    m_seededRows = -1;
+}
+
+// -------------------------- 课表冲突检测 --------------------------
+void BenchDatabase::conflictAnalysis_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("rows=10000") << 10000;
+    QTest::newRow("rows=100000") << 100000;
+    QTest::newRow("rows=200000") << 200000;
+}
+
+void BenchDatabase::conflictAnalysis()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    ConflictAnalyzer::Report report;
+    QBENCHMARK {
+        report = ConflictAnalyzer::analyze(DatabaseManager::instance().getDb());
+    }
+
+    QVERIFY(report.ok);
+    QCOMPARE(report.courseRows, rows);
+    // 目标：20万行在1秒内完成（读取+排序+扫描）
+    if (report.elapsedSeconds > 1.0) {
+        qWarning() << "冲突检测超出1秒预算：" << report.elapsedSeconds << "秒";
+    }
+    recordExtra("teacher_conflicts", report.teacherConflicts);
+    recordExtra("classroom_conflicts", report.classroomConflicts);
+}
+
+// -------------------------- 字典编码收益 --------------------------
+void BenchDatabase::dictionaryFootprint_data()
+{
+    QTest::addColumn<int>("rows");
+    QTest::newRow("rows=100000") << 100000;
+    QTest::newRow("rows=200000") << 200000;
+}
+
+// 对比课程名称/教师/类型按文本逐行存储与按字典ID存储时的库内占用，
+// 以及全部班级课表结果常驻内存时驻留字符串与逐行独立字符串的内存差异
+void BenchDatabase::dictionaryFootprint()
+{
+    QFETCH(int, rows);
+    seedDataset(rows);
+
+    QSqlDatabase db = DatabaseManager::instance().getDb();
+    QSqlQuery query(db);
+    auto usedBytes = [&query]() -> qint64 {
+        qint64 pages = 0, freePages = 0, pageSize = 0;
+        if (query.exec("PRAGMA page_count") && query.next()) pages = query.value(0).toLongLong();
+        if (query.exec("PRAGMA freelist_count") && query.next()) freePages = query.value(0).toLongLong();
+        if (query.exec("PRAGMA page_size") && query.next()) pageSize = query.value(0).toLongLong();
+        return (pages - freePages) * pageSize;
+    };
+
+    // 只含这三列的副本表，差值即编码带来的占用变化
+    qint64 before = usedBytes();
+    QVERIFY2(query.exec(R"(
+        CREATE TABLE bench_text_columns AS
+        SELECT n.course_name, t.teacher_name, ty.type_name
+        FROM course_schedule cs
+        JOIN course_name_info n ON n.id = cs.course_name_id
+        JOIN teacher_info t ON t.id = cs.teacher_id
+        JOIN course_type_info ty ON ty.id = cs.course_type_id
+    )"), qPrintable(query.lastError().text()));
+    const qint64 textBytes = usedBytes() - before;
+    QVERIFY(query.exec("DROP TABLE bench_text_columns"));
+
+    before = usedBytes();
+    QVERIFY2(query.exec("CREATE TABLE bench_id_columns AS SELECT course_name_id, teacher_id, course_type_id FROM course_schedule"),
+             qPrintable(query.lastError().text()));
+    const qint64 idBytes = usedBytes() - before;
+    QVERIFY(query.exec("DROP TABLE bench_id_columns"));
+
+    // 常驻内存：驻留字符串（DatabaseManager 查询结果）
+    qint64 rssBefore = MetricsRegistry::processResidentBytes();
+    QList<QList<QVariantMap>> interned;
+    for (int classId = 1; classId <= m_classCount; classId++) {
+        interned.append(DatabaseManager::instance().getCoursesByClassId(classId));
+    }
+    const qint64 internedRss = MetricsRegistry::processResidentBytes() - rssBefore;
+
+    // 常驻内存：同样的结果，但每行持有独立的字符串副本（编码前的行为）
+    rssBefore = MetricsRegistry::processResidentBytes();
+    QList<QList<QVariantMap>> copied;
+    for (const QList<QVariantMap>& courses : interned) {
+        QList<QVariantMap> copies;
+        for (const QVariantMap& course : courses) {
+            QVariantMap copy;
+            for (auto it = course.constBegin(); it != course.constEnd(); ++it) {
+                if (it.value().typeId() == QMetaType::QString) {
+                    const QString text = it.value().toString();
+                    copy.insert(it.key(), QString(text.constData(), text.size()));
+                } else {
+                    copy.insert(it.key(), it.value());
+                }
+            }
+            copies.append(copy);
+        }
+        copied.append(copies);
+    }
+    const qint64 copiedRss = MetricsRegistry::processResidentBytes() - rssBefore;
+
+    recordExtra("text_column_bytes", textBytes);
+    recordExtra("id_column_bytes", idBytes);
+    recordExtra("copied_rss_bytes", copiedRss);
+    recordExtra("interned_rss_bytes", internedRss);
+    QTest::setBenchmarkResult(textBytes - idBytes, QTest::BytesAllocated);
+}
+
+// -------------------------- 机器可读输出 --------------------------
+// 将QtTest的CSV输出转换为JSON（字段：function, tag, metric, value, total, iterations），
+// 附加指标写入 extra（字段：function, tag, metric, value）
+static bool writeJsonReport(const QString& csvPath, const QString& jsonPath)
+{
+    QFile csvFile(csvPath);
+    if (!csvFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return false;
+    }
+
+    QJsonArray results;
+    while (!csvFile.atEnd()) {
+        QString line = QString::fromUtf8(csvFile.readLine()).trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        QStringList fields;
+        for (const QString& field : line.split(',')) {
+            QString value = field.trimmed();
+            if (value.startsWith('"') && value.endsWith('"') && value.size() >= 2) {
+                value = value.mid(1, value.size() - 2);
+            }
+            fields << value;
+        }
+        // 跳过表头及不完整的行
+        if (fields.size() < 5 || fields[0] == "function") {
+            continue;
+        }
+
+        QJsonObject result;
+        result["function"] = fields[0];
+        result["tag"] = fields[1];
+        result["metric"] = fields[2];
+        result["value"] = fields[3].toDouble();
+        if (fields.size() >= 6) {
+            result["total"] = fields[4].toDouble();
+            result["iterations"] = fields[5].toInt();
+        } else {
+            result["iterations"] = fields[4].toInt();
+        }
+        results.append(result);
+    }
+    csvFile.close();
+
+    QJsonObject root;
+    root["suite"] = "bench_database";
+    root["generated_at"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["qt_version"] = QString(qVersion());
+    root["host"] = QSysInfo::machineHostName();
+    root["cpu_arch"] = QSysInfo::currentCpuArchitecture();
+    root["results"] = results;
+    root["extra"] = extraResults();
+
+    QFile jsonFile(jsonPath);
+    if (!jsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    jsonFile.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    jsonFile.close();
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("bench_database");
+
+    QStringList args = app.arguments();
+
+    // 用户自行指定 -o 时尊重其选择，不再额外导出
+    const bool customOutput = args.contains("-o");
+    QString csvPath;
+    QString jsonPath;
+    if (!customOutput) {
+        QDir outDir(qEnvironmentVariable("BENCH_OUTPUT_DIR", QDir::currentPath()));
+        csvPath = outDir.filePath("bench_database.csv");
+        jsonPath = outDir.filePath("bench_database.json");
+        args << "-o" << csvPath + ",csv" << "-o" << "-,txt";
+    }
+
+    BenchDatabase bench;
+    int ret = QTest::qExec(&bench, args);
+
+    if (!customOutput && !writeJsonReport(csvPath, jsonPath)) {
+        qWarning() << "基准结果JSON导出失败：" << jsonPath;
+    }
+    return ret;
+}
+
+#include "tst_bench_database.moc"
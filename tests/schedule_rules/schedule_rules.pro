@@ -0,0 +1,15 @@
+# 课表规则行为测试（校历展开、上课周、冲突检测的已知结果用例）
+QT       += core sql network testlib
+QT       -= gui
+
+CONFIG   += console testcase
+CONFIG   -= app_bundle
+
+TARGET = schedule_rules
+TEMPLATE = app
+
+include(../../src/core/classboard_core.pri)
+
+# 源文件
+SOURCES += \
+    tst_schedule_rules.cpp
@@ -0,0 +1,441 @@
+#include <QtTest>
+#include <QCoreApplication>
+#include <QTemporaryDir>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QStandardPaths>
+#include "data/DatabaseManager.h"
+#include "data/ConflictAnalyzer.h"
+#include "utility/Clock.h"
+#include "utility/TimeHelper.h"
+#include "utility/WeekMask.h"
+
+static const int kClassId = 1;
+static const char* const kSemesterStart = "2026-03-02";  // 周一
+static const char* const kSemesterEnd = "2026-07-05";
+
+// 课表规则行为测试：用小规模固定数据验证已知结果
+// 运行：./schedule_rules [QtTest参数]
+class ScheduleRules : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void init();
+
+    // 校历与有效课表
+    void holidayHidesCourses();
+    void makeupDayUsesAsDayOfWeek();
+    void addDeleteCourseSyncsEffectiveSchedule();
+
+    // 上课周位图
+    void weekMaskParse_data();
+    void weekMaskParse();
+    void weekMaskContains();
+    void weekMaskOverlaps_data();
+    void weekMaskOverlaps();
+    void weekMaskSqlMatchesContains_data();
+    void weekMaskSqlMatchesContains();
+
+    // 教师/教室冲突检测
+    void conflictAnalysis_data();
+    void conflictAnalysis();
+    void conflictSweepCountsEachPair();
+
+private:
+    // 在测试班级添加一门课程（默认整学期、每周、张老师、不指定教室），返回课程ID（失败返回0）
+    int addCourse(const QString& courseName, int dayOfWeek, const QString& startTime, const QString& endTime,
+                  const QString& teacher = "张老师", int classroomId = 0, qint64 weekMask = WeekMask::kAllWeeks,
+                  const QString& startDate = kSemesterStart, const QString& endDate = kSemesterEnd);
+    // 时钟停在指定时刻（yyyy-MM-dd HH:mm）
+    static void setNow(const QString& dateTime);
+    // 指定日期有效课表的行数
+    static int effectiveRows(const QString& date);
+
+    QTemporaryDir m_tempDir;
+};
+
+void ScheduleRules::initTestCase()
+{
+    // 日志与配置文件写入测试目录，不污染真实AppData
+    QStandardPaths::setTestModeEnabled(true);
+    QVERIFY(m_tempDir.isValid());
+    QVERIFY(DatabaseManager::instance().init(m_tempDir.filePath("schedule_rules.db")));
+}
+
+void ScheduleRules::cleanupTestCase()
+{
+    Clock::instance().resetToSystem();
+}
+
+// 每个用例从只有一个班级的空课表开始
+void ScheduleRules::init()
+{
+    QSqlQuery query(DatabaseManager::instance().getDb());
+    const QStringList tables = {"course_schedule", "classroom_info", "class_info", "teacher_info",
+                                "course_name_info", "course_type_info", "calendar_exceptions"};
+    for (const QString& table : tables) {
+        QVERIFY2(query.exec("DELETE FROM " + table), qPrintable(query.lastError().text()));
+    }
+    DatabaseManager::instance().invalidateEffectiveSchedule();
+
+    query.prepare("INSERT INTO class_info (id, class_name, grade, department) VALUES (?, '测试班级', '2026级', '测试学院')");
+    query.addBindValue(kClassId);
+    QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+}
+
+int ScheduleRules::addCourse(const QString& courseName, int dayOfWeek, const QString& startTime, const QString& endTime,
+                             const QString& teacher, int classroomId, qint64 weekMask,
+                             const QString& startDate, const QString& endDate)
+{
+    if (!DatabaseManager::instance().addCourse(kClassId, courseName, teacher, "必修", startTime, endTime, dayOfWeek,
+                                               startDate, endDate, classroomId, weekMask)) {
+        return 0;
+    }
+    QSqlQuery query(DatabaseManager::instance().getDb());
+    return query.exec("SELECT MAX(id) FROM course_schedule") && query.next() ? query.value(0).toInt() : 0;
+}
+
+void ScheduleRules::setNow(const QString& dateTime)
+{
+    Clock::instance().startSimulation(QDateTime::fromString(dateTime, "yyyy-MM-dd HH:mm"), 0.0);
+}
+
+int ScheduleRules::effectiveRows(const QString& date)
+{
+    QSqlQuery query(DatabaseManager::instance().getDb());
+    query.prepare("SELECT COUNT(*) FROM effective_schedule WHERE date = ?");
+    query.addBindValue(date);
+    return query.exec() && query.next() ? query.value(0).toInt() : -1;
+}
+
+// -------------------------- 校历与有效课表 --------------------------
+void ScheduleRules::holidayHidesCourses()
+{
+    DatabaseManager& db = DatabaseManager::instance();
+    QVERIFY(addCourse("数学", 1, "08:00", "09:40"));
+    QVERIFY(addCourse("语文", 1, "10:00", "11:40"));
+
+    // 当天已展开后再设为节假日：立即重新展开
+    setNow("2026-05-04 08:30");
+    QCOMPARE(db.getCurrentCourse(kClassId).value("course_name").toString(), QString("数学"));
+    QVERIFY(db.setCalendarException("2026-05-04", DatabaseManager::Holiday, 0, "劳动节"));
+    QVERIFY(db.getCurrentCourse(kClassId).isEmpty());
+    QVERIFY(db.getNextCourse(kClassId).isEmpty());
+    QCOMPARE(effectiveRows("2026-05-04"), 0);
+
+    // 取消节假日后恢复
+    QVERIFY(db.removeCalendarException("2026-05-04"));
+    QCOMPARE(db.getCurrentCourse(kClassId).value("course_name").toString(), QString("数学"));
+    QCOMPARE(db.getNextCourse(kClassId).value("course_name").toString(), QString("语文"));
+
+    // 先设节假日、后首次展开
+    QVERIFY(db.setCalendarException("2026-05-11", DatabaseManager::Holiday));
+    setNow("2026-05-11 08:30");
+    QVERIFY(db.getCurrentCourse(kClassId).isEmpty());
+    QVERIFY(db.getTransitionTimes(QDate(2026, 5, 11)).isEmpty());
+}
+
+void ScheduleRules::makeupDayUsesAsDayOfWeek()
+{
+    DatabaseManager& db = DatabaseManager::instance();
+    QVERIFY(addCourse("数学", 1, "08:00", "09:40"));
+    QVERIFY(addCourse("物理", 5, "08:00", "09:40"));
+
+    // 周六本无课
+    setNow("2026-05-09 08:30");
+    QVERIFY(db.getCurrentCourse(kClassId).isEmpty());
+
+    // 调休按周五课表上课，而不是按自然星期或周一
+    QVERIFY(db.setCalendarException("2026-05-09", DatabaseManager::MakeupDay, 5, "调休"));
+    QCOMPARE(db.getCurrentCourse(kClassId).value("course_name").toString(), QString("物理"));
+    QCOMPARE(effectiveRows("2026-05-09"), 1);
+    QCOMPARE(db.getTransitionTimes(QDate(2026, 5, 9)), QList<QTime>({QTime(8, 0), QTime(9, 41)}));
+
+    // 星期值非法时拒绝
+    QVERIFY(!db.setCalendarException("2026-05-10", DatabaseManager::MakeupDay, 0));
+}
+
+void ScheduleRules::addDeleteCourseSyncsEffectiveSchedule()
+{
+    DatabaseManager& db = DatabaseManager::instance();
+    QVERIFY(addCourse("数学", 1, "08:00", "09:40"));
+
+    // 先展开当天
+    setNow("2026-05-04 10:30");
+    QVERIFY(db.getCurrentCourse(kClassId).isEmpty());
+    QCOMPARE(effectiveRows("2026-05-04"), 1);
+
+    // 新增课程增量写入已展开日期；其他星期的课程不写入
+    const int englishId = addCourse("英语", 1, "10:00", "11:40");
+    QVERIFY(englishId > 0);
+    QVERIFY(addCourse("化学", 2, "10:00", "11:40"));
+    QCOMPARE(effectiveRows("2026-05-04"), 2);
+    QCOMPARE(db.getCurrentCourse(kClassId).value("course_name").toString(), QString("英语"));
+
+    // 删除课程同步移除
+    QVERIFY(db.deleteCourse(englishId));
+    QCOMPARE(effectiveRows("2026-05-04"), 1);
+    QVERIFY(db.getCurrentCourse(kClassId).isEmpty());
+
+    QSqlQuery query(db.getDb());
+    query.prepare("SELECT COUNT(*) FROM effective_schedule WHERE course_id = ?");
+    query.addBindValue(englishId);
+    QVERIFY(query.exec() && query.next());
+    QCOMPARE(query.value(0).toInt(), 0);
+}
+
+// -------------------------- 上课周位图 --------------------------
+void ScheduleRules::weekMaskParse_data()
+{
+    QTest::addColumn<QString>("spec");
+    QTest::addColumn<qint64>("mask");
+    QTest::newRow("empty") << "" << WeekMask::kAllWeeks;
+    QTest::newRow("all") << "all" << WeekMask::kAllWeeks;
+    QTest::newRow("range") << "1-8周" << qint64(0xFF);
+    QTest::newRow("list") << "1,3,5-7" << qint64(0x75);
+    QTest::newRow("fullwidth comma") << "1，3" << qint64(0x5);
+    QTest::newRow("week 64") << "64" << qint64(0x8000000000000000ULL);
+    QTest::newRow("odd") << "单周" << WeekMask::oddWeeks();
+    QTest::newRow("even") << "even" << WeekMask::evenWeeks();
+    QTest::newRow("hex") << "0x0f00" << qint64(0xF00);
+    QTest::newRow("hex all bits") << "0xffffffffffffffff" << WeekMask::kAllWeeks;
+    QTest::newRow("reversed") << "8-1" << qint64(0);
+    QTest::newRow("week 0") << "0" << qint64(0);
+    QTest::newRow("week 65") << "1-65" << qint64(0);
+    QTest::newRow("open range") << "3-" << qint64(0);
+    QTest::newRow("three bounds") << "1-2-3" << qint64(0);
+    QTest::newRow("text") << "abc" << qint64(0);
+}
+
+void ScheduleRules::weekMaskParse()
+{
+    QFETCH(QString, spec);
+    QFETCH(qint64, mask);
+    QCOMPARE(WeekMask::parse(spec), mask);
+}
+
+void ScheduleRules::weekMaskContains()
+{
+    QVERIFY(WeekMask::contains(WeekMask::oddWeeks(), 1));
+    QVERIFY(!WeekMask::contains(WeekMask::oddWeeks(), 2));
+    QVERIFY(WeekMask::contains(WeekMask::evenWeeks(), 64));
+    // 第64周以后只有每周上课的课程包含（负数位图也不例外）
+    QVERIFY(!WeekMask::contains(WeekMask::evenWeeks(), 66));
+    QVERIFY(!WeekMask::contains(WeekMask::range(60, 64), 65));
+    QVERIFY(WeekMask::contains(WeekMask::kAllWeeks, 65));
+    QVERIFY(!WeekMask::contains(WeekMask::range(1, 8), 0));
+
+    // 周次从开始日期所在周的周一起算
+    const QDate wednesday(2026, 3, 4);
+    QCOMPARE(WeekMask::weekOf(wednesday, QDate(2026, 3, 3)), 0);
+    QCOMPARE(WeekMask::weekOf(wednesday, QDate(2026, 3, 8)), 1);
+    QCOMPARE(WeekMask::weekOf(wednesday, QDate(2026, 3, 9)), 2);
+    QCOMPARE(WeekMask::weekOf(wednesday, QDate(2026, 7, 6)), 19);
+}
+
+void ScheduleRules::weekMaskOverlaps_data()
+{
+    QTest::addColumn<qint64>("maskA");
+    QTest::addColumn<QDate>("startA");
+    QTest::addColumn<qint64>("maskB");
+    QTest::addColumn<QDate>("startB");
+    QTest::addColumn<bool>("overlap");
+
+    const QDate monday(2026, 3, 2);
+    const QDate nextWednesday(2026, 3, 11);     // 晚一周开始（周中）
+    const QDate muchLater = monday.addDays(7 * 70);
+    QTest::newRow("odd vs even") << WeekMask::oddWeeks() << monday << WeekMask::evenWeeks() << monday << false;
+    QTest::newRow("odd vs week 3") << WeekMask::oddWeeks() << monday << WeekMask::range(3, 3) << monday << true;
+    QTest::newRow("disjoint ranges") << WeekMask::range(1, 8) << monday << WeekMask::range(9, 16) << monday << false;
+    // B 的第1周是 A 的第2周：同为单周时错开，B 单周与 A 双周对齐
+    QTest::newRow("shifted odd vs odd") << WeekMask::oddWeeks() << monday << WeekMask::oddWeeks() << nextWednesday << false;
+    QTest::newRow("shifted even vs odd") << WeekMask::evenWeeks() << monday << WeekMask::oddWeeks() << nextWednesday << true;
+    QTest::newRow("shifted order swapped") << WeekMask::oddWeeks() << nextWednesday << WeekMask::evenWeeks() << monday << true;
+    QTest::newRow("shifted range end") << WeekMask::range(1, 8) << monday << WeekMask::range(8, 8) << nextWednesday << false;
+    // B 的第64周移位后超出64位，A 每周上课仍然重叠
+    QTest::newRow("all vs shifted week 64") << WeekMask::kAllWeeks << monday << WeekMask::range(64, 64) << nextWednesday << true;
+    QTest::newRow("all vs empty") << WeekMask::kAllWeeks << monday << qint64(0) << monday << false;
+    QTest::newRow("beyond 64 weeks") << WeekMask::evenWeeks() << monday << WeekMask::kAllWeeks << muchLater << false;
+    QTest::newRow("all beyond 64 weeks") << WeekMask::kAllWeeks << monday << WeekMask::range(1, 1) << muchLater << true;
+}
+
+void ScheduleRules::weekMaskOverlaps()
+{
+    QFETCH(qint64, maskA);
+    QFETCH(QDate, startA);
+    QFETCH(qint64, maskB);
+    QFETCH(QDate, startB);
+    QFETCH(bool, overlap);
+
+    const qint64 mondayA = startA.addDays(1 - startA.dayOfWeek()).toJulianDay();
+    const qint64 mondayB = startB.addDays(1 - startB.dayOfWeek()).toJulianDay();
+    QCOMPARE(WeekMask::overlaps(maskA, mondayA, maskB, mondayB), overlap);
+    QCOMPARE(WeekMask::overlaps(maskB, mondayB, maskA, mondayA), overlap);
+}
+
+void ScheduleRules::weekMaskSqlMatchesContains_data()
+{
+    QTest::addColumn<qint64>("mask");
+    QTest::newRow("all") << WeekMask::kAllWeeks;
+    QTest::newRow("odd") << WeekMask::oddWeeks();
+    QTest::newRow("even") << WeekMask::evenWeeks();
+    QTest::newRow("1-8") << WeekMask::range(1, 8);
+    QTest::newRow("60-64") << WeekMask::range(60, 64);
+    QTest::newRow("64") << WeekMask::range(64, 64);
+}
+
+// SQL 与 C++ 对每一天（开始日期起70周）给出相同结果
+void ScheduleRules::weekMaskSqlMatchesContains()
+{
+    QFETCH(qint64, mask);
+
+    const QString connName = "schedule_rules_week_mask";
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", connName);
+        db.setDatabaseName(":memory:");
+        QVERIFY(db.open());
+        QSqlQuery query(db);
+        QVERIFY(query.exec("CREATE TABLE course (start_date TEXT, week_mask INTEGER)"));
+
+        // 开始日期分别为周一、周三、周日
+        const QList<QDate> startDates = {QDate(2026, 3, 2), QDate(2026, 3, 4), QDate(2026, 3, 8)};
+        for (const QDate& startDate : startDates) {
+            QVERIFY(query.exec("DELETE FROM course"));
+            query.prepare("INSERT INTO course (start_date, week_mask) VALUES (?, ?)");
+            query.addBindValue(startDate.toString("yyyy-MM-dd"));
+            query.addBindValue(mask);
+            QVERIFY2(query.exec(), qPrintable(query.lastError().text()));
+
+            query.prepare("SELECT " + WeekMask::sqlContains("c", "?") + " FROM course c");
+            for (int day = 0; day < 70 * 7; day++) {
+                const QDate date = startDate.addDays(day);
+                query.addBindValue(date.toString("yyyy-MM-dd"));
+                QVERIFY2(query.exec() && query.next(), qPrintable(query.lastError().text()));
+                QVERIFY2(query.value(0).toBool() == WeekMask::contains(mask, WeekMask::weekOf(startDate, date)),
+                         qPrintable(QString("%1 开始，%2").arg(startDate.toString(Qt::ISODate), date.toString(Qt::ISODate))));
+            }
+        }
+    }
+    QSqlDatabase::removeDatabase(connName);
+}
+
+// -------------------------- 教师/教室冲突检测 --------------------------
+// 课程A固定为 张老师、101教室、周一 08:00-09:40、整学期；按行给出课程B，检查两类冲突数
+void ScheduleRules::conflictAnalysis_data()
+{
+    QTest::addColumn<qint64>("maskA");
+    QTest::addColumn<QString>("teacherB");
+    QTest::addColumn<int>("dayB");
+    QTest::addColumn<QString>("startB");
+    QTest::addColumn<QString>("endB");
+    QTest::addColumn<qint64>("maskB");
+    QTest::addColumn<QString>("startDateB");
+    QTest::addColumn<QString>("endDateB");
+    QTest::addColumn<int>("teacherConflicts");
+    QTest::addColumn<int>("classroomConflicts");
+
+    const qint64 all = WeekMask::kAllWeeks;
+    QTest::newRow("overlap") << all << "张老师" << 1 << "09:00" << "10:40" << all
+                             << kSemesterStart << kSemesterEnd << 1 << 1;
+    QTest::newRow("same slot") << all << "张老师" << 1 << "08:00" << "09:40" << all
+                               << kSemesterStart << kSemesterEnd << 1 << 1;
+    QTest::newRow("other teacher") << all << "李老师" << 1 << "09:00" << "10:40" << all
+                                   << kSemesterStart << kSemesterEnd << 0 << 1;
+    QTest::newRow("back to back") << all << "张老师" << 1 << "09:40" << "11:20" << all
+                                  << kSemesterStart << kSemesterEnd << 0 << 0;
+    QTest::newRow("other day") << all << "张老师" << 2 << "08:00" << "09:40" << all
+                               << kSemesterStart << kSemesterEnd << 0 << 0;
+    QTest::newRow("odd vs even") << WeekMask::oddWeeks() << "张老师" << 1 << "08:00" << "09:40" << WeekMask::evenWeeks()
+                                 << kSemesterStart << kSemesterEnd << 0 << 0;
+    QTest::newRow("odd vs week 3") << WeekMask::oddWeeks() << "张老师" << 1 << "08:00" << "09:40" << WeekMask::range(3, 3)
+                                   << kSemesterStart << kSemesterEnd << 1 << 1;
+    QTest::newRow("disjoint dates") << all << "张老师" << 1 << "08:00" << "09:40" << all
+                                    << "2026-07-06" << "2026-08-30" << 0 << 0;
+    QTest::newRow("partly overlapping dates") << all << "张老师" << 1 << "08:00" << "09:40" << all
+                                              << "2026-06-29" << "2026-08-30" << 1 << 1;
+}
+
+void ScheduleRules::conflictAnalysis()
+{
+    QFETCH(qint64, maskA);
+    QFETCH(QString, teacherB);
+    QFETCH(int, dayB);
+    QFETCH(QString, startB);
+    QFETCH(QString, endB);
+    QFETCH(qint64, maskB);
+    QFETCH(QString, startDateB);
+    QFETCH(QString, endDateB);
+    QFETCH(int, teacherConflicts);
+    QFETCH(int, classroomConflicts);
+
+    DatabaseManager& db = DatabaseManager::instance();
+    QVERIFY(db.addClassroom("101"));
+    QSqlQuery query(db.getDb());
+    QVERIFY(query.exec("SELECT MAX(id) FROM classroom_info") && query.next());
+    const int classroomId = query.value(0).toInt();
+
+    const int courseA = addCourse("数学", 1, "08:00", "09:40", "张老师", classroomId, maskA);
+    const int courseB = addCourse("语文", dayB, startB, endB, teacherB, classroomId, maskB, startDateB, endDateB);
+    QVERIFY(courseA > 0 && courseB > 0);
+
+    ConflictAnalyzer::Report report = ConflictAnalyzer::analyze(db.getDb());
+    QVERIFY(report.ok);
+    QCOMPARE(report.courseRows, 2);
+    QCOMPARE(report.teacherConflicts, teacherConflicts);
+    QCOMPARE(report.classroomConflicts, classroomConflicts);
+    QCOMPARE(report.conflicts.size(), teacherConflicts + classroomConflicts);
+
+    // 冲突明细：每处冲突只列一次，时段为两门课的重叠部分
+    for (const ConflictAnalyzer::Conflict& conflict : report.conflicts) {
+        QCOMPARE(qMin(conflict.courseA, conflict.courseB), courseA);
+        QCOMPARE(qMax(conflict.courseA, conflict.courseB), courseB);
+        QCOMPARE(conflict.overlapStartSecs, DayTime::parse(qMax(QString("08:00"), startB)).secs);
+        QCOMPARE(conflict.overlapEndSecs, DayTime::parse(qMin(QString("09:40"), endB)).secs);
+    }
+    if (teacherConflicts > 0) {
+        QCOMPARE(report.conflicts.first().resourceType, QString("teacher"));
+        QCOMPARE(report.conflicts.first().resourceName, QString("张老师"));
+    }
+    if (classroomConflicts > 0) {
+        QCOMPARE(report.conflicts.last().resourceType, QString("classroom"));
+        QCOMPARE(report.conflicts.last().resourceName, QString("101"));
+    }
+}
+
+// 同一资源三节课两两重叠：按对计数，不重复也不遗漏
+void ScheduleRules::conflictSweepCountsEachPair()
+{
+    auto makeSlot = [](int courseId, int startSecs, int endSecs) {
+        ConflictAnalyzer::Slot slot;
+        slot.courseId = courseId;
+        slot.resource = 7;
+        slot.dayOfWeek = 3;
+        slot.startSecs = startSecs;
+        slot.endSecs = endSecs;
+        slot.startDay = QDate(2026, 3, 2).toJulianDay();
+        slot.endDay = QDate(2026, 7, 5).toJulianDay();
+        slot.firstMonday = slot.startDay;
+        return slot;
+    };
+
+    // 课程3与课程1首尾相接，只与课程2重叠
+    QVector<ConflictAnalyzer::Slot> timeSlots = {makeSlot(3, 36000, 39600), makeSlot(1, 28800, 36000),
+                                             makeSlot(2, 30000, 37800)};
+    QList<ConflictAnalyzer::Conflict> conflicts;
+    QCOMPARE(ConflictAnalyzer::sweep(timeSlots, "teacher", {{7, "王老师"}}, conflicts), 2);
+    QCOMPARE(conflicts.size(), 2);
+    QCOMPARE(conflicts[0].courseA, 1);
+    QCOMPARE(conflicts[0].courseB, 2);
+    QCOMPARE(conflicts[1].courseA, 2);
+    QCOMPARE(conflicts[1].courseB, 3);
+    QCOMPARE(conflicts[1].overlapStartSecs, 36000);
+    QCOMPARE(conflicts[1].overlapEndSecs, 37800);
+}
+
+QTEST_GUILESS_MAIN(ScheduleRules)
+
+#include "tst_schedule_rules.moc"
@@ -0,0 +1,333 @@
+#include "MockSyncServer.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QHostAddress>
+#include <QDate>
+#include <QDateTime>
+#include <QTime>
+#include <QTimer>
+#include <QPointer>
+#include <QDebug>
+#include <QFile>
+#include <QCryptographicHash>
+
+MockSyncServer::MockSyncServer(const MockSyncOptions& options, QObject* parent)
+    : QObject(parent)
+    , m_options(options)
+    , m_server(new QTcpServer(this))
+    , m_random(options.seed)
+{
+    connect(m_server, &QTcpServer::newConnection, this, &MockSyncServer::onNewConnection);
+}
+
+bool MockSyncServer::start()
+{
+    m_payload = buildPayload();
+    QJsonObject delta{{"code", 200}, {"msg", "ok"}, {"revision", m_options.revision},
+                      {"removed", QJsonObject{{"courses", QJsonArray()}, {"notices", QJsonArray()}}}};
+    m_deltaPayload = QJsonDocument(delta).toJson(QJsonDocument::Compact);
+
+    if (!m_options.snapshotFile.isEmpty()) {
+        QFile file(m_options.snapshotFile);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning() << "快照文件无法读取：" << m_options.snapshotFile;
+            return false;
+        }
+        m_snapshot = file.readAll();
+        m_snapshotSha256 = QCryptographicHash::hash(m_snapshot, QCryptographicHash::Sha256).toHex();
+        qInfo().noquote() << QString("提供数据库快照：/api/snapshot（%1字节）").arg(m_snapshot.size());
+    }
+
+    if (!m_server->listen(QHostAddress::Any, m_options.port)) {
+        qWarning() << "模拟服务器监听失败：" << m_server->errorString();
+        return false;
+    }
+
+    qInfo().noquote() << QString("模拟同步服务器已启动：http://127.0.0.1:%1/api/sync（报文%2字节）")
+                         .arg(m_server->serverPort()).arg(m_payload.size());
+
+    if (m_options.urgentEveryMs > 0) {
+        m_urgentTimer = new QTimer(this);
+        m_urgentTimer->setInterval(m_options.urgentEveryMs);
+        connect(m_urgentTimer, &QTimer::timeout, this, [this]() {
+            publishUrgent(QString("模拟紧急通知%1").arg(m_urgentNotices.size() + 1), "演练：请按疏散路线有序撤离。");
+        });
+        m_urgentTimer->start();
+    }
+    return true;
+}
+
+void MockSyncServer::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, &MockSyncServer::onReadyRead);
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_buffers.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void MockSyncServer::onReadyRead()
+{
+    QTcpSocket* socket = qobject_cast<QTcpSocket*>(sender());
+    if (!socket) return;
+
+    QByteArray& buffer = m_buffers[socket];
+    buffer.append(socket->readAll());
+
+    // 仅处理GET请求，读到空行即认为请求头完整
+    int headerEnd = buffer.indexOf("\r\n\r\n");
+    if (headerEnd < 0) {
+        return;
+    }
+
+    QByteArray requestLine = buffer.left(buffer.indexOf("\r\n"));
+    buffer.remove(0, headerEnd + 4);
+
+    QList<QByteArray> parts = requestLine.split(' ');
+    if (parts.size() < 2) {
+        writeResponse(socket, 400, "Bad Request", "{\"code\":400,\"msg\":\"bad request\"}");
+        return;
+    }
+
+    m_requestCount++;
+    handleRequest(socket, parts[0], parts[1]);
+}
+
+void MockSyncServer::handleRequest(QTcpSocket* socket, const QByteArray& method, const QByteArray& path)
+{
+    QByteArray route = path.left(path.indexOf('?') >= 0 ? path.indexOf('?') : path.size());
+    QUrlQuery query(QString::fromUtf8(path.mid(route.size() + 1)));
+
+    // 紧急通知通道不参与故障注入
+    if (method == "GET" && route == "/api/urgent") {
+        handleUrgentPoll(socket, query);
+        return;
+    }
+    if (method == "GET" && route == "/api/urgent/trigger") {
+        publishUrgent(query.queryItemValue("title", QUrl::FullyDecoded),
+                      query.queryItemValue("content", QUrl::FullyDecoded));
+        writeResponse(socket, 200, "OK", QString("{\"code\":200,\"id\":%1}").arg(m_urgentNotices.size()).toUtf8());
+        return;
+    }
+
+    if (method == "GET" && route == "/api/snapshot") {
+        if (m_snapshot.isEmpty()) {
+            writeResponse(socket, 404, "Not Found", "{\"code\":404,\"msg\":\"no snapshot\"}");
+            return;
+        }
+        const qint64 revision = m_options.snapshotRevision > 0 ? m_options.snapshotRevision : m_options.revision;
+        writeResponse(socket, 200, "OK", m_snapshot, "application/vnd.sqlite3",
+                      "X-Snapshot-SHA256: " + m_snapshotSha256 + "\r\n"
+                      + "X-Snapshot-Revision: " + QByteArray::number(revision) + "\r\n");
+        return;
+    }
+
+    if (method != "GET" || route != "/api/sync") {
+        writeResponse(socket, 404, "Not Found", "{\"code\":404,\"msg\":\"not found\"}");
+        return;
+    }
+
+    int delay = m_options.delayMs;
+    if (m_options.jitterMs > 0) {
+        delay += m_random.bounded(m_options.jitterMs + 1);
+    }
+
+    // 客户端已是当前版本时只返回空的增量报文（报文固定生成，版本之间没有真实差异）
+    const bool upToDate = query.hasQueryItem("since")
+                          && query.queryItemValue("since").toLongLong() >= m_options.revision;
+
+    // 故障注入：断连 / 500 / 损坏JSON
+    double roll = m_random.generateDouble();
+    QPointer<QTcpSocket> guard(socket);
+    QTimer::singleShot(delay, this, [this, guard, roll, upToDate]() mutable {
+        if (!guard) return;
+
+        if (roll < m_options.dropRate) {
+            guard->abort();
+            return;
+        }
+        roll -= m_options.dropRate;
+        if (roll < m_options.errorRate) {
+            writeResponse(guard, 500, "Internal Server Error", "{\"code\":500,\"msg\":\"injected error\"}");
+            return;
+        }
+        roll -= m_options.errorRate;
+        if (roll < m_options.badJsonRate) {
+            writeResponse(guard, 200, "OK", m_payload.left(m_payload.size() / 2));
+            return;
+        }
+
+        writeResponse(guard, 200, "OK", upToDate ? m_deltaPayload : m_payload);
+    });
+}
+
+void MockSyncServer::writeResponse(QTcpSocket* socket, int status, const QByteArray& reason,
+                                   const QByteArray& body, const QByteArray& contentType,
+                                   const QByteArray& extraHeaders)
+{
+    QByteArray header;
+    header += "HTTP/1.1 " + QByteArray::number(status) + " " + reason + "\r\n";
+    header += "Content-Type: " + contentType + "; charset=utf-8\r\n";
+    header += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    header += extraHeaders;
+    header += "Connection: close\r\n\r\n";
+
+    socket->write(header);
+    socket->write(body);
+    socket->disconnectFromHost();
+}
+
+void MockSyncServer::handleUrgentPoll(QTcpSocket* socket, const QUrlQuery& query)
+{
+    // 握手：返回当前游标，不补发历史通知（历史通知由全量同步下发）
+    if (!query.hasQueryItem("since")) {
+        writeResponse(socket, 200, "OK", urgentResponse(m_urgentNotices.size()));
+        return;
+    }
+
+    const qint64 since = query.queryItemValue("since").toLongLong();
+    if (since < m_urgentNotices.size()) {
+        writeResponse(socket, 200, "OK", urgentResponse(since));
+        return;
+    }
+
+    // 暂无新通知：挂起到超时或有新通知发布
+    const int timeoutSecs = qBound(1, query.hasQueryItem("timeout") ? query.queryItemValue("timeout").toInt() : 25, 60);
+    UrgentWaiter waiter;
+    waiter.socket = socket;
+    waiter.since = since;
+    waiter.timer = new QTimer(this);
+    waiter.timer->setSingleShot(true);
+    QTimer* timer = waiter.timer;
+    connect(timer, &QTimer::timeout, this, [this, timer]() {
+        for (int i = 0; i < m_urgentWaiters.size(); i++) {
+            if (m_urgentWaiters[i].timer == timer) {
+                UrgentWaiter expired = m_urgentWaiters.takeAt(i);
+                if (expired.socket) {
+                    writeResponse(expired.socket, 200, "OK", urgentResponse(expired.since));
+                }
+                break;
+            }
+        }
+        timer->deleteLater();
+    });
+    timer->start(timeoutSecs * 1000);
+    m_urgentWaiters.append(waiter);
+}
+
+void MockSyncServer::publishUrgent(const QString& title, const QString& content)
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    QJsonObject notice;
+    notice["id"] = m_urgentNotices.size() + 1;
+    notice["title"] = title.isEmpty() ? QString("紧急通知") : title;
+    notice["content"] = content;
+    notice["publish_time"] = now.toString("yyyy-MM-dd HH:mm:ss");
+    notice["expire_time"] = now.date().toString("yyyy-MM-dd");
+    notice["sent_at_ms"] = now.toMSecsSinceEpoch(); // 供客户端统计送达延迟
+    m_urgentNotices.append(notice);
+    qInfo().noquote() << "发布紧急通知：" << notice["title"].toString();
+
+    // 唤醒所有挂起的长轮询
+    const QList<UrgentWaiter> waiters = m_urgentWaiters;
+    m_urgentWaiters.clear();
+    for (const UrgentWaiter& waiter : waiters) {
+        waiter.timer->stop();
+        waiter.timer->deleteLater();
+        if (waiter.socket) {
+            writeResponse(waiter.socket, 200, "OK", urgentResponse(waiter.since));
+        }
+    }
+}
+
+// 编号大于 since 的紧急通知及最新游标
+QByteArray MockSyncServer::urgentResponse(qint64 since) const
+{
+    QJsonArray notices;
+    for (qint64 i = qMax<qint64>(0, since); i < m_urgentNotices.size(); i++) {
+        notices.append(m_urgentNotices.at(i));
+    }
+
+    QJsonObject root;
+    root["code"] = 200;
+    root["cursor"] = m_urgentNotices.size();
+    root["notices"] = notices;
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+// 生成与 NetworkWorker::parseSyncPayload 约定一致的报文
+QByteArray MockSyncServer::buildPayload() const
+{
+    QRandomGenerator random(m_options.seed);
+    const QDate today = QDate::currentDate();
+    const QString startDate = today.addDays(-30).toString("yyyy-MM-dd");
+    const QString endDate = today.addDays(120).toString("yyyy-MM-dd");
+    const QStringList types = {"必修课", "选修课", "实验课"};
+    const QStringList weekSpecs = {"all", "all", "odd", "even", "1-8", "9-16"};
+
+    QJsonArray classes;
+    for (int i = 1; i <= m_options.classes; i++) {
+        QJsonObject cls;
+        cls["id"] = i;
+        cls["class_name"] = QString("模拟班级%1").arg(i);
+        cls["grade"] = QString("%1级").arg(2022 + i % 4);
+        cls["department"] = QString("模拟学院%1").arg(i % 8);
+        classes.append(cls);
+    }
+
+    QJsonArray courses;
+    int courseId = 1;
+    for (int c = 1; c <= m_options.classes; c++) {
+        for (int k = 0; k < m_options.coursesPerClass; k++) {
+            QTime start = QTime(8, 0).addSecs((k / 7 % 8) * 70 * 60);
+            QJsonObject course;
+            course["id"] = courseId++;
+            course["class_id"] = c;
+            course["course_name"] = QString("模拟课程%1").arg(random.bounded(200));
+            course["teacher"] = QString("模拟教师%1").arg(random.bounded(300));
+            course["course_type"] = types[random.bounded(types.size())];
+            course["start_time"] = start.toString("HH:mm");
+            course["end_time"] = start.addSecs(60 * 60).toString("HH:mm");
+            course["day_of_week"] = k % 7 + 1;
+            course["start_date"] = startDate;
+            course["end_date"] = endDate;
+            course["weeks"] = weekSpecs[random.bounded(weekSpecs.size())];
+            course["classroom"] = QString("M%1").arg(random.bounded(qMax(1, m_options.classrooms)) + 1, 3, 10, QChar('0'));
+            courses.append(course);
+        }
+    }
+
+    QJsonArray notices;
+    const QString filler(qMax(0, m_options.contentBytes / 3), QChar(0x901A)); // 中文字符约3字节
+    for (int i = 1; i <= m_options.notices; i++) {
+        QJsonObject notice;
+        notice["id"] = i;
+        notice["title"] = QString("模拟通知%1").arg(i);
+        notice["content"] = QString("模拟通知内容%1%2").arg(i).arg(filler);
+        notice["publish_time"] = today.addDays(-(i % 10)).toString("yyyy-MM-dd") + " 08:00:00";
+        notice["expire_time"] = today.addDays(7).toString("yyyy-MM-dd");
+        notice["is_scrolling"] = i % 2 == 0;
+        notices.append(notice);
+    }
+
+    // 校历：两周后的周一放假，随后的周六调休上周一的课
+    QJsonArray calendar;
+    const QDate holiday = today.addDays(14 - today.dayOfWeek() + 1);
+    calendar.append(QJsonObject{{"date", holiday.toString("yyyy-MM-dd")}, {"kind", "holiday"},
+                                {"description", "模拟假日"}});
+    calendar.append(QJsonObject{{"date", holiday.addDays(5).toString("yyyy-MM-dd")}, {"kind", "makeup"},
+                                {"as_day_of_week", 1}, {"description", "模拟调休"}});
+
+    QJsonObject root;
+    root["code"] = 200;
+    root["msg"] = "ok";
+    root["revision"] = m_options.revision;
+    root["classes"] = classes;
+    root["courses"] = courses;
+    root["calendar"] = calendar;
+    root["notices"] = notices;
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
@@ -0,0 +1,96 @@
+#ifndef MOCKSYNCSERVER_H
+#define MOCKSYNCSERVER_H
+
+#include <QObject>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHash>
+#include <QByteArray>
+#include <QRandomGenerator>
+#include <QJsonArray>
+#include <QPointer>
+#include <QTimer>
+#include <QUrlQuery>
+
+// 模拟服务器可调参数
+struct MockSyncOptions
+{
+    quint16 port = 8080;          // 监听端口
+    int classes = 20;             // 班级数量
+    int coursesPerClass = 30;     // 每班课程数
+    int classrooms = 40;          // 教室数量
+    int notices = 50;             // 通知数量
+    int contentBytes = 64;        // 单条通知内容长度（字节，用于放大报文）
+    int delayMs = 0;              // 固定响应延迟
+    int jitterMs = 0;             // 随机附加延迟上限
+    double errorRate = 0.0;       // 返回HTTP 500的概率
+    double badJsonRate = 0.0;     // 返回损坏JSON的概率
+    double dropRate = 0.0;        // 直接断开连接的概率
+    quint32 seed = 20260101;      // 随机种子（保证可复现）
+    int urgentEveryMs = 0;        // 定时生成紧急通知的间隔（0=仅手动触发）
+    qint64 revision = 1;          // 当前数据版本（同步报文的 revision）
+    QString snapshotFile;         // 预制数据库快照（空=不提供 /api/snapshot）
+    qint64 snapshotRevision = 0;  // 快照对应的数据版本（0=与 revision 相同）
+};
+
+// 基于QTcpServer的最小HTTP/1.1同步服务器
+// 路由：
+//   GET /api/sync?since=N               返回生成的同步报文；since 不小于当前版本时返回空的增量报文
+//                                       （增量报文的 removed.courses / removed.notices 为服务器已删除的ID）
+//   GET /api/snapshot                   返回预制数据库快照（头部 X-Snapshot-SHA256、X-Snapshot-Revision）
+//   GET /api/urgent?since=N&timeout=S   紧急通知长轮询：有编号大于N的通知立即返回，否则最长挂起S秒；
+//                                       不带 since 时立即返回当前游标（客户端握手）
+//   GET /api/urgent/trigger?title=&content=  手动发布一条紧急通知
+// 其余路径返回404
+class MockSyncServer : public QObject
+{
+    Q_OBJECT
+public:
+    explicit MockSyncServer(const MockSyncOptions& options, QObject* parent = nullptr);
+
+    // 开始监听（返回是否成功）
+    bool start();
+
+    // 已处理请求统计
+    quint64 requestCount() const { return m_requestCount; }
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+
+private:
+    // 生成同步报文（启动时生成一次并缓存，避免生成开销干扰测量）
+    QByteArray buildPayload() const;
+    // 按注入策略回复单个请求
+    void handleRequest(QTcpSocket* socket, const QByteArray& method, const QByteArray& path);
+    // 紧急通知：长轮询 / 发布
+    void handleUrgentPoll(QTcpSocket* socket, const QUrlQuery& query);
+    void publishUrgent(const QString& title, const QString& content);
+    QByteArray urgentResponse(qint64 since) const;
+    void writeResponse(QTcpSocket* socket, int status, const QByteArray& reason,
+                       const QByteArray& body, const QByteArray& contentType = "application/json",
+                       const QByteArray& extraHeaders = QByteArray());
+
+    MockSyncOptions m_options;
+    QTcpServer* m_server;
+    QByteArray m_payload;                       // 缓存的同步报文
+    QByteArray m_deltaPayload;                  // 无变化时的增量报文
+    QByteArray m_snapshot;                      // 预制快照内容（启动时读入）
+    QByteArray m_snapshotSha256;                // 快照校验和（十六进制）
+    QHash<QTcpSocket*, QByteArray> m_buffers;   // 各连接未处理完的请求数据
+    QRandomGenerator m_random;
+    quint64 m_requestCount = 0;
+
+    // 紧急通知（编号即下标+1）与挂起中的长轮询
+    struct UrgentWaiter
+    {
+        QPointer<QTcpSocket> socket;
+        qint64 since = 0;
+        QTimer* timer = nullptr;
+    };
+    QJsonArray m_urgentNotices;
+    QList<UrgentWaiter> m_urgentWaiters;
+    QTimer* m_urgentTimer = nullptr;
+};
+
+#endif // MOCKSYNCSERVER_H
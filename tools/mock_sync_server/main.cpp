@@ -0,0 +1,62 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include "MockSyncServer.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    a.setApplicationName("mock_sync_server");
+    a.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("教室班牌本地模拟同步服务器");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption portOpt("port", "监听端口", "port", "8080");
+    QCommandLineOption classesOpt("classes", "班级数量", "n", "20");
+    QCommandLineOption coursesOpt("courses-per-class", "每班课程数", "n", "30");
+    QCommandLineOption roomsOpt("classrooms", "教室数量", "n", "40");
+    QCommandLineOption noticesOpt("notices", "通知数量", "n", "50");
+    QCommandLineOption contentOpt("content-bytes", "单条通知内容长度（字节）", "bytes", "64");
+    QCommandLineOption delayOpt("delay-ms", "固定响应延迟（毫秒）", "ms", "0");
+    QCommandLineOption jitterOpt("jitter-ms", "随机附加延迟上限（毫秒）", "ms", "0");
+    QCommandLineOption errorOpt("error-rate", "返回HTTP 500的概率（0-1）", "rate", "0");
+    QCommandLineOption badJsonOpt("bad-json-rate", "返回损坏JSON的概率（0-1）", "rate", "0");
+    QCommandLineOption dropOpt("drop-rate", "直接断开连接的概率（0-1）", "rate", "0");
+    QCommandLineOption seedOpt("seed", "随机种子", "seed", "20260101");
+    QCommandLineOption urgentOpt("urgent-every-ms", "定时发布紧急通知的间隔（毫秒，0=仅手动触发）", "ms", "0");
+    QCommandLineOption revisionOpt("revision", "当前数据版本", "n", "1");
+    QCommandLineOption snapshotOpt("snapshot", "预制数据库快照文件（可用设置中的“备份”生成）", "file");
+    QCommandLineOption snapshotRevOpt("snapshot-revision", "快照对应的数据版本（默认同 --revision）", "n", "0");
+    parser.addOptions({portOpt, classesOpt, coursesOpt, roomsOpt, noticesOpt, contentOpt,
+                       delayOpt, jitterOpt, errorOpt, badJsonOpt, dropOpt, seedOpt, urgentOpt,
+                       revisionOpt, snapshotOpt, snapshotRevOpt});
+    parser.process(a);
+
+    MockSyncOptions options;
+    options.port = static_cast<quint16>(parser.value(portOpt).toUInt());
+    options.classes = parser.value(classesOpt).toInt();
+    options.coursesPerClass = parser.value(coursesOpt).toInt();
+    options.classrooms = parser.value(roomsOpt).toInt();
+    options.notices = parser.value(noticesOpt).toInt();
+    options.contentBytes = parser.value(contentOpt).toInt();
+    options.delayMs = parser.value(delayOpt).toInt();
+    options.jitterMs = parser.value(jitterOpt).toInt();
+    options.errorRate = parser.value(errorOpt).toDouble();
+    options.badJsonRate = parser.value(badJsonOpt).toDouble();
+    options.dropRate = parser.value(dropOpt).toDouble();
+    options.seed = parser.value(seedOpt).toUInt();
+    options.urgentEveryMs = parser.value(urgentOpt).toInt();
+    options.revision = parser.value(revisionOpt).toLongLong();
+    options.snapshotFile = parser.value(snapshotOpt);
+    options.snapshotRevision = parser.value(snapshotRevOpt).toLongLong();
+
+    MockSyncServer server(options);
+    if (!server.start()) {
+        return 1;
+    }
+
+    return a.exec();
+}
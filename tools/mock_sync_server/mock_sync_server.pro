@@ -0,0 +1,18 @@
+# 本地模拟同步服务器（替代 http://127.0.0.1:8080/api/sync）
+QT       += core network
+QT       -= gui
+
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TARGET = mock_sync_server
+TEMPLATE = app
+
+# 源文件
+SOURCES += \
+    main.cpp \
+    MockSyncServer.cpp
+
+# 头文件
+HEADERS += \
+    MockSyncServer.h
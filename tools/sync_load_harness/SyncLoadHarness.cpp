@@ -0,0 +1,247 @@
+#include "SyncLoadHarness.h"
+#include "data/DatabaseManager.h"
+#include "network/NetworkWorker.h"
+#include <QNetworkRequest>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFile>
+#include <QDateTime>
+#include <QTextStream>
+#include <algorithm>
+
+// -------------------------- 单个客户端 --------------------------
+SyncClient::SyncClient(int index, const HarnessOptions& options)
+    : QObject(nullptr)
+    , m_index(index)
+    , m_options(options)
+{
+}
+
+void SyncClient::start()
+{
+    // 网络管理器必须在客户端所在线程内创建
+    m_netManager = new QNetworkAccessManager(this);
+    m_netManager->setTransferTimeout(m_options.timeoutMs);
+    connect(m_netManager, &QNetworkAccessManager::finished, this, &SyncClient::onReplyFinished);
+    sendRequest();
+}
+
+void SyncClient::sendRequest()
+{
+    if (m_sent >= m_options.rounds) {
+        emit finished(m_index);
+        return;
+    }
+
+    m_sent++;
+    QNetworkRequest request(m_options.url);
+    request.setRawHeader("User-Agent", "ClassBoardSyncHarness/1.0");
+    request.setRawHeader("Accept", "application/json");
+    request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+
+    m_requestTimer.start();
+    m_netManager->get(request);
+}
+
+void SyncClient::onReplyFinished(QNetworkReply* reply)
+{
+    qint64 latencyUs = m_requestTimer.nsecsElapsed() / 1000;
+
+    if (reply->error() != QNetworkReply::NoError) {
+        emit responseParsed(m_index, latencyUs, 0, 0, false, reply->errorString(), QJsonObject());
+        reply->deleteLater();
+        sendRequest();
+        return;
+    }
+
+    QByteArray jsonData = reply->readAll();
+    reply->deleteLater();
+
+    // 与正式客户端使用同一解析路径
+    QElapsedTimer parseTimer;
+    parseTimer.start();
+    QJsonObject root;
+    QString errMsg;
+    bool ok = NetworkWorker::parseSyncPayload(jsonData, root, errMsg);
+    qint64 parseUs = parseTimer.nsecsElapsed() / 1000;
+
+    emit responseParsed(m_index, latencyUs, jsonData.size(), parseUs, ok, errMsg, root);
+    sendRequest();
+}
+
+// -------------------------- 压测调度 --------------------------
+SyncLoadHarness::SyncLoadHarness(const HarnessOptions& options, QObject* parent)
+    : QObject(parent)
+    , m_options(options)
+{
+}
+
+SyncLoadHarness::~SyncLoadHarness()
+{
+    for (QThread* thread : m_threads) {
+        thread->quit();
+        thread->wait(3000);
+    }
+}
+
+bool SyncLoadHarness::start()
+{
+    if (m_options.apply) {
+        QString dbPath = m_options.dbPath;
+        if (dbPath.isEmpty()) {
+            dbPath = QDir(QStandardPaths::writableLocation(QStandardPaths::TempLocation))
+                         .filePath("classboard_harness.db");
+        }
+        if (!DatabaseManager::instance().init(dbPath)) {
+            QTextStream(stderr) << "数据库初始化失败：" << dbPath << "\n";
+            return false;
+        }
+    }
+
+    m_wallTimer.start();
+    m_runningClients = m_options.clients;
+
+    for (int i = 0; i < m_options.clients; i++) {
+        QThread* thread = new QThread(this);
+        SyncClient* client = new SyncClient(i, m_options);
+        client->moveToThread(thread);
+
+        connect(thread, &QThread::started, client, &SyncClient::start);
+        connect(thread, &QThread::finished, client, &QObject::deleteLater);
+        connect(client, &SyncClient::responseParsed, this, &SyncLoadHarness::onResponseParsed);
+        connect(client, &SyncClient::finished, this, &SyncLoadHarness::onClientFinished);
+
+        m_threads.append(thread);
+        thread->start();
+    }
+
+    return true;
+}
+
+// 主线程：记录样本，必要时串行落库（数据库连接只属于主线程）
+void SyncLoadHarness::onResponseParsed(int client, qint64 latencyUs, qint64 bytes, qint64 parseUs,
+                                       bool ok, const QString& error, const QJsonObject& root)
+{
+    Q_UNUSED(client);
+
+    Sample sample;
+    sample.latencyUs = latencyUs;
+    sample.bytes = bytes;
+    sample.parseUs = parseUs;
+    sample.ok = ok;
+
+    QString errMsg = error;
+    if (ok && m_options.apply) {
+        QElapsedTimer applyTimer;
+        applyTimer.start();
+        sample.ok = NetworkWorker::applySyncData(root, errMsg);
+        sample.applyUs = applyTimer.nsecsElapsed() / 1000;
+    }
+
+    if (!sample.ok) {
+        m_errors.append(errMsg);
+    }
+    m_samples.append(sample);
+}
+
+void SyncLoadHarness::onClientFinished(int client)
+{
+    Q_UNUSED(client);
+    if (--m_runningClients > 0) {
+        return;
+    }
+
+    report();
+    emit done(m_errors.size() == m_samples.size() ? 1 : 0);
+}
+
+qint64 SyncLoadHarness::percentile(QList<qint64> values, double p)
+{
+    if (values.isEmpty()) {
+        return 0;
+    }
+    std::sort(values.begin(), values.end());
+    int index = qBound(0, static_cast<int>(p * (values.size() - 1) + 0.5), static_cast<int>(values.size() - 1));
+    return values[index];
+}
+
+void SyncLoadHarness::report()
+{
+    const qint64 wallMs = m_wallTimer.elapsed();
+
+    QList<qint64> latency, parse, apply;
+    qint64 totalBytes = 0;
+    int okCount = 0;
+    for (const Sample& sample : m_samples) {
+        latency.append(sample.latencyUs);
+        if (!sample.ok) continue;
+        okCount++;
+        totalBytes += sample.bytes;
+        parse.append(sample.parseUs);
+        if (sample.applyUs >= 0) {
+            apply.append(sample.applyUs);
+        }
+    }
+
+    auto stats = [](const QList<qint64>& values) {
+        QJsonObject obj;
+        obj["count"] = values.size();
+        obj["p50_us"] = percentile(values, 0.50);
+        obj["p90_us"] = percentile(values, 0.90);
+        obj["p99_us"] = percentile(values, 0.99);
+        obj["max_us"] = values.isEmpty() ? 0 : *std::max_element(values.begin(), values.end());
+        return obj;
+    };
+
+    QJsonObject root;
+    root["url"] = m_options.url.toString();
+    root["clients"] = m_options.clients;
+    root["rounds"] = m_options.rounds;
+    root["requests"] = m_samples.size();
+    root["succeeded"] = okCount;
+    root["failed"] = m_samples.size() - okCount;
+    root["wall_ms"] = wallMs;
+    root["total_bytes"] = totalBytes;
+    root["avg_bytes"] = okCount > 0 ? static_cast<double>(totalBytes) / okCount : 0.0;
+    root["throughput_rps"] = wallMs > 0 ? m_samples.size() * 1000.0 / wallMs : 0.0;
+    root["latency"] = stats(latency);
+    root["parse"] = stats(parse);
+    if (m_options.apply) {
+        root["apply"] = stats(apply);
+    }
+
+    QTextStream out(stdout);
+    out << "========== 同步压测结果 ==========\n";
+    out << "服务器：" << m_options.url.toString() << "  客户端：" << m_options.clients
+        << "  轮数：" << m_options.rounds << "\n";
+    out << "请求：" << m_samples.size() << "  成功：" << okCount
+        << "  失败：" << (m_samples.size() - okCount) << "  总耗时：" << wallMs << "ms\n";
+    out << "传输字节：" << totalBytes << "\n";
+
+    auto printStats = [&out](const QString& name, const QJsonObject& obj) {
+        out << name << "  p50=" << obj["p50_us"].toInteger() << "us"
+            << "  p90=" << obj["p90_us"].toInteger() << "us"
+            << "  p99=" << obj["p99_us"].toInteger() << "us"
+            << "  max=" << obj["max_us"].toInteger() << "us\n";
+    };
+    printStats("请求延迟", root["latency"].toObject());
+    printStats("解析耗时", root["parse"].toObject());
+    if (m_options.apply) {
+        printStats("落库耗时", root["apply"].toObject());
+    }
+    if (!m_errors.isEmpty()) {
+        out << "首个错误：" << m_errors.first() << "\n";
+    }
+    out.flush();
+
+    if (!m_options.jsonPath.isEmpty()) {
+        QFile jsonFile(m_options.jsonPath);
+        if (jsonFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            root["generated_at"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+            jsonFile.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+            jsonFile.close();
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#ifndef SYNCLOADHARNESS_H
+#define SYNCLOADHARNESS_H
+
+#include <QObject>
+#include <QThread>
+#include <QUrl>
+#include <QList>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+
+// 压测参数
+struct HarnessOptions
+{
+    QUrl url = QUrl("http://127.0.0.1:8080/api/sync");
+    int clients = 4;         // 并发客户端数
+    int rounds = 10;         // 每个客户端的同步轮数
+    int timeoutMs = 10000;   // 单次请求超时
+    bool apply = false;      // 是否将响应写入本地数据库（测量落库耗时）
+    QString dbPath;          // 落库使用的数据库路径（为空则使用临时文件）
+    QString jsonPath;        // 结果JSON输出路径（为空则仅打印）
+};
+
+// 单个无界面同步客户端（运行在独立线程，负责请求与解析）
+class SyncClient : public QObject
+{
+    Q_OBJECT
+public:
+    SyncClient(int index, const HarnessOptions& options);
+
+public slots:
+    void start();
+
+signals:
+    // 一次同步完成（ok=false时root为空）
+    void responseParsed(int client, qint64 latencyUs, qint64 bytes, qint64 parseUs,
+                        bool ok, const QString& error, const QJsonObject& root);
+    void finished(int client);
+
+private:
+    void sendRequest();
+    void onReplyFinished(QNetworkReply* reply);
+
+    int m_index;
+    HarnessOptions m_options;
+    QNetworkAccessManager* m_netManager = nullptr;
+    QElapsedTimer m_requestTimer;
+    int m_sent = 0;
+};
+
+// 压测调度：启动客户端、在主线程串行落库并汇总统计
+class SyncLoadHarness : public QObject
+{
+    Q_OBJECT
+public:
+    explicit SyncLoadHarness(const HarnessOptions& options, QObject* parent = nullptr);
+    ~SyncLoadHarness();
+
+    // 启动压测（返回是否成功）
+    bool start();
+
+signals:
+    void done(int exitCode);
+
+private slots:
+    void onResponseParsed(int client, qint64 latencyUs, qint64 bytes, qint64 parseUs,
+                          bool ok, const QString& error, const QJsonObject& root);
+    void onClientFinished(int client);
+
+private:
+    struct Sample
+    {
+        qint64 latencyUs = 0;
+        qint64 bytes = 0;
+        qint64 parseUs = 0;
+        qint64 applyUs = -1;  // -1 表示未落库
+        bool ok = false;
+    };
+
+    void report();
+    static qint64 percentile(QList<qint64> values, double p);
+
+    HarnessOptions m_options;
+    QList<QThread*> m_threads;
+    QList<Sample> m_samples;
+    QStringList m_errors;
+    int m_runningClients = 0;
+    QElapsedTimer m_wallTimer;
+};
+
+#endif // SYNCLOADHARNESS_H
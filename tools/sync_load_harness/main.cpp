@@ -0,0 +1,42 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include "SyncLoadHarness.h"
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication a(argc, argv);
+    a.setApplicationName("sync_load_harness");
+    a.setApplicationVersion("1.0.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("教室班牌端到端同步压测工具（配合 mock_sync_server 使用）");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption urlOpt("url", "同步接口地址", "url", "http://127.0.0.1:8080/api/sync");
+    QCommandLineOption clientsOpt("clients", "并发客户端数", "n", "4");
+    QCommandLineOption roundsOpt("rounds", "每个客户端的同步轮数", "n", "10");
+    QCommandLineOption timeoutOpt("timeout-ms", "单次请求超时（毫秒）", "ms", "10000");
+    QCommandLineOption applyOpt("apply", "将响应写入本地数据库并统计落库耗时");
+    QCommandLineOption dbOpt("db", "落库使用的数据库路径", "path");
+    QCommandLineOption jsonOpt("json", "结果JSON输出路径", "path");
+    parser.addOptions({urlOpt, clientsOpt, roundsOpt, timeoutOpt, applyOpt, dbOpt, jsonOpt});
+    parser.process(a);
+
+    HarnessOptions options;
+    options.url = QUrl(parser.value(urlOpt));
+    options.clients = qMax(1, parser.value(clientsOpt).toInt());
+    options.rounds = qMax(1, parser.value(roundsOpt).toInt());
+    options.timeoutMs = parser.value(timeoutOpt).toInt();
+    options.apply = parser.isSet(applyOpt);
+    options.dbPath = parser.value(dbOpt);
+    options.jsonPath = parser.value(jsonOpt);
+
+    SyncLoadHarness harness(options);
+    QObject::connect(&harness, &SyncLoadHarness::done, &a, &QCoreApplication::exit);
+    if (!harness.start()) {
+        return 1;
+    }
+
+    return a.exec();
+}
@@ -0,0 +1,20 @@
+# 端到端同步压测工具（N个无界面同步客户端）
+QT       += core sql network
+QT       -= gui
+
+CONFIG   += console
+CONFIG   -= app_bundle
+
+TARGET = sync_load_harness
+TEMPLATE = app
+
+include(../../src/core/classboard_core.pri)
+
+# 源文件
+SOURCES += \
+    main.cpp \
+    SyncLoadHarness.cpp
+
+# 头文件
+HEADERS += \
+    SyncLoadHarness.h